@@ -0,0 +1,103 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+
+#include "common.h"
+#include "hash_table.h"
+
+#define DEFAULT_BUCKETS 16000000
+#define LOOKUPS 10000000
+
+static double seconds_since(struct timespec *start) {
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (now.tv_sec - start->tv_sec) + (now.tv_nsec - start->tv_nsec) / 1e9;
+}
+
+/// @brief Opens a counter of data TLB misses for this process (-1 if perf events are not available)
+static int open_tlb_counter() {
+  struct perf_event_attr attr;
+  memset(&attr, 0, sizeof(attr));
+
+  attr.size = sizeof(attr);
+  attr.type = PERF_TYPE_HW_CACHE;
+  attr.config = PERF_COUNT_HW_CACHE_DTLB
+    | (PERF_COUNT_HW_CACHE_OP_READ << 8)
+    | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+  attr.disabled = 1;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+
+  return syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+}
+
+/// @brief Looks up random keys in a table with one entry per bucket and prints the time and TLB misses
+static void measure(char *name, const ioopm_alloc_policy_t *policy, size_t buckets) {
+  // The load factor keeps the table from resizing, so that only the lookups are measured
+  ioopm_hash_table_t *ht = ioopm_hash_table_create_custom(eq_elem_int, eq_elem_int, NULL, 2, buckets, policy);
+
+  for (size_t i = 0; i < buckets; i++) {
+    ioopm_hash_table_insert(ht, int_elem(i), int_elem(i));
+  }
+
+  int counter = open_tlb_counter();
+  unsigned long state = 1;
+  long sum = 0;
+  struct timespec start;
+
+  if (counter >= 0) {
+    ioctl(counter, PERF_EVENT_IOC_RESET, 0);
+    ioctl(counter, PERF_EVENT_IOC_ENABLE, 0);
+  }
+
+  clock_gettime(CLOCK_MONOTONIC, &start);
+
+  for (size_t i = 0; i < LOOKUPS; i++) {
+    // xorshift, so that the lookups are spread over the whole bucket array
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    sum += ioopm_hash_table_lookup(ht, int_elem(state % buckets)).integer;
+  }
+
+  double lookup_time = seconds_since(&start);
+  long long misses = -1;
+
+  if (counter >= 0) {
+    ioctl(counter, PERF_EVENT_IOC_DISABLE, 0);
+
+    if (read(counter, &misses, sizeof(misses)) != sizeof(misses)) {
+      misses = -1;
+    }
+
+    close(counter);
+  }
+
+  printf("%-24s lookup %.3fs, dTLB misses %lld (checksum %ld)\n", name, lookup_time, misses, sum);
+
+  ioopm_hash_table_destroy(ht);
+}
+
+int main(int argc, char *argv[]) {
+  size_t buckets = argc > 1 ? atol(argv[1]) : DEFAULT_BUCKETS;
+
+  ioopm_alloc_policy_t transparent = { .pages = IOOPM_PAGES_TRANSPARENT };
+  ioopm_alloc_policy_t hugetlb = { .pages = IOOPM_PAGES_HUGETLB };
+  ioopm_alloc_policy_t interleave = { .pages = IOOPM_PAGES_TRANSPARENT, .numa = IOOPM_NUMA_INTERLEAVE };
+
+  printf("buckets: %zu, lookups: %d\n", buckets, LOOKUPS);
+
+  measure("default pages:", NULL, buckets);
+  measure("transparent huge pages:", &transparent, buckets);
+  measure("hugetlb pages:", &hugetlb, buckets);
+  measure("huge pages, interleaved:", &interleave, buckets);
+
+  return 0;
+}
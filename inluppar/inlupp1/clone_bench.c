@@ -0,0 +1,79 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <time.h>
+
+#include "common.h"
+#include "hash_table.h"
+
+#define DEFAULT_ENTRIES 1000000
+#define ROUNDS 5
+
+static double seconds_since(struct timespec *start) {
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (now.tv_sec - start->tv_sec) + (now.tv_nsec - start->tv_nsec) / 1e9;
+}
+
+/// @brief Used in conjuction with any to insert every entry into another table
+static bool insert_into(elem_t key, elem_t value, void *copy) {
+  ioopm_hash_table_insert(copy, key, value);
+  return false;
+}
+
+/// @brief Copies a template table a few times, by inserting each entry and by cloning it
+static void measure(char *name, ioopm_hash_table_t *template, ioopm_hash_table_t *(*create)()) {
+  struct timespec start;
+
+  clock_gettime(CLOCK_MONOTONIC, &start);
+
+  for (int i = 0; i < ROUNDS; i++) {
+    ioopm_hash_table_t *copy = create();
+    ioopm_hash_table_any(template, insert_into, copy);
+    ioopm_hash_table_destroy(copy);
+  }
+
+  double insert_time = seconds_since(&start) / ROUNDS;
+
+  clock_gettime(CLOCK_MONOTONIC, &start);
+
+  for (int i = 0; i < ROUNDS; i++) {
+    ioopm_hash_table_destroy(ioopm_hash_table_clone(template));
+  }
+
+  double clone_time = seconds_since(&start) / ROUNDS;
+
+  printf("%-14s insert each entry %.3fs, clone %.3fs (%.1fx faster)\n",
+    name, insert_time, clone_time, insert_time / clone_time);
+}
+
+static ioopm_hash_table_t *create_int_table() {
+  return ioopm_hash_table_create(eq_elem_int, eq_elem_int, NULL);
+}
+
+static ioopm_hash_table_t *create_string_table() {
+  return ioopm_hash_table_create_string_keys(eq_elem_int, NULL);
+}
+
+int main(int argc, char *argv[]) {
+  size_t entries = argc > 1 ? atol(argv[1]) : DEFAULT_ENTRIES;
+  ioopm_hash_table_t *ints = create_int_table();
+  ioopm_hash_table_t *strings = create_string_table();
+  char buf[32];
+
+  for (size_t i = 0; i < entries; i++) {
+    ioopm_hash_table_insert(ints, int_elem(i * 7919), int_elem(i));
+
+    sprintf(buf, "word%zu", i);
+    ioopm_hash_table_insert(strings, ptr_elem(buf), int_elem(i));
+  }
+
+  printf("entries: %zu, average of %d copies\n", entries, ROUNDS);
+
+  measure("int keys:", ints, create_int_table);
+  measure("string keys:", strings, create_string_table);
+
+  ioopm_hash_table_destroy(ints);
+  ioopm_hash_table_destroy(strings);
+  return 0;
+}
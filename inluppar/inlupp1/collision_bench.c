@@ -0,0 +1,113 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+
+#include "common.h"
+#include "hash_table.h"
+
+#define DEFAULT_BLOCKS 13
+#define MAX_SLOWDOWN 10
+
+static double seconds_since(struct timespec *start) {
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (now.tv_sec - start->tv_sec) + (now.tv_nsec - start->tv_nsec) / 1e9;
+}
+
+/// @brief Creates 2^blocks strings with the same string_knr_hash
+/// "Aa" and "BB" have the same hash code, so every string made up of those blocks has the same hash code.
+static char **colliding_keys(size_t blocks, size_t count) {
+  char **keys = calloc(count, sizeof(char*));
+
+  for (size_t i = 0; i < count; i++) {
+    keys[i] = calloc(2 * blocks + 1, sizeof(char));
+
+    for (size_t b = 0; b < blocks; b++) {
+      memcpy(keys[i] + 2 * b, (i >> b) & 1 ? "BB" : "Aa", 2);
+    }
+  }
+
+  return keys;
+}
+
+/// @brief Creates strings of the same length as the colliding keys, that do not collide
+static char **random_keys(size_t blocks, size_t count) {
+  char **keys = calloc(count, sizeof(char*));
+
+  srand(1);
+
+  for (size_t i = 0; i < count; i++) {
+    keys[i] = calloc(2 * blocks + 1, sizeof(char));
+
+    for (size_t c = 0; c < 2 * blocks; c++) {
+      keys[i][c] = 'a' + rand() % 26;
+    }
+  }
+
+  return keys;
+}
+
+/// @brief Inserts and looks up every key, returning the time it took
+static double insert_lookup(ioopm_hash_table_t *ht, char **keys, size_t count) {
+  struct timespec start;
+  clock_gettime(CLOCK_MONOTONIC, &start);
+
+  for (size_t i = 0; i < count; i++) {
+    ioopm_hash_table_insert(ht, ptr_elem(keys[i]), int_elem(i));
+  }
+
+  for (size_t i = 0; i < count; i++) {
+    ioopm_hash_table_lookup(ht, ptr_elem(keys[i]));
+  }
+
+  double time = seconds_since(&start);
+  ioopm_hash_table_destroy(ht);
+
+  return time;
+}
+
+static void free_keys(char **keys, size_t count) {
+  for (size_t i = 0; i < count; i++) {
+    free(keys[i]);
+  }
+
+  free(keys);
+}
+
+int main(int argc, char *argv[]) {
+  size_t blocks = argc > 1 ? atol(argv[1]) : DEFAULT_BLOCKS;
+  size_t count = 1UL << blocks;
+  char **attack = colliding_keys(blocks, count);
+  char **normal = random_keys(blocks, count);
+
+  printf("keys: %zu\n", count);
+
+  double knr_normal = insert_lookup(ioopm_hash_table_create(eq_elem_string, eq_elem_int, string_knr_hash), normal, count);
+  double knr_attack = insert_lookup(ioopm_hash_table_create(eq_elem_string, eq_elem_int, string_knr_hash), attack, count);
+  double sip_normal = insert_lookup(ioopm_hash_table_create_seeded(eq_elem_string, eq_elem_int, string_sip_hash), normal, count);
+  double sip_attack = insert_lookup(ioopm_hash_table_create_seeded(eq_elem_string, eq_elem_int, string_sip_hash), attack, count);
+  double owned_attack = insert_lookup(ioopm_hash_table_create_string_keys(eq_elem_int, NULL), attack, count);
+
+  printf("string_knr_hash: normal %.4fs, colliding %.4fs (%.1fx slower)\n", knr_normal, knr_attack, knr_attack / knr_normal);
+  printf("string_sip_hash: normal %.4fs, colliding %.4fs (%.1fx slower)\n", sip_normal, sip_attack, sip_attack / sip_normal);
+  printf("string keys:     colliding %.4fs\n", owned_attack);
+
+  free_keys(attack, count);
+  free_keys(normal, count);
+
+  // Fail if the seeded tables no longer keep their worst-case performance
+  if (sip_attack > MAX_SLOWDOWN * sip_normal || owned_attack > MAX_SLOWDOWN * sip_normal) {
+    puts("FAIL: colliding keys are much slower for seeded tables");
+    return 1;
+  }
+
+  // Default string tables are created with string_knr_hash, so they have to resist colliding keys as well
+  if (knr_attack > MAX_SLOWDOWN * knr_normal) {
+    puts("FAIL: colliding keys are much slower for tables created with string_knr_hash");
+    return 1;
+  }
+
+  return 0;
+}
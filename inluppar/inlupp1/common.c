@@ -1,6 +1,18 @@
 #include <string.h>
+#include <stdint.h>
+#include <time.h>
+#include <sys/random.h>
 #include "common.h"
 
+#define ROTATE_LEFT(x, b) (((x) << (b)) | ((x) >> (64 - (b))))
+#define SIP_ROUND(v0, v1, v2, v3) \
+  do { \
+    v0 += v1; v1 = ROTATE_LEFT(v1, 13); v1 ^= v0; v0 = ROTATE_LEFT(v0, 32); \
+    v2 += v3; v3 = ROTATE_LEFT(v3, 16); v3 ^= v2; \
+    v0 += v3; v3 = ROTATE_LEFT(v3, 21); v3 ^= v0; \
+    v2 += v1; v1 = ROTATE_LEFT(v1, 17); v1 ^= v2; v2 = ROTATE_LEFT(v2, 32); \
+  } while (0)
+
 /// @brief Compares the char* pointers of two elem_t
 bool eq_elem_string(elem_t a, elem_t b){
   char *p1 = a.extra;
@@ -27,4 +39,135 @@ unsigned long string_knr_hash(elem_t key) {
   } while (*++str != '\0');
 
   return result;
-}
\ No newline at end of file
+}
+
+unsigned long string_sip_hash(elem_t key, unsigned long seed) {
+  const unsigned char *str = key.extra;
+  size_t length = strlen(key.extra);
+
+  // SipHash takes a 128 bit key, the second half is derived from the seed
+  uint64_t k0 = seed;
+  uint64_t k1 = (seed * 0x9e3779b97f4a7c15UL) ^ 0x6a09e667f3bcc909UL;
+  uint64_t v0 = 0x736f6d6570736575UL ^ k0;
+  uint64_t v1 = 0x646f72616e646f6dUL ^ k1;
+  uint64_t v2 = 0x6c7967656e657261UL ^ k0;
+  uint64_t v3 = 0x7465646279746573UL ^ k1;
+  const unsigned char *end = str + length - length % 8;
+
+  for (; str != end; str += 8) {
+    uint64_t m;
+    memcpy(&m, str, sizeof(uint64_t));
+    v3 ^= m;
+    SIP_ROUND(v0, v1, v2, v3);
+    v0 ^= m;
+  }
+
+  // The last 0-7 bytes are packed together with the length
+  uint64_t last = (uint64_t)length << 56;
+
+  for (size_t i = 0; i < length % 8; i++) {
+    last |= (uint64_t)str[i] << (8 * i);
+  }
+
+  v3 ^= last;
+  SIP_ROUND(v0, v1, v2, v3);
+  v0 ^= last;
+  v2 ^= 0xff;
+  SIP_ROUND(v0, v1, v2, v3);
+  SIP_ROUND(v0, v1, v2, v3);
+  SIP_ROUND(v0, v1, v2, v3);
+
+  return v0 ^ v1 ^ v2 ^ v3;
+}
+
+unsigned long random_seed() {
+  unsigned long seed;
+
+  if (getrandom(&seed, sizeof(seed), GRND_NONBLOCK) != sizeof(seed)) {
+    // Not as good as getrandom, but still differs between tables and runs
+    seed = (unsigned long)time(NULL) ^ (unsigned long)&seed ^ ((unsigned long)clock() << 32);
+  }
+
+  return seed;
+}
+
+/// @brief Gets a pointer to the item at index in a heap
+static char *item_at(ioopm_top_k_t *top, size_t index) {
+  return top->items + index * top->item_size;
+}
+
+static bool item_comes_after(ioopm_top_k_t *top, size_t a, size_t b) {
+  return top->cmp(item_at(top, a), item_at(top, b), top->extra) > 0;
+}
+
+static void swap_items(ioopm_top_k_t *top, size_t a, size_t b) {
+  char *x = item_at(top, a);
+  char *y = item_at(top, b);
+
+  for (size_t i = 0; i < top->item_size; i++) {
+    char tmp = x[i];
+    x[i] = y[i];
+    y[i] = tmp;
+  }
+}
+
+/// @brief Moves the item at index down until no child comes after it
+static void sift_down(ioopm_top_k_t *top, size_t index) {
+  while (true) {
+    size_t last = index;
+    size_t left = 2 * index + 1;
+    size_t right = left + 1;
+
+    if (left < top->size && item_comes_after(top, left, last)) last = left;
+    if (right < top->size && item_comes_after(top, right, last)) last = right;
+
+    if (last == index) {
+      return;
+    }
+
+    swap_items(top, index, last);
+    index = last;
+  }
+}
+
+ioopm_top_k_t ioopm_top_k_create(void *items, size_t item_size, size_t k, ioopm_item_compare cmp, void *extra) {
+  return (ioopm_top_k_t){ .items = items, .item_size = item_size, .k = k, .cmp = cmp, .extra = extra };
+}
+
+bool ioopm_top_k_accepts(ioopm_top_k_t *top, const void *item) {
+  if (top->size < top->k) {
+    return true;
+  }
+
+  return top->k > 0 && top->cmp(item, top->items, top->extra) < 0;
+}
+
+void ioopm_top_k_add(ioopm_top_k_t *top, const void *item) {
+  if (!ioopm_top_k_accepts(top, item)) {
+    return;
+  }
+
+  if (top->size < top->k) {
+    // Add the item as a leaf and move it up past every parent that comes before it
+    size_t index = top->size++;
+    memcpy(item_at(top, index), item, top->item_size);
+
+    while (index > 0 && item_comes_after(top, index, (index - 1) / 2)) {
+      swap_items(top, index, (index - 1) / 2);
+      index = (index - 1) / 2;
+    }
+  } else {
+    memcpy(top->items, item, top->item_size);
+    sift_down(top, 0);
+  }
+}
+
+void ioopm_top_k_sort(ioopm_top_k_t *top) {
+  // Move the root (the last item) behind the remaining heap
+  while (top->size > 1) {
+    swap_items(top, 0, --top->size);
+    sift_down(top, 0);
+  }
+
+  top->size = 0;
+}
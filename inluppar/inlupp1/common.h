@@ -38,6 +38,16 @@ typedef bool(*ioopm_eq_function)(elem_t a, elem_t b);
 
 typedef unsigned long(*ioopm_hash_function)(elem_t key);
 
+typedef unsigned long(*ioopm_seeded_hash_function)(elem_t key, unsigned long seed);
+
+/// @brief Compares two items of a top-k heap
+/// @return a negative number if a comes before b, 0 if they are equal and a positive number if a comes after b
+typedef int(*ioopm_item_compare)(const void *a, const void *b, void *extra);
+
+/// @brief A bounded binary heap of the k first items seen so far, in an array of k items
+/// The root is the kept item that comes last, so that it is the one replaced by an item that comes before it.
+typedef struct top_k ioopm_top_k_t;
+
 union elem {
   int integer;
   unsigned int unsigned_int;
@@ -52,6 +62,15 @@ struct compare_data {
   elem_t element;            // The element to compare to
 };
 
+struct top_k {
+  char *items;             // The kept items, which the caller allocates with room for k items.
+  size_t item_size;        // The size of each item in bytes.
+  size_t size;             // The amount of kept items.
+  size_t k;                // The amount of items sought.
+  ioopm_item_compare cmp;  // The order of the items.
+  void *extra;             // The extra argument to cmp.
+};
+
 /// @brief Compares the char* pointers of two elem_t
 /// Supports both empty and non-empty strings. 
 /// If either a or b is NULL, only the pointers are compared.
@@ -67,4 +86,38 @@ bool eq_elem_int(elem_t a, elem_t b);
 /// @brief Compute a polynomial with the coefficients of the ASCII-values for each individual character
 /// @param key a key containing a pointer to a NULL terminated string
 /// @returns a hash code based on the NULL terminated string pointed to by key
-unsigned long string_knr_hash(elem_t key);
\ No newline at end of file
+unsigned long string_knr_hash(elem_t key);
+
+/// @brief Compute a keyed hash code (SipHash-1-3) of a string
+/// Unlike string_knr_hash, strings with equal hash codes can not be found without knowing the seed,
+/// which protects hash tables from inputs that are chosen to make every key collide.
+/// @param key a key containing a pointer to a NULL terminated string
+/// @param seed a secret random value
+/// @returns a hash code based on the NULL terminated string pointed to by key and the seed
+unsigned long string_sip_hash(elem_t key, unsigned long seed);
+
+/// @brief Create an empty top-k heap
+/// @param items an array with room for k items
+/// @param item_size the size of each item in bytes
+/// @param k the amount of items to keep
+/// @param cmp the order of the items
+/// @param extra an additional argument (may be NULL) passed to all calls of cmp
+/// @returns the empty heap
+ioopm_top_k_t ioopm_top_k_create(void *items, size_t item_size, size_t k, ioopm_item_compare cmp, void *extra);
+
+/// @brief Check if an item would be kept by ioopm_top_k_add, without adding it
+/// This lets the caller avoid preparing items (e.g. copying keys) that would be thrown away.
+/// @returns true if the heap is not full or item comes before the last kept item
+bool ioopm_top_k_accepts(ioopm_top_k_t *top, const void *item);
+
+/// @brief Add an item to a top-k heap, replacing the last kept item if the heap is full, in O(log k) time
+/// @param item the item to copy into the heap, which is ignored if ioopm_top_k_accepts returns false
+void ioopm_top_k_add(ioopm_top_k_t *top, const void *item);
+
+/// @brief Sort the kept items in place, so that the first item comes first, in O(k log k) time
+/// The heap is empty afterwards, but the items are left in the array.
+void ioopm_top_k_sort(ioopm_top_k_t *top);
+
+/// @brief Get a random seed for string_sip_hash, e.g. for a new hash table
+/// @returns a random value that differs between calls
+unsigned long random_seed();
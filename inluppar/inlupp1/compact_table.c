@@ -0,0 +1,307 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "common.h"
+#include "compact_table.h"
+
+#define DEFAULT_CAPACITY 17
+#define DEFAULT_LOAD_FACTOR 0.75
+#define GROWTH_FACTOR 2
+#define INITIAL_POOL_SIZE 16
+#define NO_NODE 0
+#define MAX_NODES (UINT32_MAX - 1)
+
+typedef uint32_t node_t;
+
+//@brief a table whose entries are stored in a pool of parallel arrays.
+// Node n (starting at 1, so that 0 can mean "no node") is stored at index n - 1 of each array.
+struct compact_table {
+  size_t size;                   // Holds the amount of entries.
+  size_t capacity;               // How many buckets there are in the table.
+  node_t *buckets;               // The first node in each bucket (NO_NODE if empty).
+  elem_t *keys;                  // The key of each node.
+  node_t *next;                  // The next node in the same bucket or in the free list.
+  uint32_t *small_values;        // The value of each node (if small values are used, else NULL).
+  elem_t *values;                // The value of each node (if small values are not used, else NULL).
+  size_t pool_size;              // The amount of nodes that fit in the arrays.
+  size_t pool_used;              // The amount of nodes that have been handed out.
+  node_t free_head;              // The first removed node that can be reused (NO_NODE if none).
+  ioopm_eq_function eq_key;      // equality function for keys.
+  ioopm_hash_function hash_func; // The hashing function.
+};
+
+static unsigned long extract_hash_code(elem_t key) {
+  return key.unsigned_long;
+}
+
+static elem_t get_value(compact_table_t *t, node_t node) {
+  if (t->small_values != NULL) {
+    return uint_elem(t->small_values[node - 1]);
+  }
+
+  return t->values[node - 1];
+}
+
+static void set_value(compact_table_t *t, node_t node, elem_t value) {
+  if (t->small_values != NULL) {
+    t->small_values[node - 1] = value.unsigned_int;
+  } else {
+    t->values[node - 1] = value;
+  }
+}
+
+/// @brief Grows the arrays of the pool, returning false if the pool is full
+static bool grow_pool(compact_table_t *t) {
+  if (t->pool_size >= MAX_NODES) {
+    return false;
+  }
+
+  size_t pool_size = t->pool_size * GROWTH_FACTOR;
+  pool_size = pool_size > MAX_NODES ? MAX_NODES : pool_size;
+
+  t->keys = realloc(t->keys, pool_size * sizeof(elem_t));
+  t->next = realloc(t->next, pool_size * sizeof(node_t));
+
+  if (t->small_values != NULL) {
+    t->small_values = realloc(t->small_values, pool_size * sizeof(uint32_t));
+  } else {
+    t->values = realloc(t->values, pool_size * sizeof(elem_t));
+  }
+
+  t->pool_size = pool_size;
+  return true;
+}
+
+/// @brief Returns an unused node, reusing removed nodes first (NO_NODE if the pool is full)
+static node_t allocate_node(compact_table_t *t) {
+  if (t->free_head != NO_NODE) {
+    node_t node = t->free_head;
+    t->free_head = t->next[node - 1];
+    return node;
+  }
+
+  if (t->pool_used == t->pool_size && !grow_pool(t)) {
+    return NO_NODE;
+  }
+
+  return ++t->pool_used;
+}
+
+static void free_node(compact_table_t *t, node_t node) {
+  t->next[node - 1] = t->free_head;
+  t->free_head = node;
+}
+
+/// @brief Finds the link pointing to the node for key (or the last link in the bucket)
+static node_t *find_link(compact_table_t *t, unsigned long bucket, elem_t key) {
+  node_t *link = &t->buckets[bucket];
+
+  while (*link != NO_NODE && !t->eq_key(t->keys[*link - 1], key)) {
+    link = &t->next[*link - 1];
+  }
+
+  return link;
+}
+
+static void resize(compact_table_t *t) {
+  node_t *old_buckets = t->buckets;
+  size_t old_capacity = t->capacity;
+
+  t->capacity *= GROWTH_FACTOR;
+  t->buckets = calloc(t->capacity, sizeof(node_t));
+
+  // Relink every node to the front of its new bucket
+  for (size_t i = 0; i < old_capacity; i++) {
+    node_t node = old_buckets[i];
+
+    while (node != NO_NODE) {
+      node_t next = t->next[node - 1];
+      node_t *bucket = &t->buckets[t->hash_func(t->keys[node - 1]) % t->capacity];
+
+      t->next[node - 1] = *bucket;
+      *bucket = node;
+      node = next;
+    }
+  }
+
+  free(old_buckets);
+}
+
+compact_table_t *compact_table_create(ioopm_eq_function eq_key, ioopm_hash_function hash_func, bool small_values) {
+  compact_table_t *t = calloc(1, sizeof(compact_table_t));
+
+  *t = (compact_table_t){
+    .capacity = DEFAULT_CAPACITY,
+    .buckets = calloc(DEFAULT_CAPACITY, sizeof(node_t)),
+    .keys = calloc(INITIAL_POOL_SIZE, sizeof(elem_t)),
+    .next = calloc(INITIAL_POOL_SIZE, sizeof(node_t)),
+    .pool_size = INITIAL_POOL_SIZE,
+    .eq_key = eq_key,
+    .hash_func = hash_func == NULL ? extract_hash_code : hash_func,
+  };
+
+  if (small_values) {
+    t->small_values = calloc(INITIAL_POOL_SIZE, sizeof(uint32_t));
+  } else {
+    t->values = calloc(INITIAL_POOL_SIZE, sizeof(elem_t));
+  }
+
+  return t;
+}
+
+static bool compact_lookup(void *storage, elem_t key, elem_t *value) {
+  compact_table_t *t = storage;
+  node_t node = *find_link(t, t->hash_func(key) % t->capacity, key);
+
+  if (node == NO_NODE) {
+    return false;
+  }
+
+  *value = get_value(t, node);
+  return true;
+}
+
+static bool compact_insert(void *storage, elem_t key, elem_t value, bool *replaced, elem_t *old_value) {
+  compact_table_t *t = storage;
+  unsigned long bucket = t->hash_func(key) % t->capacity;
+  node_t *link = find_link(t, bucket, key);
+
+  if (*link != NO_NODE) {
+    *replaced = true;
+    *old_value = get_value(t, *link);
+    set_value(t, *link, value);
+    return true;
+  }
+
+  // The pool may move when it grows, which means that link can not be used below
+  node_t node = allocate_node(t);
+
+  if (node == NO_NODE) {
+    return false;
+  }
+
+  t->keys[node - 1] = key;
+  t->next[node - 1] = t->buckets[bucket];
+  set_value(t, node, value);
+  t->buckets[bucket] = node;
+  t->size++;
+
+  if (DEFAULT_LOAD_FACTOR * t->capacity < t->size) {
+    resize(t);
+  }
+
+  *replaced = false;
+  return true;
+}
+
+static bool compact_remove(void *storage, elem_t key, elem_t *value) {
+  compact_table_t *t = storage;
+  node_t *link = find_link(t, t->hash_func(key) % t->capacity, key);
+  node_t node = *link;
+
+  if (node == NO_NODE) {
+    return false;
+  }
+
+  *value = get_value(t, node);
+  *link = t->next[node - 1];
+  free_node(t, node);
+  t->size--;
+
+  return true;
+}
+
+static size_t compact_remove_if(void *storage, ioopm_predicate pred, void *arg, ioopm_apply_function on_removed, void *removed_arg) {
+  compact_table_t *t = storage;
+  size_t removed = 0;
+
+  for (size_t i = 0; i < t->capacity; i++) {
+    node_t *link = &t->buckets[i];
+
+    while (*link != NO_NODE) {
+      node_t node = *link;
+      elem_t value = get_value(t, node);
+
+      if (!pred(t->keys[node - 1], value, arg)) {
+        link = &t->next[node - 1];
+        continue;
+      }
+
+      on_removed(t->keys[node - 1], &value, removed_arg);
+      *link = t->next[node - 1];
+      free_node(t, node);
+      removed++;
+    }
+  }
+
+  t->size -= removed;
+  return removed;
+}
+
+static size_t compact_size(void *storage) {
+  compact_table_t *t = storage;
+  return t->size;
+}
+
+static void compact_clear(void *storage) {
+  compact_table_t *t = storage;
+
+  // Every node is handed out again from the start of the pool
+  memset(t->buckets, 0, t->capacity * sizeof(node_t));
+  t->pool_used = 0;
+  t->free_head = NO_NODE;
+  t->size = 0;
+}
+
+static bool compact_any(void *storage, ioopm_predicate pred, void *arg) {
+  compact_table_t *t = storage;
+
+  for (size_t i = 0; i < t->capacity; i++) {
+    for (node_t node = t->buckets[i]; node != NO_NODE; node = t->next[node - 1]) {
+      if (pred(t->keys[node - 1], get_value(t, node), arg)) return true;
+    }
+  }
+
+  return false;
+}
+
+static void compact_apply_to_all(void *storage, ioopm_apply_function apply_fun, void *arg) {
+  compact_table_t *t = storage;
+
+  for (size_t i = 0; i < t->capacity; i++) {
+    for (node_t node = t->buckets[i]; node != NO_NODE; node = t->next[node - 1]) {
+      elem_t value = get_value(t, node);
+      apply_fun(t->keys[node - 1], &value, arg);
+      set_value(t, node, value);
+    }
+  }
+}
+
+static void compact_destroy(void *storage) {
+  compact_table_t *t = storage;
+
+  free(t->buckets);
+  free(t->keys);
+  free(t->next);
+  free(t->small_values);
+  free(t->values);
+  free(t);
+}
+
+const table_backend_t compact_table_backend = {
+  .lookup = compact_lookup,
+  .insert = compact_insert,
+  .remove = compact_remove,
+  .size = compact_size,
+  .clear = compact_clear,
+  .any = compact_any,
+  .apply_to_all = compact_apply_to_all,
+  .remove_if = compact_remove_if,
+  .sync = NULL,
+  .export_key = NULL,
+  .release_keys = NULL,
+  .destroy = compact_destroy,
+};
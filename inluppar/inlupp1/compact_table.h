@@ -0,0 +1,29 @@
+#pragma once
+
+#include <stdbool.h>
+
+#include "common.h"
+#include "table_backend.h"
+
+/**
+ * @file compact_table.h
+ * @author Fredrik Engstrand, Alex Alstergren
+ * @date 19 October 2026
+ * @brief Memory efficient storage, used by ioopm_hash_table_create_compact.
+ *
+ * Entries are kept in a pool of parallel arrays and linked together with 32-bit indices
+ * instead of pointers. Buckets hold the index of their first entry, so there are no dummies.
+ * Values can optionally be stored in 4 bytes when they only hold an integer or unsigned_int.
+ */
+
+typedef struct compact_table compact_table_t;
+
+/// @brief The operations of a compact table, see table_backend.h
+extern const table_backend_t compact_table_backend;
+
+/// @brief Create an empty compact table
+/// @param eq_key the function used to compare two keys
+/// @param hash_func the function used to create a hash code from the key
+/// @param small_values true to only store the integer/unsigned_int part of each value
+/// @return the table
+compact_table_t *compact_table_create(ioopm_eq_function eq_key, ioopm_hash_function hash_func, bool small_values);
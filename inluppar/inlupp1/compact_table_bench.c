@@ -0,0 +1,67 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <malloc.h>
+#include <time.h>
+
+#include "common.h"
+#include "hash_table.h"
+
+#define DEFAULT_ENTRIES 1000000
+
+static double seconds_since(struct timespec *start) {
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (now.tv_sec - start->tv_sec) + (now.tv_nsec - start->tv_nsec) / 1e9;
+}
+
+/// @brief Gets the bytes allocated with malloc, including large arrays (e.g. buckets) that malloc maps on their own
+static size_t allocated_bytes() {
+  struct mallinfo2 info = mallinfo2();
+  return info.uordblks + info.hblkhd;
+}
+
+/// @brief Fills a table and prints the memory used per entry and the time to look up every entry
+static void measure(char *name, ioopm_hash_table_t *ht, size_t before, size_t entries) {
+  struct timespec start;
+  clock_gettime(CLOCK_MONOTONIC, &start);
+
+  for (size_t i = 0; i < entries; i++) {
+    ioopm_hash_table_insert(ht, int_elem(i), int_elem(i));
+  }
+
+  double insert_time = seconds_since(&start);
+  size_t bytes = allocated_bytes() - before;
+  long sum = 0;
+
+  clock_gettime(CLOCK_MONOTONIC, &start);
+
+  for (size_t i = 0; i < entries; i++) {
+    sum += ioopm_hash_table_lookup(ht, int_elem((i * 7919) % entries)).integer;
+  }
+
+  double lookup_time = seconds_since(&start);
+
+  printf("%-22s %6.1f bytes/entry, insert %.3fs, lookup %.3fs (checksum %ld)\n",
+    name, (double)bytes / entries, insert_time, lookup_time, sum);
+
+  ioopm_hash_table_destroy(ht);
+}
+
+int main(int argc, char *argv[]) {
+  size_t entries = argc > 1 ? atol(argv[1]) : DEFAULT_ENTRIES;
+  size_t before;
+
+  printf("entries: %zu\n", entries);
+
+  before = allocated_bytes();
+  measure("entries and dummies:", ioopm_hash_table_create(eq_elem_int, eq_elem_int, NULL), before, entries);
+
+  before = allocated_bytes();
+  measure("compact:", ioopm_hash_table_create_compact(eq_elem_int, eq_elem_int, NULL, false), before, entries);
+
+  before = allocated_bytes();
+  measure("compact, small values:", ioopm_hash_table_create_compact(eq_elem_int, eq_elem_int, NULL, true), before, entries);
+
+  return 0;
+}
@@ -0,0 +1,238 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "common.h"
+#include "counter.h"
+
+#define INITIAL_SLOTS 64
+#define GROWTH_FACTOR 2
+#define KEY_CHUNK_SIZE 65536
+#define BATCH_SIZE 16
+
+typedef struct slot slot_t;
+typedef struct key_chunk key_chunk_t;
+
+//@brief an entry of the counter, or an empty slot if key is NULL.
+struct slot {
+  uint64_t hash;    // The hash code of the key.
+  const char *key;  // The key (possibly NULL).
+  uint64_t count;   // The count of the key.
+};
+
+//@brief memory for the keys owned by the counter.
+struct key_chunk {
+  key_chunk_t *next;  // The previously filled chunk (possibly NULL).
+  size_t used;        // The amount of bytes used in data.
+  size_t capacity;    // The size of data.
+  char data[];
+};
+
+//@brief an open addressing hash table (with linear probing) of counts.
+struct counter {
+  slot_t *slots;        // The slots.
+  size_t slot_count;    // The amount of slots (always a power of 2).
+  size_t size;          // The amount of keys.
+  unsigned long seed;   // Random value that the keys are hashed with.
+  key_chunk_t *keys;    // The keys (NULL if there are no keys).
+};
+
+static uint64_t hash_string(ioopm_counter_t *counter, const char *key) {
+  return string_sip_hash(ptr_elem((char *)key), counter->seed);
+}
+
+static uint64_t saturating_add(uint64_t count, uint64_t delta) {
+  return count > UINT64_MAX - delta ? UINT64_MAX : count + delta;
+}
+
+/// @brief Finds the slot holding key, or the empty slot where it should be inserted
+static slot_t *find_slot(ioopm_counter_t *counter, const char *key, uint64_t hash) {
+  size_t mask = counter->slot_count - 1;
+
+  for (size_t i = hash & mask; ; i = (i + 1) & mask) {
+    slot_t *slot = &counter->slots[i];
+
+    // Comparing the hash codes first avoids comparing most keys that are not equal
+    if (slot->key == NULL || (slot->hash == hash && strcmp(slot->key, key) == 0)) {
+      return slot;
+    }
+  }
+}
+
+/// @brief Copies a key into the chunks of the counter
+static const char *copy_key(ioopm_counter_t *counter, const char *key) {
+  size_t length = strlen(key) + 1;
+  key_chunk_t *chunk = counter->keys;
+
+  if (chunk == NULL || chunk->capacity - chunk->used < length) {
+    size_t capacity = length > KEY_CHUNK_SIZE ? length : KEY_CHUNK_SIZE;
+    chunk = malloc(sizeof(key_chunk_t) + capacity);
+
+    *chunk = (key_chunk_t){ .next = counter->keys, .capacity = capacity };
+    counter->keys = chunk;
+  }
+
+  char *copy = chunk->data + chunk->used;
+  memcpy(copy, key, length);
+  chunk->used += length;
+
+  return copy;
+}
+
+static void grow_slots(ioopm_counter_t *counter) {
+  slot_t *old_slots = counter->slots;
+  size_t old_count = counter->slot_count;
+
+  counter->slot_count *= GROWTH_FACTOR;
+  counter->slots = calloc(counter->slot_count, sizeof(slot_t));
+
+  size_t mask = counter->slot_count - 1;
+
+  for (size_t i = 0; i < old_count; i++) {
+    if (old_slots[i].key == NULL) {
+      continue;
+    }
+
+    size_t j = old_slots[i].hash & mask;
+
+    while (counter->slots[j].key != NULL) {
+      j = (j + 1) & mask;
+    }
+
+    counter->slots[j] = old_slots[i];
+  }
+
+  free(old_slots);
+}
+
+static uint64_t increment_hashed(ioopm_counter_t *counter, const char *key, uint64_t hash, uint64_t delta) {
+  slot_t *slot = find_slot(counter, key, hash);
+
+  if (slot->key != NULL) {
+    slot->count = saturating_add(slot->count, delta);
+    return slot->count;
+  }
+
+  *slot = (slot_t){ .hash = hash, .key = copy_key(counter, key), .count = delta };
+  counter->size++;
+
+  // Keep at most half of the slots in use, so that the probe sequences stay short
+  if (counter->size * 2 > counter->slot_count) {
+    grow_slots(counter);
+  }
+
+  return delta;
+}
+
+ioopm_counter_t *ioopm_counter_create() {
+  ioopm_counter_t *counter = calloc(1, sizeof(ioopm_counter_t));
+
+  *counter = (ioopm_counter_t){
+    .slots = calloc(INITIAL_SLOTS, sizeof(slot_t)),
+    .slot_count = INITIAL_SLOTS,
+    .seed = random_seed(),
+  };
+
+  return counter;
+}
+
+void ioopm_counter_destroy(ioopm_counter_t *counter) {
+  key_chunk_t *chunk = counter->keys;
+
+  while (chunk != NULL) {
+    key_chunk_t *next = chunk->next;
+    free(chunk);
+    chunk = next;
+  }
+
+  free(counter->slots);
+  free(counter);
+}
+
+uint64_t ioopm_counter_increment(ioopm_counter_t *counter, const char *key, uint64_t delta) {
+  return increment_hashed(counter, key, hash_string(counter, key), delta);
+}
+
+void ioopm_counter_increment_all(ioopm_counter_t *counter, const char *keys[], size_t n, uint64_t delta) {
+  uint64_t hashes[BATCH_SIZE];
+
+  for (size_t start = 0; start < n; start += BATCH_SIZE) {
+    size_t batch = n - start < BATCH_SIZE ? n - start : BATCH_SIZE;
+    size_t mask = counter->slot_count - 1;
+
+    // Hash the whole batch first, so that the slots are already in the cache when they are counted
+    for (size_t i = 0; i < batch; i++) {
+      hashes[i] = hash_string(counter, keys[start + i]);
+      __builtin_prefetch(&counter->slots[hashes[i] & mask], 1);
+    }
+
+    for (size_t i = 0; i < batch; i++) {
+      increment_hashed(counter, keys[start + i], hashes[i], delta);
+    }
+  }
+}
+
+uint64_t ioopm_counter_get(ioopm_counter_t *counter, const char *key) {
+  slot_t *slot = find_slot(counter, key, hash_string(counter, key));
+  return slot->key == NULL ? 0 : slot->count;
+}
+
+void ioopm_counter_merge(ioopm_counter_t *counter, ioopm_counter_t *other) {
+  for (size_t i = 0; i < other->slot_count; i++) {
+    slot_t *slot = &other->slots[i];
+
+    // The counters have different seeds, so the key has to be hashed again
+    if (slot->key != NULL) {
+      ioopm_counter_increment(counter, slot->key, slot->count);
+    }
+  }
+}
+
+size_t ioopm_counter_size(ioopm_counter_t *counter) {
+  return counter->size;
+}
+
+ioopm_counter_entry_t *ioopm_counter_entries(ioopm_counter_t *counter) {
+  ioopm_counter_entry_t *entries = calloc(counter->size, sizeof(ioopm_counter_entry_t));
+  size_t n = 0;
+
+  for (size_t i = 0; i < counter->slot_count; i++) {
+    if (counter->slots[i].key != NULL) {
+      entries[n++] = (ioopm_counter_entry_t){ .key = counter->slots[i].key, .count = counter->slots[i].count };
+    }
+  }
+
+  return entries;
+}
+
+/// @brief Orders entries by decreasing count, and entries with equal counts by key
+static int compare_entries(const void *a, const void *b, void *extra) {
+  const ioopm_counter_entry_t *x = a;
+  const ioopm_counter_entry_t *y = b;
+
+  if (x->count != y->count) {
+    return x->count > y->count ? -1 : 1;
+  }
+
+  return strcmp(x->key, y->key);
+}
+
+ioopm_counter_entry_t *ioopm_counter_top_k(ioopm_counter_t *counter, size_t k) {
+  k = k < counter->size ? k : counter->size;
+
+  ioopm_counter_entry_t *entries = calloc(k, sizeof(ioopm_counter_entry_t));
+  ioopm_top_k_t top = ioopm_top_k_create(entries, sizeof(ioopm_counter_entry_t), k, compare_entries, NULL);
+
+  for (size_t i = 0; i < counter->slot_count && k > 0; i++) {
+    ioopm_counter_entry_t entry = { .key = counter->slots[i].key, .count = counter->slots[i].count };
+
+    if (entry.key != NULL) {
+      ioopm_top_k_add(&top, &entry);
+    }
+  }
+
+  ioopm_top_k_sort(&top);
+  return entries;
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "common.h"
+
+/**
+ * @file counter.h
+ * @author Fredrik Engstrand, Alex Alstergren
+ * @date 19 October 2026
+ * @brief Map from strings to 64-bit counts, specialized for counting e.g. words.
+ *
+ * Unlike a hash table with string keys and integer values, the counts are stored next to
+ * the hash code and key of each entry in one open addressing table, so an increment of an
+ * existing key only reads one slot and compares one string. Keys are copied into memory
+ * owned by the counter. Counts saturate at UINT64_MAX instead of overflowing.
+ */
+
+typedef struct counter ioopm_counter_t;
+
+//@brief a key together with its count, as returned by ioopm_counter_entries and ioopm_counter_top_k.
+typedef struct counter_entry {
+  const char *key;
+  uint64_t count;
+} ioopm_counter_entry_t;
+
+/// @brief Create a new empty counter
+/// @return A new empty counter
+ioopm_counter_t *ioopm_counter_create();
+
+/// @brief Tear down the counter, including all of its keys
+/// @param counter the counter to be destroyed
+void ioopm_counter_destroy(ioopm_counter_t *counter);
+
+/// @brief Add delta to the count of a key, which starts at 0
+/// @param counter the counter operated upon
+/// @param key a NULL terminated string, which is copied the first time it is counted
+/// @param delta the amount to add
+/// @return the new count of key (UINT64_MAX if it would overflow)
+uint64_t ioopm_counter_increment(ioopm_counter_t *counter, const char *key, uint64_t delta);
+
+/// @brief Add delta to the count of several keys
+/// This is faster than incrementing the keys one at a time, since the slots of the next
+/// keys are fetched into the cache while the current key is counted.
+/// @param counter the counter operated upon
+/// @param keys the NULL terminated strings to count (a key may occur several times)
+/// @param n the amount of keys
+/// @param delta the amount to add for each key
+void ioopm_counter_increment_all(ioopm_counter_t *counter, const char *keys[], size_t n, uint64_t delta);
+
+/// @brief Get the count of a key
+/// @param counter the counter operated upon
+/// @param key a NULL terminated string
+/// @return the count of key, or 0 if it has not been counted
+uint64_t ioopm_counter_get(ioopm_counter_t *counter, const char *key);
+
+/// @brief Add all counts of another counter
+/// @param counter the counter operated upon
+/// @param other the counter whose counts are added (it is not changed)
+void ioopm_counter_merge(ioopm_counter_t *counter, ioopm_counter_t *other);
+
+/// @brief Get the amount of distinct keys in the counter
+/// @param counter the counter operated upon
+/// @return the amount of keys
+size_t ioopm_counter_size(ioopm_counter_t *counter);
+
+/// @brief Get all keys and their counts (in no particular order)
+/// The keys are valid until the counter is destroyed.
+/// @param counter the counter operated upon
+/// @return an array (which has to be freed) with ioopm_counter_size entries
+ioopm_counter_entry_t *ioopm_counter_entries(ioopm_counter_t *counter);
+
+/// @brief Get the k keys with the highest counts, in O(n log k) time
+/// The keys are valid until the counter is destroyed.
+/// @param counter the counter operated upon
+/// @param k the amount of keys sought
+/// @return an array (which has to be freed) with the min(k, size) entries with the highest counts,
+///         with the highest count first and keys with equal counts in alphabetical order
+ioopm_counter_entry_t *ioopm_counter_top_k(ioopm_counter_t *counter, size_t k);
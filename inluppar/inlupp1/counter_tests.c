@@ -0,0 +1,176 @@
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <CUnit/Basic.h>
+
+#include "common.h"
+#include "counter.h"
+
+int init_suite(void) {
+  return 0;
+}
+
+int clean_suite(void) {
+  return 0;
+}
+
+void test_create_destroy() {
+  ioopm_counter_t *counter = ioopm_counter_create();
+
+  CU_ASSERT_PTR_NOT_NULL(counter);
+  CU_ASSERT_EQUAL(ioopm_counter_size(counter), 0);
+  CU_ASSERT_EQUAL(ioopm_counter_get(counter, "hello"), 0);
+
+  ioopm_counter_destroy(counter);
+}
+
+void test_increment() {
+  ioopm_counter_t *counter = ioopm_counter_create();
+  char buf[16];
+
+  CU_ASSERT_EQUAL(ioopm_counter_increment(counter, "hello", 1), 1);
+  CU_ASSERT_EQUAL(ioopm_counter_increment(counter, "world", 5), 5);
+
+  // The key is copied, so an equal key in another buffer is counted as the same key
+  strcpy(buf, "hello");
+  CU_ASSERT_EQUAL(ioopm_counter_increment(counter, buf, 2), 3);
+  strcpy(buf, "other");
+
+  CU_ASSERT_EQUAL(ioopm_counter_get(counter, "hello"), 3);
+  CU_ASSERT_EQUAL(ioopm_counter_get(counter, "world"), 5);
+  CU_ASSERT_EQUAL(ioopm_counter_get(counter, "other"), 0);
+  CU_ASSERT_EQUAL(ioopm_counter_size(counter), 2);
+
+  ioopm_counter_destroy(counter);
+}
+
+void test_increment_saturates() {
+  ioopm_counter_t *counter = ioopm_counter_create();
+
+  ioopm_counter_increment(counter, "big", UINT64_MAX - 1);
+  CU_ASSERT_EQUAL(ioopm_counter_increment(counter, "big", 1), UINT64_MAX);
+  CU_ASSERT_EQUAL(ioopm_counter_increment(counter, "big", 10), UINT64_MAX);
+
+  ioopm_counter_destroy(counter);
+}
+
+void test_increment_all() {
+  ioopm_counter_t *counter = ioopm_counter_create();
+  char *words[3000];
+  char buf[3000][16];
+
+  // More keys than fit in a batch, with every key occurring three times
+  for (int i = 0; i < 3000; i++) {
+    sprintf(buf[i], "word%d", i % 1000);
+    words[i] = buf[i];
+  }
+
+  ioopm_counter_increment_all(counter, (const char **)words, 3000, 2);
+
+  CU_ASSERT_EQUAL(ioopm_counter_size(counter), 1000);
+
+  for (int i = 0; i < 1000; i++) {
+    CU_ASSERT_EQUAL(ioopm_counter_get(counter, buf[i]), 6);
+  }
+
+  ioopm_counter_increment_all(counter, NULL, 0, 1);
+  CU_ASSERT_EQUAL(ioopm_counter_size(counter), 1000);
+
+  ioopm_counter_destroy(counter);
+}
+
+void test_merge() {
+  ioopm_counter_t *a = ioopm_counter_create();
+  ioopm_counter_t *b = ioopm_counter_create();
+
+  ioopm_counter_increment(a, "both", 1);
+  ioopm_counter_increment(a, "only a", 2);
+  ioopm_counter_increment(b, "both", 3);
+  ioopm_counter_increment(b, "only b", 4);
+
+  ioopm_counter_merge(a, b);
+
+  CU_ASSERT_EQUAL(ioopm_counter_size(a), 3);
+  CU_ASSERT_EQUAL(ioopm_counter_get(a, "both"), 4);
+  CU_ASSERT_EQUAL(ioopm_counter_get(a, "only a"), 2);
+  CU_ASSERT_EQUAL(ioopm_counter_get(a, "only b"), 4);
+
+  // The other counter is not changed, and the merged keys stay valid after it is destroyed
+  CU_ASSERT_EQUAL(ioopm_counter_size(b), 2);
+  ioopm_counter_destroy(b);
+  CU_ASSERT_EQUAL(ioopm_counter_get(a, "only b"), 4);
+
+  ioopm_counter_destroy(a);
+}
+
+void test_entries_and_top_k() {
+  ioopm_counter_t *counter = ioopm_counter_create();
+  char buf[16];
+
+  for (int i = 0; i < 500; i++) {
+    sprintf(buf, "word%d", i);
+    ioopm_counter_increment(counter, buf, i % 100);
+  }
+
+  ioopm_counter_entry_t *entries = ioopm_counter_entries(counter);
+  uint64_t sum = 0;
+
+  for (int i = 0; i < 500; i++) {
+    CU_ASSERT_EQUAL(ioopm_counter_get(counter, entries[i].key), entries[i].count);
+    sum += entries[i].count;
+  }
+
+  CU_ASSERT_EQUAL(sum, 5 * (99 * 100 / 2));
+  free(entries);
+
+  // The highest count first, and equal counts in alphabetical order
+  ioopm_counter_entry_t *top = ioopm_counter_top_k(counter, 6);
+  const char *expected[] = { "word199", "word299", "word399", "word499", "word99", "word198" };
+
+  for (int i = 0; i < 6; i++) {
+    CU_ASSERT_STRING_EQUAL(top[i].key, expected[i]);
+    CU_ASSERT_EQUAL(top[i].count, i < 5 ? 99 : 98);
+  }
+
+  free(top);
+
+  top = ioopm_counter_top_k(counter, 1000);
+  CU_ASSERT_EQUAL(top[0].count, 99);
+  CU_ASSERT_EQUAL(top[499].count, 0);
+  free(top);
+
+  free(ioopm_counter_top_k(counter, 0));
+  ioopm_counter_destroy(counter);
+}
+
+int main() {
+  CU_pSuite test_suite1 = NULL;
+
+  if (CUE_SUCCESS != CU_initialize_registry())
+    return CU_get_error();
+
+  test_suite1 = CU_add_suite("Counter", init_suite, clean_suite);
+  if (NULL == test_suite1) {
+    CU_cleanup_registry();
+    return CU_get_error();
+  }
+
+  if (
+    (NULL == CU_add_test(test_suite1, "it creates and returns a pointer to an empty counter", test_create_destroy)) ||
+    (NULL == CU_add_test(test_suite1, "it increments and gets the counts of keys", test_increment)) ||
+    (NULL == CU_add_test(test_suite1, "it saturates counts instead of overflowing", test_increment_saturates)) ||
+    (NULL == CU_add_test(test_suite1, "it increments keys in batches", test_increment_all)) ||
+    (NULL == CU_add_test(test_suite1, "it merges the counts of another counter", test_merge)) ||
+    (NULL == CU_add_test(test_suite1, "it returns all entries and the entries with the highest counts", test_entries_and_top_k))
+  ) {
+    CU_cleanup_registry();
+    return CU_get_error();
+  }
+
+  CU_basic_set_mode(CU_BRM_VERBOSE);  // Detaljerna utav testerna skrivs ut.
+  CU_basic_run_tests();               // Kör alla testen.
+  CU_cleanup_registry();              // Städar upp testerna (avallokerar minnen bland annat)
+  return CU_get_error();              // Returnerar alla fel som hänt
+}
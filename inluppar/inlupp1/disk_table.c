@@ -0,0 +1,838 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include "common.h"
+#include "disk_table.h"
+
+#define PAGE_SIZE 4096
+#define PAGE_HEADER_SIZE sizeof(page_header_t)
+#define PAGE_PAYLOAD (PAGE_SIZE - PAGE_HEADER_SIZE)
+#define RECORD_HEADER_SIZE (2 * sizeof(uint64_t) + sizeof(uint16_t))
+#define DIRECTORY_ENTRIES (PAGE_PAYLOAD / sizeof(page_no_t))
+#define DISK_MAGIC 0x31484c6d706f6f69UL // "ioopmLH1"
+#define INITIAL_BUCKETS 4
+#define MIN_CACHE_PAGES 8
+#define DISK_LOAD_FACTOR 0.8
+#define ARENA_CHUNK_SIZE 4096
+
+typedef uint32_t page_no_t;
+typedef struct meta meta_t;
+typedef struct page_header page_header_t;
+typedef struct frame frame_t;
+typedef struct key_chunk key_chunk_t;
+
+//@brief the first page of the file, describing the rest of it.
+struct meta {
+  uint64_t magic;            // Identifies the file as a disk table.
+  uint32_t page_size;        // The page size the file was created with.
+  uint32_t string_keys;      // Whether the keys are strings or elem_t.
+  uint32_t level;            // The number of times the amount of buckets has doubled.
+  uint32_t split;            // The next bucket to be split.
+  uint32_t bucket_count;     // The amount of buckets (INITIAL_BUCKETS << level + split).
+  uint32_t page_count;       // The amount of pages in the file, including this one.
+  uint32_t free_head;        // The first page in the list of free pages (0 if none).
+  uint32_t directory_head;   // The first page of the bucket directory (0 if none).
+  uint64_t size;             // Holds the amount of entries.
+  uint64_t used_bytes;       // The amount of bytes used by records.
+};
+
+//@brief the start of every page (except the meta page).
+// Bucket pages are followed by records, directory pages by page numbers.
+struct page_header {
+  page_no_t next;   // The next page in the bucket, directory or free list (0 if none).
+  uint16_t count;   // The amount of records or directory entries in the page.
+  uint16_t used;    // The amount of bytes used after the header.
+};
+
+//@brief a page that is held in memory.
+struct frame {
+  page_no_t page_no;        // The page held by the frame (0 if the frame is unused).
+  bool dirty;               // True if the page has to be written before it is evicted.
+  unsigned pins;            // The frame may not be evicted while it is pinned.
+  unsigned long last_used;  // Used to evict the least recently used page.
+  unsigned char *data;      // The contents of the page.
+  frame_t *next;            // The next frame in the same page map bucket (possibly NULL).
+};
+
+//@brief memory for keys that are handed out through export_key.
+struct key_chunk {
+  key_chunk_t *next;  // The previously filled chunk (possibly NULL).
+  size_t used;        // The amount of bytes used in data.
+  size_t capacity;    // The size of data.
+  char data[];
+};
+
+struct disk_table {
+  int fd;                        // The file holding the table.
+  meta_t meta;                   // In-memory copy of the meta page.
+  page_no_t *directory;          // The first page of each bucket.
+  size_t directory_capacity;     // The amount of allocated directory entries.
+  frame_t **frames;              // The page cache.
+  size_t frame_count;            // The amount of frames in the page cache.
+  frame_t **page_map;            // Finds the frame holding a page, hashed on the page number.
+  size_t page_map_capacity;      // The amount of buckets in page_map.
+  unsigned long clock;           // Increased for every page access.
+  ioopm_eq_function eq_key;      // equality function for keys.
+  ioopm_hash_function hash_func; // The hashing function.
+  key_chunk_t *keys;             // Keys handed out through export_key.
+  bool failed;                   // True if a page could not be written since the last sync.
+};
+
+static unsigned long extract_hash_code(elem_t key) {
+  return key.unsigned_long;
+}
+
+static page_header_t *header(frame_t *frame) {
+  return (page_header_t*)frame->data;
+}
+
+/// @brief Writes a page to the file
+/// @return false if the page could not be written, in which case it stays dirty
+static bool write_page(disk_table_t *t, frame_t *frame) {
+  if (pwrite(t->fd, frame->data, PAGE_SIZE, (off_t)frame->page_no * PAGE_SIZE) != PAGE_SIZE) {
+    return false;
+  }
+
+  frame->dirty = false;
+  return true;
+}
+
+static frame_t *frame_create() {
+  frame_t *frame = calloc(1, sizeof(frame_t));
+  frame->data = calloc(1, PAGE_SIZE);
+  return frame;
+}
+
+/// @brief Removes a frame from the page map (if it holds a page)
+static void unmap_frame(disk_table_t *t, frame_t *frame) {
+  frame_t **cursor = &t->page_map[frame->page_no % t->page_map_capacity];
+
+  while (*cursor != NULL) {
+    if (*cursor == frame) {
+      *cursor = frame->next;
+      break;
+    }
+
+    cursor = &(*cursor)->next;
+  }
+
+  frame->page_no = 0;
+}
+
+/// @brief Returns a pinned frame holding a page, reading it from the file if it is not cached
+static frame_t *fetch_page(disk_table_t *t, page_no_t page_no) {
+  frame_t **bucket = &t->page_map[page_no % t->page_map_capacity];
+
+  for (frame_t *frame = *bucket; frame != NULL; frame = frame->next) {
+    if (frame->page_no == page_no) {
+      frame->pins++;
+      frame->last_used = ++t->clock;
+      return frame;
+    }
+  }
+
+  // The page is not cached, so the least recently used frame is reused
+  frame_t *victim = NULL;
+
+  for (size_t i = 0; i < t->frame_count; i++) {
+    frame_t *frame = t->frames[i];
+
+    if (frame->pins == 0 && (victim == NULL || frame->last_used < victim->last_used)) {
+      victim = frame;
+    }
+  }
+
+  if (victim == NULL) {
+    // Every page is in use by the caller, which only happens when callbacks nest operations
+    t->frames = realloc(t->frames, (t->frame_count + 1) * sizeof(frame_t*));
+    victim = t->frames[t->frame_count++] = frame_create();
+  } else {
+    // The change is lost if the page can not be written, which the next sync reports
+    if (victim->dirty && !write_page(t, victim)) {
+      t->failed = true;
+    }
+
+    unmap_frame(t, victim);
+  }
+
+  ssize_t bytes = pread(t->fd, victim->data, PAGE_SIZE, (off_t)page_no * PAGE_SIZE);
+
+  if (bytes < PAGE_SIZE) {
+    // The page has not been written to the file yet
+    memset(victim->data + (bytes > 0 ? bytes : 0), 0, PAGE_SIZE - (bytes > 0 ? bytes : 0));
+  }
+
+  victim->page_no = page_no;
+  victim->dirty = false;
+  victim->pins = 1;
+  victim->last_used = ++t->clock;
+  victim->next = *bucket;
+  *bucket = victim;
+
+  return victim;
+}
+
+static void unpin(frame_t *frame) {
+  frame->pins--;
+}
+
+/// @brief Returns a pinned, empty page, reusing a free page if there is one
+static frame_t *allocate_page(disk_table_t *t) {
+  frame_t *frame;
+
+  if (t->meta.free_head != 0) {
+    frame = fetch_page(t, t->meta.free_head);
+    t->meta.free_head = header(frame)->next;
+  } else {
+    frame = fetch_page(t, t->meta.page_count++);
+  }
+
+  memset(frame->data, 0, PAGE_SIZE);
+  frame->dirty = true;
+
+  return frame;
+}
+
+/// @brief Puts a pinned page in the free list and unpins it
+static void free_page(disk_table_t *t, frame_t *frame) {
+  memset(frame->data, 0, PAGE_SIZE);
+  header(frame)->next = t->meta.free_head;
+  t->meta.free_head = frame->page_no;
+  frame->dirty = true;
+  unpin(frame);
+}
+
+static unsigned long bucket_for_hash(disk_table_t *t, uint64_t hash) {
+  unsigned long bucket = hash % ((unsigned long)INITIAL_BUCKETS << t->meta.level);
+
+  // Buckets before the split pointer have already been split, and uses one more bit of the hash
+  if (bucket < t->meta.split) {
+    bucket = hash % ((unsigned long)INITIAL_BUCKETS << (t->meta.level + 1));
+  }
+
+  return bucket;
+}
+
+static void set_directory(disk_table_t *t, size_t bucket, page_no_t page_no) {
+  if (bucket >= t->directory_capacity) {
+    t->directory_capacity = t->directory_capacity == 0 ? INITIAL_BUCKETS : t->directory_capacity * 2;
+    t->directory = realloc(t->directory, t->directory_capacity * sizeof(page_no_t));
+  }
+
+  t->directory[bucket] = page_no;
+}
+
+/// @brief Encodes a key into the bytes stored in a record
+static const void *key_bytes(disk_table_t *t, elem_t *key, size_t *length) {
+  if (t->meta.string_keys) {
+    // Include the NULL terminator, so that keys can be used directly from the page
+    *length = strlen(key->extra) + 1;
+    return key->extra;
+  }
+
+  *length = sizeof(elem_t);
+  return key;
+}
+
+/// @brief Decodes the key of a record (string keys point in to the page)
+static elem_t record_key(disk_table_t *t, unsigned char *record) {
+  if (t->meta.string_keys) {
+    return ptr_elem(record + RECORD_HEADER_SIZE);
+  }
+
+  elem_t key;
+  memcpy(&key, record + RECORD_HEADER_SIZE, sizeof(elem_t));
+  return key;
+}
+
+static uint64_t record_hash(unsigned char *record) {
+  uint64_t hash;
+  memcpy(&hash, record, sizeof(uint64_t));
+  return hash;
+}
+
+static elem_t record_value(unsigned char *record) {
+  elem_t value;
+  memcpy(&value, record + sizeof(uint64_t), sizeof(elem_t));
+  return value;
+}
+
+static void set_record_value(unsigned char *record, elem_t value) {
+  memcpy(record + sizeof(uint64_t), &value, sizeof(elem_t));
+}
+
+static size_t record_size(unsigned char *record) {
+  uint16_t key_length;
+  memcpy(&key_length, record + 2 * sizeof(uint64_t), sizeof(uint16_t));
+  return RECORD_HEADER_SIZE + key_length;
+}
+
+/// @brief Finds the record for a key in its bucket
+/// @param frame set to the pinned page holding the record, which the caller must unpin
+/// @param record set to the record within the page
+/// @return true if the key was found
+static bool find_record(disk_table_t *t, elem_t key, uint64_t hash, frame_t **frame, unsigned char **record) {
+  page_no_t page_no = t->directory[bucket_for_hash(t, hash)];
+
+  while (page_no != 0) {
+    frame_t *current = fetch_page(t, page_no);
+    unsigned char *cursor = current->data + PAGE_HEADER_SIZE;
+    unsigned char *end = cursor + header(current)->used;
+
+    while (cursor < end) {
+      if (record_hash(cursor) == hash && t->eq_key(record_key(t, cursor), key)) {
+        *frame = current;
+        *record = cursor;
+        return true;
+      }
+
+      cursor += record_size(cursor);
+    }
+
+    page_no = header(current)->next;
+    unpin(current);
+  }
+
+  return false;
+}
+
+/// @brief Appends an encoded record to the first page of a bucket with enough space
+static void append_record(disk_table_t *t, unsigned long bucket, const unsigned char *record, size_t size) {
+  frame_t *frame = fetch_page(t, t->directory[bucket]);
+
+  while (PAGE_PAYLOAD - header(frame)->used < size) {
+    frame_t *next;
+
+    if (header(frame)->next != 0) {
+      next = fetch_page(t, header(frame)->next);
+    } else {
+      // Every page in the bucket is full, so an overflow page is chained to the last one
+      next = allocate_page(t);
+      header(frame)->next = next->page_no;
+      frame->dirty = true;
+    }
+
+    unpin(frame);
+    frame = next;
+  }
+
+  memcpy(frame->data + PAGE_HEADER_SIZE + header(frame)->used, record, size);
+  header(frame)->used += size;
+  header(frame)->count++;
+  frame->dirty = true;
+  unpin(frame);
+}
+
+/// @brief Splits the bucket at the split pointer into itself and a new bucket at the end
+static void split_bucket(disk_table_t *t) {
+  unsigned long old_bucket = t->meta.split;
+
+  // Move all records of the old bucket to memory and release its overflow pages
+  size_t buffer_size = 0;
+  unsigned char *buffer = NULL;
+  frame_t *primary = fetch_page(t, t->directory[old_bucket]);
+  page_no_t page_no = header(primary)->next;
+  frame_t *frame = primary;
+
+  while (true) {
+    if (header(frame)->used > 0) {
+      buffer = realloc(buffer, buffer_size + header(frame)->used);
+      memcpy(buffer + buffer_size, frame->data + PAGE_HEADER_SIZE, header(frame)->used);
+      buffer_size += header(frame)->used;
+    }
+
+    if (frame != primary) {
+      free_page(t, frame);
+    }
+
+    if (page_no == 0) break;
+
+    frame = fetch_page(t, page_no);
+    page_no = header(frame)->next;
+  }
+
+  memset(primary->data, 0, PAGE_SIZE);
+  primary->dirty = true;
+  unpin(primary);
+
+  // Add the new bucket and move the split pointer
+  frame_t *new_primary = allocate_page(t);
+  set_directory(t, t->meta.bucket_count, new_primary->page_no);
+  unpin(new_primary);
+
+  t->meta.bucket_count++;
+  t->meta.split++;
+
+  if (t->meta.split == (INITIAL_BUCKETS << t->meta.level)) {
+    t->meta.level++;
+    t->meta.split = 0;
+  }
+
+  // Every record ends up in either the old or the new bucket
+  for (size_t offset = 0; offset < buffer_size; offset += record_size(buffer + offset)) {
+    unsigned char *record = buffer + offset;
+    append_record(t, bucket_for_hash(t, record_hash(record)), record, record_size(record));
+  }
+
+  free(buffer);
+}
+
+static bool should_split(disk_table_t *t) {
+  return t->meta.used_bytes > DISK_LOAD_FACTOR * t->meta.bucket_count * PAGE_PAYLOAD;
+}
+
+/// @brief Creates an empty table in a truncated file
+static void initialize(disk_table_t *t, bool string_keys) {
+  if (ftruncate(t->fd, 0) != 0) {
+    t->failed = true;
+  }
+
+  t->meta = (meta_t){
+    .magic = DISK_MAGIC,
+    .page_size = PAGE_SIZE,
+    .string_keys = string_keys,
+    .level = 0,
+    .split = 0,
+    .bucket_count = INITIAL_BUCKETS,
+    .page_count = 1,
+  };
+
+  for (size_t bucket = 0; bucket < INITIAL_BUCKETS; bucket++) {
+    frame_t *frame = allocate_page(t);
+    set_directory(t, bucket, frame->page_no);
+    unpin(frame);
+  }
+}
+
+static void read_directory(disk_table_t *t) {
+  page_no_t page_no = t->meta.directory_head;
+  size_t bucket = 0;
+
+  while (bucket < t->meta.bucket_count) {
+    frame_t *frame = fetch_page(t, page_no);
+    page_no_t *entries = (page_no_t*)(frame->data + PAGE_HEADER_SIZE);
+
+    for (size_t i = 0; i < header(frame)->count; i++) {
+      set_directory(t, bucket++, entries[i]);
+    }
+
+    page_no = header(frame)->next;
+    unpin(frame);
+  }
+}
+
+/// @brief Writes the bucket directory to its chain of pages, extending the chain when needed
+static void write_directory(disk_table_t *t) {
+  frame_t *previous = NULL;
+  size_t bucket = 0;
+
+  while (bucket < t->meta.bucket_count) {
+    page_no_t page_no = previous == NULL ? t->meta.directory_head : header(previous)->next;
+    frame_t *frame;
+
+    if (page_no != 0) {
+      frame = fetch_page(t, page_no);
+    } else {
+      frame = allocate_page(t);
+
+      if (previous == NULL) {
+        t->meta.directory_head = frame->page_no;
+      } else {
+        header(previous)->next = frame->page_no;
+      }
+    }
+
+    size_t count = t->meta.bucket_count - bucket;
+    count = count < DIRECTORY_ENTRIES ? count : DIRECTORY_ENTRIES;
+
+    memcpy(frame->data + PAGE_HEADER_SIZE, t->directory + bucket, count * sizeof(page_no_t));
+    header(frame)->count = count;
+    frame->dirty = true;
+    bucket += count;
+
+    if (previous != NULL) unpin(previous);
+    previous = frame;
+  }
+
+  if (previous != NULL) unpin(previous);
+}
+
+disk_table_t *disk_table_open(
+  const char *path,
+  ioopm_eq_function eq_key,
+  ioopm_hash_function hash_func,
+  bool string_keys,
+  size_t cache_pages
+) {
+  int fd = open(path, O_RDWR | O_CREAT, 0644);
+  struct stat info;
+
+  if (fd < 0) {
+    return NULL;
+  }
+
+  // Without the size it is unknown whether the file holds a table, so it is treated like a failed open
+  if (fstat(fd, &info) != 0) {
+    close(fd);
+    return NULL;
+  }
+
+  disk_table_t *t = calloc(1, sizeof(disk_table_t));
+
+  *t = (disk_table_t){
+    .fd = fd,
+    .eq_key = eq_key,
+    .hash_func = hash_func == NULL ? extract_hash_code : hash_func,
+    .frame_count = cache_pages < MIN_CACHE_PAGES ? MIN_CACHE_PAGES : cache_pages,
+  };
+
+  t->frames = calloc(t->frame_count, sizeof(frame_t*));
+  t->page_map_capacity = t->frame_count;
+  t->page_map = calloc(t->page_map_capacity, sizeof(frame_t*));
+
+  for (size_t i = 0; i < t->frame_count; i++) {
+    t->frames[i] = frame_create();
+  }
+
+  if (info.st_size == 0) {
+    initialize(t, string_keys);
+  } else {
+    ssize_t bytes = pread(fd, &t->meta, sizeof(meta_t), 0);
+
+    if (bytes != sizeof(meta_t)
+        || t->meta.magic != DISK_MAGIC
+        || t->meta.page_size != PAGE_SIZE
+        || t->meta.string_keys != string_keys
+    ) {
+      // Make sure that destroying the table does not write to a file that is not ours
+      t->meta.magic = 0;
+      disk_table_backend.destroy(t);
+      errno = EINVAL;
+      return NULL;
+    }
+
+    read_directory(t);
+  }
+
+  return t;
+}
+
+static bool disk_lookup(void *storage, elem_t key, elem_t *value) {
+  disk_table_t *t = storage;
+  frame_t *frame;
+  unsigned char *record;
+
+  if (!find_record(t, key, t->hash_func(key), &frame, &record)) {
+    return false;
+  }
+
+  *value = record_value(record);
+  unpin(frame);
+  return true;
+}
+
+static bool disk_insert(void *storage, elem_t key, elem_t value, bool *replaced, elem_t *old_value) {
+  disk_table_t *t = storage;
+  uint64_t hash = t->hash_func(key);
+  frame_t *frame;
+  unsigned char *record;
+
+  if (find_record(t, key, hash, &frame, &record)) {
+    *replaced = true;
+    *old_value = record_value(record);
+    set_record_value(record, value);
+    frame->dirty = true;
+    unpin(frame);
+    return true;
+  }
+
+  size_t key_length;
+  const void *key_data = key_bytes(t, &key, &key_length);
+  size_t size = RECORD_HEADER_SIZE + key_length;
+
+  if (size > PAGE_PAYLOAD) {
+    // A record can not span several pages
+    return false;
+  }
+
+  unsigned char buffer[PAGE_PAYLOAD];
+  uint16_t stored_length = key_length;
+  memcpy(buffer, &hash, sizeof(uint64_t));
+  memcpy(buffer + sizeof(uint64_t), &value, sizeof(elem_t));
+  memcpy(buffer + 2 * sizeof(uint64_t), &stored_length, sizeof(uint16_t));
+  memcpy(buffer + RECORD_HEADER_SIZE, key_data, key_length);
+
+  append_record(t, bucket_for_hash(t, hash), buffer, size);
+
+  *replaced = false;
+  t->meta.size++;
+  t->meta.used_bytes += size;
+
+  if (should_split(t)) {
+    split_bucket(t);
+  }
+
+  return true;
+}
+
+static bool disk_remove(void *storage, elem_t key, elem_t *value) {
+  disk_table_t *t = storage;
+  frame_t *frame;
+  unsigned char *record;
+
+  if (!find_record(t, key, t->hash_func(key), &frame, &record)) {
+    return false;
+  }
+
+  size_t size = record_size(record);
+  unsigned char *end = frame->data + PAGE_HEADER_SIZE + header(frame)->used;
+
+  *value = record_value(record);
+
+  // Move the following records in the page over the removed one
+  memmove(record, record + size, end - (record + size));
+  header(frame)->used -= size;
+  header(frame)->count--;
+  frame->dirty = true;
+  unpin(frame);
+
+  t->meta.size--;
+  t->meta.used_bytes -= size;
+  return true;
+}
+
+static size_t disk_size(void *storage) {
+  disk_table_t *t = storage;
+  return t->meta.size;
+}
+
+/// @brief Frees the keys handed out through export_key
+static void free_exported_keys(void *storage) {
+  disk_table_t *t = storage;
+  key_chunk_t *chunk = t->keys;
+
+  while (chunk != NULL) {
+    key_chunk_t *tmp = chunk->next;
+    free(chunk);
+    chunk = tmp;
+  }
+
+  t->keys = NULL;
+}
+
+static void disk_clear(void *storage) {
+  disk_table_t *t = storage;
+
+  // Forget every cached page, since the file is truncated
+  for (size_t i = 0; i < t->frame_count; i++) {
+    unmap_frame(t, t->frames[i]);
+    t->frames[i]->dirty = false;
+  }
+
+  free_exported_keys(t);
+  initialize(t, t->meta.string_keys);
+}
+
+/// @brief Visits every record until visit returns true
+/// @param visit called with the pinned page and the record
+static bool visit_records(disk_table_t *t, bool(*visit)(disk_table_t*, frame_t*, unsigned char*, void*), void *x) {
+  for (size_t bucket = 0; bucket < t->meta.bucket_count; bucket++) {
+    page_no_t page_no = t->directory[bucket];
+
+    while (page_no != 0) {
+      frame_t *frame = fetch_page(t, page_no);
+      unsigned char *cursor = frame->data + PAGE_HEADER_SIZE;
+
+      while (cursor < frame->data + PAGE_HEADER_SIZE + header(frame)->used) {
+        if (visit(t, frame, cursor, x)) {
+          unpin(frame);
+          return true;
+        }
+
+        cursor += record_size(cursor);
+      }
+
+      page_no = header(frame)->next;
+      unpin(frame);
+    }
+  }
+
+  return false;
+}
+
+//@brief a predicate or apply function together with its extra argument.
+typedef struct callback {
+  ioopm_predicate pred;
+  ioopm_apply_function apply_fun;
+  void *arg;
+} callback_t;
+
+static bool visit_pred(disk_table_t *t, frame_t *frame, unsigned char *record, void *x) {
+  callback_t *callback = x;
+  return callback->pred(record_key(t, record), record_value(record), callback->arg);
+}
+
+static bool visit_apply(disk_table_t *t, frame_t *frame, unsigned char *record, void *x) {
+  callback_t *callback = x;
+  elem_t value = record_value(record);
+
+  callback->apply_fun(record_key(t, record), &value, callback->arg);
+
+  if (memcmp(&value, record + sizeof(uint64_t), sizeof(elem_t)) != 0) {
+    set_record_value(record, value);
+    frame->dirty = true;
+  }
+
+  return false;
+}
+
+static bool disk_any(void *storage, ioopm_predicate pred, void *arg) {
+  callback_t callback = { .pred = pred, .arg = arg };
+  return visit_records(storage, visit_pred, &callback);
+}
+
+static void disk_apply_to_all(void *storage, ioopm_apply_function apply_fun, void *arg) {
+  callback_t callback = { .apply_fun = apply_fun, .arg = arg };
+  visit_records(storage, visit_apply, &callback);
+}
+
+static size_t disk_remove_if(void *storage, ioopm_predicate pred, void *arg, ioopm_apply_function on_removed, void *removed_arg) {
+  disk_table_t *t = storage;
+  size_t removed = 0;
+
+  for (size_t bucket = 0; bucket < t->meta.bucket_count; bucket++) {
+    page_no_t page_no = t->directory[bucket];
+
+    while (page_no != 0) {
+      frame_t *frame = fetch_page(t, page_no);
+      unsigned char *cursor = frame->data + PAGE_HEADER_SIZE;
+      unsigned char *end = cursor + header(frame)->used;
+      unsigned char *kept_end = cursor;
+
+      // Records that are kept are moved over the removed ones, so the page is compacted in one pass
+      while (cursor < end) {
+        size_t size = record_size(cursor);
+        elem_t value = record_value(cursor);
+
+        if (pred(record_key(t, cursor), value, arg)) {
+          on_removed(record_key(t, cursor), &value, removed_arg);
+          header(frame)->count--;
+          t->meta.used_bytes -= size;
+          removed++;
+        } else {
+          if (kept_end != cursor) {
+            memmove(kept_end, cursor, size);
+          }
+
+          kept_end += size;
+        }
+
+        cursor += size;
+      }
+
+      if (kept_end != end) {
+        header(frame)->used = kept_end - (frame->data + PAGE_HEADER_SIZE);
+        frame->dirty = true;
+      }
+
+      page_no = header(frame)->next;
+      unpin(frame);
+    }
+  }
+
+  t->meta.size -= removed;
+  return removed;
+}
+
+static bool disk_sync(void *storage) {
+  disk_table_t *t = storage;
+  bool success = !t->failed;
+
+  write_directory(t);
+
+  for (size_t i = 0; i < t->frame_count; i++) {
+    if (t->frames[i]->dirty && !write_page(t, t->frames[i])) {
+      success = false;
+    }
+  }
+
+  // The meta page is written last, so that it never refers to pages that are not written
+  if (success) {
+    unsigned char page[PAGE_SIZE] = { 0 };
+    memcpy(page, &t->meta, sizeof(meta_t));
+    success = pwrite(t->fd, page, PAGE_SIZE, 0) == PAGE_SIZE;
+  }
+
+  success = fsync(t->fd) == 0 && success;
+  t->failed = false;
+
+  return success;
+}
+
+static elem_t disk_export_key(void *storage, elem_t key) {
+  disk_table_t *t = storage;
+
+  if (!t->meta.string_keys) {
+    return key;
+  }
+
+  size_t length = strlen(key.extra) + 1;
+
+  if (t->keys == NULL || t->keys->capacity - t->keys->used < length) {
+    size_t capacity = length > ARENA_CHUNK_SIZE ? length : ARENA_CHUNK_SIZE;
+    key_chunk_t *chunk = calloc(1, sizeof(key_chunk_t) + capacity);
+
+    chunk->capacity = capacity;
+    chunk->next = t->keys;
+    t->keys = chunk;
+  }
+
+  char *copy = t->keys->data + t->keys->used;
+  memcpy(copy, key.extra, length);
+  t->keys->used += length;
+
+  return ptr_elem(copy);
+}
+
+static void disk_destroy(void *storage) {
+  disk_table_t *t = storage;
+
+  if (t->meta.magic == DISK_MAGIC) {
+    disk_sync(t);
+  }
+
+  close(t->fd);
+
+  for (size_t i = 0; i < t->frame_count; i++) {
+    free(t->frames[i]->data);
+    free(t->frames[i]);
+  }
+
+  free_exported_keys(t);
+  free(t->page_map);
+  free(t->frames);
+  free(t->directory);
+  free(t);
+}
+
+const table_backend_t disk_table_backend = {
+  .lookup = disk_lookup,
+  .insert = disk_insert,
+  .remove = disk_remove,
+  .size = disk_size,
+  .clear = disk_clear,
+  .any = disk_any,
+  .apply_to_all = disk_apply_to_all,
+  .remove_if = disk_remove_if,
+  .sync = disk_sync,
+  .export_key = disk_export_key,
+  .release_keys = free_exported_keys,
+  .destroy = disk_destroy,
+};
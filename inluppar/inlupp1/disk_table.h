@@ -0,0 +1,37 @@
+#pragma once
+
+#include <stdbool.h>
+
+#include "common.h"
+#include "table_backend.h"
+
+/**
+ * @file disk_table.h
+ * @author Fredrik Engstrand, Alex Alstergren
+ * @date 19 October 2026
+ * @brief File-backed linear hashing storage, used by ioopm_hash_table_open.
+ *
+ * The file is divided into fixed-size pages. Each bucket is a chain of pages and buckets
+ * are split one at a time (linear hashing) as the file grows, so there is never a global rehash.
+ * Only a small amount of pages are kept in memory at once.
+ */
+
+typedef struct disk_table disk_table_t;
+
+/// @brief The operations of a disk table, see table_backend.h
+extern const table_backend_t disk_table_backend;
+
+/// @brief Open or create a disk table
+/// @param path the file that holds the table
+/// @param eq_key the function used to compare two keys
+/// @param hash_func the function used to create a hash code from the key
+/// @param string_keys true if keys are NULL terminated strings, else the elem_t itself is stored
+/// @param cache_pages the maximum amount of pages to keep in memory
+/// @return the table or NULL (with errno set) if the file could not be opened or is not a disk table
+disk_table_t *disk_table_open(
+  const char *path,
+  ioopm_eq_function eq_key,
+  ioopm_hash_function hash_func,
+  bool string_keys,
+  size_t cache_pages
+);
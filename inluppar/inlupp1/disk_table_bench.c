@@ -0,0 +1,114 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include "common.h"
+#include "hash_table.h"
+
+#define DEFAULT_WORDS 300000
+#define DEFAULT_CACHE_PAGES 64
+#define PAGE_SIZE 4096
+#define BENCH_PATH "disk_table_bench.db"
+
+static double seconds_since(struct timespec *start) {
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (now.tv_sec - start->tv_sec) + (now.tv_nsec - start->tv_nsec) / 1e9;
+}
+
+/// @brief Counts every word twice, the same way freq_count does (lookup followed by insert)
+static double count_words(ioopm_hash_table_t *ht, size_t words) {
+  char buf[32];
+  struct timespec start;
+  clock_gettime(CLOCK_MONOTONIC, &start);
+
+  for (size_t round = 0; round < 2; round++) {
+    for (size_t i = 0; i < words; i++) {
+      sprintf(buf, "word%zu", i);
+      elem_t count = ioopm_hash_table_lookup(ht, ptr_elem(buf));
+      ioopm_hash_table_insert(ht, ptr_elem(buf), int_elem(HAS_ERROR() ? 1 : count.integer + 1));
+    }
+  }
+
+  return seconds_since(&start);
+}
+
+/// @brief Looks up random words, to measure the page cache when there is no locality
+static double lookup_random(ioopm_hash_table_t *ht, size_t words) {
+  char buf[32];
+  struct timespec start;
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  srand(1);
+
+  for (size_t i = 0; i < words; i++) {
+    sprintf(buf, "word%d", rand() % (int)words);
+    ioopm_hash_table_lookup(ht, ptr_elem(buf));
+  }
+
+  return seconds_since(&start);
+}
+
+int main(int argc, char *argv[]) {
+  size_t words = argc > 1 ? atol(argv[1]) : DEFAULT_WORDS;
+  size_t cache_pages = argc > 2 ? atol(argv[2]) : DEFAULT_CACHE_PAGES;
+
+  unlink(BENCH_PATH);
+
+  ioopm_hash_table_t *ht = ioopm_hash_table_open(BENCH_PATH, eq_elem_string, eq_elem_int, string_knr_hash, true, cache_pages);
+
+  double count_time = count_words(ht, words);
+
+  struct timespec start;
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  ioopm_hash_table_sync(ht);
+  double sync_time = seconds_since(&start);
+
+  double lookup_time = lookup_random(ht, words);
+  ioopm_hash_table_close(ht);
+
+  struct stat info;
+  stat(BENCH_PATH, &info);
+
+  printf("words: %zu, cache: %zu KiB, file: %lld KiB (%.1fx the cache)\n",
+    words,
+    cache_pages * PAGE_SIZE / 1024,
+    (long long)info.st_size / 1024,
+    (double)info.st_size / (cache_pages * PAGE_SIZE)
+  );
+  printf("disk:   count %.3fs (%.0f ops/s), sync %.3fs, random lookup %.3fs (%.0f ops/s)\n",
+    count_time, 4 * words / count_time, sync_time, lookup_time, words / lookup_time);
+
+  // The same workload in memory, for comparison
+  ioopm_hash_table_t *memory = ioopm_hash_table_create(eq_elem_string, eq_elem_int, string_knr_hash);
+  ioopm_list_t *keys;
+
+  // The in-memory table does not copy its keys, so the words are duplicated once
+  char buf[32];
+
+  for (size_t i = 0; i < words; i++) {
+    sprintf(buf, "word%zu", i);
+    ioopm_hash_table_insert(memory, ptr_elem(strdup(buf)), int_elem(0));
+  }
+
+  count_time = count_words(memory, words);
+  lookup_time = lookup_random(memory, words);
+
+  printf("memory: count %.3fs (%.0f ops/s), random lookup %.3fs (%.0f ops/s)\n",
+    count_time, 4 * words / count_time, lookup_time, words / lookup_time);
+
+  keys = ioopm_hash_table_keys(memory);
+
+  while (!ioopm_linked_list_is_empty(keys)) {
+    free(ioopm_linked_list_remove(keys, 0).extra);
+  }
+
+  ioopm_linked_list_destroy(keys);
+  ioopm_hash_table_destroy(memory);
+  unlink(BENCH_PATH);
+
+  return 0;
+}
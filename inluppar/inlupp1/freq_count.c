@@ -2,33 +2,31 @@
 #include <stdlib.h>
 #include <stdbool.h>
 #include <string.h>
+#include <inttypes.h>
+#include <unistd.h>
 
 #include "common.h"
-#include "hash_table.h"
-#include "linked_list.h"
+#include "counter.h"
 
 #define Delimiters "+-#@()[]{}.,:;!? \t\n\r"
+#define Initial_words 64
 
-//Compares two strings.
-static int cmpstringp(const void *p1, const void *p2) {
-  return strcmp(* (char * const *) p1, * (char * const *) p2);
+//Compares the keys of two counter entries.
+static int cmp_entry_key(const void *p1, const void *p2) {
+  return strcmp(((const ioopm_counter_entry_t *) p1)->key, ((const ioopm_counter_entry_t *) p2)->key);
 }
 
-//Sort keys in an array.
-void sort_keys(char *keys[], size_t no_keys) {
-  qsort(keys, no_keys, sizeof(char*), cmpstringp);
+//Sort entries in an array by their keys.
+void sort_entries(ioopm_counter_entry_t entries[], size_t no_entries) {
+  qsort(entries, no_entries, sizeof(ioopm_counter_entry_t), cmp_entry_key);
 }
 
-//Process the words and insert.
-void process_word(ioopm_hash_table_t *ht, char *word, size_t count) {
-  ioopm_hash_table_insert(ht, ptr_elem(word), int_elem(count));
-}
-
-void process_file(char *filename, ioopm_hash_table_t *ht) {
+void process_file(char *filename, ioopm_counter_t *counter) {
   FILE *f = fopen(filename, "r");
+  size_t capacity = Initial_words;
+  const char **words = calloc(capacity, sizeof(char*));
 
   while (true) {
-    char *word_dup = NULL;
     char *buf = NULL;
     size_t len = 0;
     getline(&buf, &len, f);
@@ -38,78 +36,85 @@ void process_file(char *filename, ioopm_hash_table_t *ht) {
       break;
     }
 
+    size_t no_words = 0;
+
     for (char *word = strtok(buf, Delimiters);
        word && *word;
        word = strtok(NULL, Delimiters)
     ) {
-      elem_t count = ioopm_hash_table_lookup(ht, ptr_elem(word));
-
-      if (HAS_ERROR()) {
-        // Only duplicate the word in memory if the word does not exist.
-        // If we were to always duplicate the string, multiple insertions would
-        // each cause a single memory leak, since new duplications will not
-        // be saved in the hash table and will therefore not be deallocated at the end.
-        word_dup = strdup(word);
-        process_word(ht, word_dup, 1);
-      } else {
-        process_word(ht, word, count.integer + 1);
+      if (no_words == capacity) {
+        capacity *= 2;
+        words = realloc(words, capacity * sizeof(char*));
       }
+
+      words[no_words++] = word;
     }
 
+    // The counter copies new words, so the buffer can be reused for the next line
+    ioopm_counter_increment_all(counter, words, no_words, 1);
+
     free(buf);
   }
 
+  free(words);
   fclose(f);
 }
 
+//Print the k most frequent words.
+static void print_top_k(ioopm_counter_t *counter, size_t k) {
+  ioopm_counter_entry_t *top = ioopm_counter_top_k(counter, k);
+  size_t size = ioopm_counter_size(counter);
+
+  for (size_t i = 0; i < k && i < size; i++) {
+    printf("%s: %" PRIu64 "\n", top[i].key, top[i].count);
+  }
+
+  free(top);
+}
+
 int main(int argc, char *argv[]) {
-  if (argc <= 1) {
-    puts("Usage: freq-count file1 ... filen");
+  long k = -1;
+  int option;
+
+  while ((option = getopt(argc, argv, "k:")) != -1) {
+    if (option != 'k' || (k = atol(optarg)) < 0) {
+      puts("Usage: freq-count [-k N] file1 ... filen");
+      return 1;
+    }
+  }
+
+  if (optind >= argc) {
+    puts("Usage: freq-count [-k N] file1 ... filen");
     return 1;
   }
   
-  ioopm_hash_table_t *ht = ioopm_hash_table_create(eq_elem_string, eq_elem_int, string_knr_hash);
+  ioopm_counter_t *counter = ioopm_counter_create();
 
-  for (int i = 1; i < argc; ++i) {
-    process_file(argv[i], ht);
+  for (int i = optind; i < argc; ++i) {
+    process_file(argv[i], counter);
   }
 
-  size_t size = ioopm_hash_table_size(ht);
-  ioopm_list_t *keys = ioopm_hash_table_keys(ht);
-  ioopm_list_iterator_t *iterator = ioopm_list_iterator(keys);
+  size_t size = ioopm_counter_size(counter);
 
   printf("Total unique words: %zu\n", size);
 
-  char **arr = calloc(size, sizeof(char*));
-  size_t i = 0;
-  elem_t current;
-
-  // Create array with words
-  while (ioopm_iterator_has_next(iterator)) {
-    current = ioopm_iterator_next(iterator);
-    arr[i] = current.extra;
-    i++;
+  if (k >= 0) {
+    // Only the most frequent words are printed, so there is no need to sort all of them
+    print_top_k(counter, k);
+    ioopm_counter_destroy(counter);
+    return 0;
   }
 
-  sort_keys(arr, size);
+  ioopm_counter_entry_t *entries = ioopm_counter_entries(counter);
 
-  // Print all words
-  char *current_word;
-  for (i = 0; i < size; i++) {
-    current_word = arr[i];
-    printf("%s: %d\n", current_word, ioopm_hash_table_lookup(ht, ptr_elem(current_word)).integer);
-  }
+  sort_entries(entries, size);
 
-  // Deallocate each duplicated word after we have printed out each element from the hash table
-  // This is not handled by the hash table, since the value is not stored in the hash table
-  // directly, but rather as a pointer.
-  for (i = 0 ; i < size ; i++) {
-    free(arr[i]);
+  // Print all words
+  for (size_t i = 0; i < size; i++) {
+    printf("%s: %" PRIu64 "\n", entries[i].key, entries[i].count);
   }
 
-  free(arr);
-
-  ioopm_iterator_destroy(iterator);
-  ioopm_linked_list_destroy(keys);
-  ioopm_hash_table_destroy(ht);
+  // The words are owned by the counter, and are deallocated when it is destroyed
+  free(entries);
+  ioopm_counter_destroy(counter);
 }
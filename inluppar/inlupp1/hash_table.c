@@ -2,22 +2,63 @@
 #include <stdlib.h>
 #include <errno.h>
 #include <stdbool.h>
+#include <string.h>
 
 #include "common.h"
 #include "hash_table.h"
 #include "linked_list.h"
+#include "vector.h"
+#include "table_backend.h"
+#include "disk_table.h"
+#include "compact_table.h"
+#include "wal.h"
+#include "pages.h"
 
 #define DEFAULT_CAPACITY 17
 #define DEFAULT_LOAD_FACTOR 0.75
 #define GROWTH_FACTOR 2
+#define INLINE_KEY_SIZE 24
 
 typedef struct entry entry_t;
+typedef struct value_group value_group_t;
+typedef struct key_node key_node_t;
+typedef struct value_index value_index_t;
 
 //@brief the entries that reside within the hash table.
 struct entry {
   elem_t key;     // holds the key
   elem_t value;   // holds the value
   entry_t *next;  // points to the next entry (possibly NULL)
+  char inline_key[]; // holds the key if the table owns its keys and the key is short
+};
+
+//@brief a distinct value in the reverse value index, with all keys that map to it.
+struct value_group {
+  elem_t value;         // the indexed value
+  key_node_t *keys;     // the keys that currently map to value (never empty)
+  value_group_t *next;  // points to the next group in the same value bucket (possibly NULL)
+};
+
+//@brief a key in the reverse value index, found through its own bucket so that removing it does not
+// scan the other keys with the same value.
+struct key_node {
+  elem_t key;           // the indexed key
+  value_group_t *group; // the group of the value that key maps to
+  key_node_t *prev;     // the previous key in the group (NULL for the first)
+  key_node_t *next;     // the next key in the group (possibly NULL)
+  key_node_t *bucket_next; // the next node in the same key bucket (possibly NULL)
+};
+
+//@brief a secondary index from values to keys, see ioopm_hash_table_index_values.
+struct value_index {
+  size_t size;                   // Holds the amount of indexed keys (same as the hash table).
+  size_t capacity;               // How many key buckets there are in the index.
+  size_t groups;                 // Holds the amount of distinct values.
+  size_t group_capacity;         // How many value buckets there are in the index.
+  ioopm_hash_function hash_func; // The hashing function used on values.
+  value_group_t **groups_buckets; // The value buckets (without dummies, NULL if empty).
+  key_node_t **buckets;          // The key buckets, hashed like the hash table (without dummies, NULL if empty).
+  const ioopm_alloc_policy_t *policy; // How the buckets are allocated (the policy of the hash table).
 };
 
 //@brief a hash table, containing its equality functions, the size, buckets containing the entries, and the hash function.
@@ -28,9 +69,54 @@ struct hash_table {
   ioopm_eq_function eq_key;      // equality function for keys.
   ioopm_eq_function eq_value;    // equality function for the values.
   ioopm_hash_function hash_func; // The hashing function.
-  entry_t **buckets;             // Pointer towards the buckets.
+  ioopm_seeded_hash_function seeded_hash; // Keyed hashing function, used instead of hash_func (possibly NULL).
+  unsigned long seed;            // Random value mixed into every hash code (0 if integer keys are not hashed).
+  entry_t *buckets;              // The dummy entry of each bucket, stored next to each other.
+  ioopm_alloc_policy_t policy;   // How the buckets are allocated.
+  value_index_t *value_index;    // Reverse index from values to keys (NULL if not enabled).
+  const table_backend_t *backend;// Alternative storage for the entries (NULL if the buckets are used).
+  void *storage;                 // The state of the backend.
+  wal_t *log;                    // Write-ahead log of all changes (NULL if not logged).
+  bool owns_keys;                // True if string keys are copied into the table.
+  char *entry_block;             // The entries copied by ioopm_hash_table_clone, allocated together (possibly NULL).
+  size_t entry_block_size;       // The size of entry_block in bytes.
 };
 
+//@brief used by predicates that collects keys or values from a hash table into a list or a vector.
+typedef struct collector {
+  ioopm_hash_table_t *ht;  // The hash table that is collected from.
+  ioopm_list_t *list;      // The list that keys or values are appended to (NULL if vector is used).
+  ioopm_vector_t *vector;  // The vector that keys or values are appended to (NULL if list is used).
+  elem_t value;            // Only keys for this value are collected (collect_keys_for_value).
+} collector_t;
+
+//@brief an apply function together with the hash table whose value index or log has to be updated.
+typedef struct tracked_apply {
+  ioopm_hash_table_t *ht;          // The hash table that is applied upon.
+  ioopm_apply_function apply_fun;  // The function supplied by the user.
+  void *arg;                       // The extra argument to apply_fun.
+} tracked_apply_t;
+
+//@brief the function and argument called for each entry removed by remove_if.
+typedef struct removal {
+  ioopm_hash_table_t *ht;           // The hash table that is removed from.
+  ioopm_apply_function on_removed;  // The function supplied by the user (possibly NULL).
+  void *arg;                        // The extra argument to on_removed.
+} removal_t;
+
+//@brief the best entries seen so far, used by top_k.
+typedef struct top_k_collector {
+  ioopm_hash_table_t *ht;           // The hash table that is walked.
+  ioopm_entry_compare cmp;          // The order of the entries.
+  ioopm_top_k_t heap;               // The kept entries.
+} top_k_collector_t;
+
+//@brief the predicate and argument used when implementing all using any.
+typedef struct negated_predicate {
+  ioopm_predicate pred;
+  void *arg;
+} negated_predicate_t;
+
 static entry_t *entry_create(elem_t key, elem_t value, entry_t *next) {
   // Allocate memory for the new entry.
   entry_t *result = calloc(1, sizeof(entry_t));
@@ -45,10 +131,61 @@ static entry_t *entry_create(elem_t key, elem_t value, entry_t *next) {
   return result;
 }
 
-static void entry_destroy(entry_t *entry){
+/// @brief Copies a long key into memory owned by the hash table, which is freed together with its entry
+static char *copy_long_key(const char *key, size_t length) {
+  return memcpy(malloc(length), key, length);
+}
+
+/// @brief Creates an entry with a copy of a string key
+/// Short keys are stored right after the entry, so that comparing them does not touch another cache line.
+static entry_t *entry_create_owned(ioopm_hash_table_t *ht, elem_t key, elem_t value, entry_t *next) {
+  size_t length = strlen(key.extra) + 1;
+  size_t inline_length = length <= INLINE_KEY_SIZE ? length : 0;
+  entry_t *result = malloc(sizeof(entry_t) + inline_length);
+  char *copy;
+
+  if (inline_length > 0) {
+    copy = memcpy(result->inline_key, key.extra, length);
+  } else {
+    copy = copy_long_key(key.extra, length);
+  }
+
+  *result = (entry_t){
+    .key = ptr_elem(copy),
+    .value = value,
+    .next = next,
+  };
+
+  return result;
+}
+
+static void entry_destroy(ioopm_hash_table_t *ht, entry_t *entry){
+  char *address = (char *)entry;
+
+  // Long keys are allocated on their own, also for entries in the block of a clone
+  if (ht->owns_keys && entry->key.extra != entry->inline_key) {
+    free(entry->key.extra);
+  }
+
+  // Entries in the block of a clone are deallocated together when the table is cleared
+  if (address >= ht->entry_block && address < ht->entry_block + ht->entry_block_size) {
+    return;
+  }
+
   free(entry);
 }
 
+/// @brief Calculates the size of an entry, including its inline key, rounded up to keep the next entry aligned
+static size_t entry_size(ioopm_hash_table_t *ht, entry_t *entry) {
+  size_t size = sizeof(entry_t);
+
+  if (ht->owns_keys && entry->key.extra == entry->inline_key) {
+    size += strlen(entry->inline_key) + 1;
+  }
+
+  return (size + _Alignof(entry_t) - 1) & ~(_Alignof(entry_t) - 1);
+}
+
 /// @brief Checks if the current size exceeds the current load factor
 static bool should_increase_buckets(float load_factor, size_t capacity, size_t size) {
   return load_factor * capacity < size;
@@ -63,22 +200,40 @@ static unsigned long extract_hash_code(elem_t key) {
   return key.unsigned_long;
 }
 
-/// @brief Inserts dummy nodes into each bucket
-static entry_t **create_buckets(size_t capacity) {
-  entry_t **buckets = calloc(capacity, sizeof(entry_t*));
-  
-  for (size_t i = 0; i < capacity; i++){
-    //Create a dummy value in each bucket with some random values (they will never be read)
-    buckets[i] = entry_create(int_elem(0), ptr_elem(NULL), NULL);
+/// @brief Calculates the hash code used to find the bucket of a key
+static unsigned long hash_key(ioopm_hash_table_t *ht, elem_t key) {
+  if (ht->seeded_hash != NULL) {
+    return ht->seeded_hash(key, ht->seed);
   }
-  
-  return buckets;
+
+  if (ht->seed == 0) {
+    return ht->hash_func(key);
+  }
+
+  // Mixing the seed into the hash code means that keys with different hash codes can not be
+  // chosen to end up in the same bucket. Keys with equal hash codes still collide, which is
+  // why string_knr_hash is replaced by a seeded hash function when the table is created.
+  unsigned long hash = ht->hash_func(key) ^ ht->seed;
+  hash = (hash ^ (hash >> 33)) * 0xff51afd7ed558ccdUL;
+  hash = (hash ^ (hash >> 33)) * 0xc4ceb9fe1a85ec53UL;
+  return hash ^ (hash >> 33);
 }
 
+/// @brief Allocates the dummy entries of all buckets in one array
+/// The dummies are zeroed, which makes them empty (their key and value are never read).
+/// Looking up a key then reads the dummy directly, instead of first reading a pointer to it.
+static entry_t *create_buckets(ioopm_hash_table_t *ht, size_t capacity) {
+  return pages_alloc(capacity * sizeof(entry_t), &ht->policy);
+}
+
+static void destroy_buckets(ioopm_hash_table_t *ht, entry_t *buckets, size_t capacity) {
+  pages_free(buckets, capacity * sizeof(entry_t), &ht->policy);
+}
 
-// @brief Resizing the hashtable creating
+
+// @brief Resizing the hashtable creating a new buckets array and moving all entries over
 static void resize_hash_table(ioopm_hash_table_t *ht) {
-  entry_t **old_buckets = ht->buckets;
+  entry_t *old_buckets = ht->buckets;
   size_t old_capacity = ht->capacity;
   
   // Update the capacity
@@ -86,36 +241,34 @@ static void resize_hash_table(ioopm_hash_table_t *ht) {
   
   // Update the capacity of the hash table and allocate memory
   // for the resized hash table and insert dummy entries
-  ht->buckets = create_buckets(ht->capacity);
-  
-  // Reset the size, since inserting will increase the size
-  ht->size = 0;
+  ht->buckets = create_buckets(ht, ht->capacity);
 
-  entry_t *entry, *tmp;
+  entry_t *entry, *tmp, *dummy;
 
   for (size_t i = 0; i < old_capacity; i++){
-    entry = old_buckets[i]->next;
+    entry = old_buckets[i].next;
 
     while (entry != NULL) {
       tmp = entry->next;
-      ioopm_hash_table_insert(ht, entry->key, entry->value);
 
-      // Insert is pass by value, meaning that we can safely destroy the previous entry
-      entry_destroy(entry);
+      // Move the entry to the front of its new bucket. The entry itself is reused,
+      // which means that neither the size nor the value index has to be updated.
+      dummy = &ht->buckets[hash_key(ht, entry->key) % ht->capacity];
+      entry->next = dummy->next;
+      dummy->next = entry;
+
       entry = tmp;
     }
-
-    free(old_buckets[i]);
   }
 
-  free(old_buckets);
+  destroy_buckets(ht, old_buckets, old_capacity);
 }
 
 /// @brief Finds the previous entry for a hash code (key)
 /// @param hash_func the hash function used by the hash table to calculate hash codes from keys
 /// @param entry the entry to start searching from (generally the dummy)
 /// @param hash_code the hash code to find
-/// @returns the previous entry or sets errno to EINVAL if the key was not found
+/// @returns the previous entry, or the last entry in the bucket (whose next is NULL) if the key was not found
 static entry_t *find_previous_entry_for_key(ioopm_eq_function eq_key, entry_t *entry, elem_t key) {
   entry_t *current = entry;
 
@@ -124,30 +277,343 @@ static entry_t *find_previous_entry_for_key(ioopm_eq_function eq_key, entry_t *e
     current = current->next;
   }
 
-  if (current->next == NULL) {
-    // If no previous entry was found, set errno
+  return current;
+}
+
+static value_index_t *value_index_create(ioopm_hash_function hash_func, size_t capacity, const ioopm_alloc_policy_t *policy) {
+  value_index_t *index = calloc(1, sizeof(value_index_t));
+
+  *index = (value_index_t){
+    .size = 0,
+    .capacity = capacity,
+    .groups = 0,
+    .group_capacity = capacity,
+    .hash_func = hash_func,
+    .groups_buckets = pages_alloc(capacity * sizeof(value_group_t*), policy),
+    .buckets = pages_alloc(capacity * sizeof(key_node_t*), policy),
+    .policy = policy,
+  };
+
+  return index;
+}
+
+static void value_index_clear(value_index_t *index) {
+  for (size_t i = 0; i < index->capacity; i++) {
+    key_node_t *node = index->buckets[i];
+    index->buckets[i] = NULL;
+
+    while (node != NULL) {
+      key_node_t *tmp = node->bucket_next;
+      free(node);
+      node = tmp;
+    }
+  }
+
+  for (size_t i = 0; i < index->group_capacity; i++) {
+    value_group_t *group = index->groups_buckets[i];
+    index->groups_buckets[i] = NULL;
+
+    while (group != NULL) {
+      value_group_t *tmp = group->next;
+      free(group);
+      group = tmp;
+    }
+  }
+
+  index->size = 0;
+  index->groups = 0;
+}
+
+static void value_index_destroy(value_index_t *index) {
+  value_index_clear(index);
+  pages_free(index->groups_buckets, index->group_capacity * sizeof(value_group_t*), index->policy);
+  pages_free(index->buckets, index->capacity * sizeof(key_node_t*), index->policy);
+  free(index);
+}
+
+/// @brief Moves all key nodes into a new buckets array with GROWTH_FACTOR times as many buckets
+static void value_index_resize_keys(ioopm_hash_table_t *ht, value_index_t *index) {
+  key_node_t **old_buckets = index->buckets;
+  size_t old_capacity = index->capacity;
+
+  index->capacity = old_capacity * GROWTH_FACTOR;
+  index->buckets = pages_alloc(index->capacity * sizeof(key_node_t*), index->policy);
+
+  for (size_t i = 0; i < old_capacity; i++) {
+    key_node_t *node = old_buckets[i];
+
+    while (node != NULL) {
+      key_node_t *tmp = node->bucket_next;
+      unsigned long bucket = hash_key(ht, node->key) % index->capacity;
+      node->bucket_next = index->buckets[bucket];
+      index->buckets[bucket] = node;
+      node = tmp;
+    }
+  }
+
+  pages_free(old_buckets, old_capacity * sizeof(key_node_t*), index->policy);
+}
+
+/// @brief Moves all value groups into a new buckets array with GROWTH_FACTOR times as many buckets
+static void value_index_resize_groups(value_index_t *index) {
+  value_group_t **old_buckets = index->groups_buckets;
+  size_t old_capacity = index->group_capacity;
+
+  index->group_capacity = old_capacity * GROWTH_FACTOR;
+  index->groups_buckets = pages_alloc(index->group_capacity * sizeof(value_group_t*), index->policy);
+
+  for (size_t i = 0; i < old_capacity; i++) {
+    value_group_t *group = old_buckets[i];
+
+    while (group != NULL) {
+      value_group_t *tmp = group->next;
+      unsigned long bucket = index->hash_func(group->value) % index->group_capacity;
+      group->next = index->groups_buckets[bucket];
+      index->groups_buckets[bucket] = group;
+      group = tmp;
+    }
+  }
+
+  pages_free(old_buckets, old_capacity * sizeof(value_group_t*), index->policy);
+}
+
+/// @brief Finds the group of a value in the index of ht
+/// @return the group, or NULL if no key maps to value
+static value_group_t *value_index_find(ioopm_hash_table_t *ht, elem_t value) {
+  value_index_t *index = ht->value_index;
+  value_group_t *group = index->groups_buckets[index->hash_func(value) % index->group_capacity];
+
+  while (group != NULL && !ht->eq_value(group->value, value)) {
+    group = group->next;
+  }
+
+  return group;
+}
+
+/// @brief Records that key maps to value in the index of ht
+static void value_index_add(ioopm_hash_table_t *ht, elem_t key, elem_t value) {
+  value_index_t *index = ht->value_index;
+  value_group_t *group = value_index_find(ht, value);
+
+  if (group == NULL) {
+    unsigned long bucket = index->hash_func(value) % index->group_capacity;
+
+    group = calloc(1, sizeof(value_group_t));
+    *group = (value_group_t){ .value = value, .next = index->groups_buckets[bucket] };
+    index->groups_buckets[bucket] = group;
+    index->groups++;
+  }
+
+  unsigned long bucket = hash_key(ht, key) % index->capacity;
+  key_node_t *node = calloc(1, sizeof(key_node_t));
+
+  *node = (key_node_t){
+    .key = key,
+    .group = group,
+    .next = group->keys,
+    .bucket_next = index->buckets[bucket],
+  };
+
+  if (group->keys != NULL) {
+    group->keys->prev = node;
+  }
+
+  group->keys = node;
+  index->buckets[bucket] = node;
+  index->size++;
+
+  if (should_increase_buckets(ht->load_factor, index->capacity, index->size)) {
+    value_index_resize_keys(ht, index);
+  }
+
+  if (should_increase_buckets(ht->load_factor, index->group_capacity, index->groups)) {
+    value_index_resize_groups(index);
+  }
+}
+
+/// @brief Forgets that key maps to value in the index of ht (the pair must be indexed)
+/// The key is found through its own bucket, so this does not depend on how many keys share value.
+static void value_index_remove(ioopm_hash_table_t *ht, elem_t key, elem_t value) {
+  value_index_t *index = ht->value_index;
+  key_node_t **cursor = &index->buckets[hash_key(ht, key) % index->capacity];
+
+  while (*cursor != NULL && !ht->eq_key((*cursor)->key, key)) {
+    cursor = &(*cursor)->bucket_next;
+  }
+
+  if (*cursor == NULL) {
+    return;
+  }
+
+  key_node_t *node = *cursor;
+  value_group_t *group = node->group;
+
+  *cursor = node->bucket_next;
+
+  if (node->prev == NULL) {
+    group->keys = node->next;
+  } else {
+    node->prev->next = node->next;
+  }
+
+  if (node->next != NULL) {
+    node->next->prev = node->prev;
+  }
+
+  free(node);
+  index->size--;
+
+  if (group->keys != NULL) {
+    return;
+  }
+
+  // The last key of the value is gone, so the value is no longer indexed
+  value_group_t **group_cursor = &index->groups_buckets[index->hash_func(group->value) % index->group_capacity];
+
+  while (*group_cursor != group) {
+    group_cursor = &(*group_cursor)->next;
+  }
+
+  *group_cursor = group->next;
+  free(group);
+  index->groups--;
+}
+
+/// @brief Frees the keys exported by the previous call that returned keys, before exporting new ones
+/// This keeps the memory of the exported keys bounded by the largest single result.
+static void release_exported_keys(ioopm_hash_table_t *ht) {
+  if (ht->backend != NULL && ht->backend->release_keys != NULL) {
+    ht->backend->release_keys(ht->storage);
+  }
+}
+
+/// @brief Returns a key passed to a predicate in a form that outlives the predicate
+static elem_t stable_key(ioopm_hash_table_t *ht, elem_t key) {
+  if (ht->backend != NULL && ht->backend->export_key != NULL) {
+    return ht->backend->export_key(ht->storage, key);
+  }
+
+  return key;
+}
+
+/// @brief Appends a key or value to the list or vector of a collector
+static void collect(collector_t *collector, elem_t elem) {
+  if (collector->vector != NULL) {
+    ioopm_vector_append(collector->vector, elem);
+  } else {
+    ioopm_linked_list_append(collector->list, elem);
+  }
+}
+
+/// @brief Used in conjuction with any to insert keys into a linked list or vector
+/// @param x a pointer to a collector_t
+static bool collect_key(elem_t key, elem_t value, void *x) {
+  collector_t *collector = x;
+  collect(collector, stable_key(collector->ht, key));
+  return false;
+}
+
+/// @brief Used in conjuction with any to insert values into a linked list or vector
+/// @param x a pointer to a collector_t
+static bool collect_value(elem_t key, elem_t value, void *x) {
+  collector_t *collector = x;
+  collect(collector, value);
+  return false;
+}
+
+/// @brief Used in conjuction with any to insert the keys for a value into a linked list
+/// @param x a pointer to a collector_t
+static bool collect_keys_for_value(elem_t key, elem_t value, void *x) {
+  collector_t *collector = x;
+
+  if (collector->ht->eq_value(value, collector->value)) {
+    ioopm_linked_list_append(collector->list, stable_key(collector->ht, key));
+  }
+
+  return false;
+}
+
+/// @brief Compares two entries of a top-k heap with the function supplied to top_k
+/// @param extra a pointer to a top_k_collector_t
+static int compare_entries(const void *a, const void *b, void *extra) {
+  const ioopm_hash_table_entry_t *x = a;
+  const ioopm_hash_table_entry_t *y = b;
+  return ((top_k_collector_t *)extra)->cmp(x->key, x->value, y->key, y->value);
+}
+
+/// @brief Used in conjuction with any to keep the k first entries in a heap
+/// @param x a pointer to a top_k_collector_t
+static bool collect_top_k(elem_t key, elem_t value, void *x) {
+  top_k_collector_t *top = x;
+  ioopm_hash_table_entry_t entry = { .key = key, .value = value };
+
+  // Only entries that are kept have their key exported
+  if (ioopm_top_k_accepts(&top->heap, &entry)) {
+    entry.key = stable_key(top->ht, key);
+    ioopm_top_k_add(&top->heap, &entry);
+  }
+
+  return false;
+}
+
+/// @brief Used in conjuction with any to add all entries to a newly created value index
+static bool index_entry(elem_t key, elem_t value, void *x) {
+  value_index_add(x, key, value);
+  return false;
+}
+
+/// @brief Appends an insert to the log of ht (if any), setting errno if it could not be written
+static void log_insert(ioopm_hash_table_t *ht, elem_t key, elem_t value) {
+  if (ht->log != NULL && !wal_log_insert(ht->log, key, value)) {
     FAILURE();
-    return entry;
   }
+}
 
-  SUCCESS();
-  return current;
+/// @brief Appends a remove to the log of ht (if any), setting errno if it could not be written
+static void log_remove(ioopm_hash_table_t *ht, elem_t key) {
+  if (ht->log != NULL && !wal_log_remove(ht->log, key)) {
+    FAILURE();
+  }
 }
 
-/// @brief Used in conjuction with apply_to_all to insert keys into a linked list
-/// @param x a pointer to a linked list
-static void append_key_to_list(elem_t key, elem_t *value, void *x) {
-  ioopm_list_t *list = x;
-  ioopm_linked_list_append(list, key);
+/// @brief Applies a function to a value, and re-indexes and logs the value if it was replaced
+/// @param x a pointer to a tracked_apply_t
+static void apply_and_track(elem_t key, elem_t *value, void *x) {
+  tracked_apply_t *data = x;
+  elem_t old_value = *value;
+
+  data->apply_fun(key, value, data->arg);
+
+  if (!data->ht->eq_value(old_value, *value)) {
+    if (data->ht->value_index != NULL) {
+      value_index_remove(data->ht, key, old_value);
+      value_index_add(data->ht, key, *value);
+    }
+
+    log_insert(data->ht, key, *value);
+  }
 }
 
-/// @brief Used in conjuction with apply_to_all to insert values into a linked list
-/// @param x a pointer to a linked list
-static void append_value_to_list(elem_t key, elem_t *value, void *x) {
-  ioopm_list_t *list = x;
-  ioopm_linked_list_append(list, *value);
+/// @brief Updates the value index and the log for an entry that is about to be removed by remove_if
+/// @param x a pointer to a removal_t
+static void entry_removed(elem_t key, elem_t *value, void *x) {
+  removal_t *removal = x;
+
+  if (removal->ht->value_index != NULL) {
+    value_index_remove(removal->ht, key, *value);
+  }
+
+  log_remove(removal->ht, key);
+
+  if (removal->on_removed != NULL) {
+    removal->on_removed(key, value, removal->arg);
+  }
 }
 
+static bool negate_pred(elem_t key, elem_t value, void *x) {
+  negated_predicate_t *negated = x;
+  return !negated->pred(key, value, negated->arg);
+}
 
 static bool value_compare_pred(elem_t key, elem_t value, void *x) {
   compare_data_t *data = (compare_data_t*)x;
@@ -165,7 +631,7 @@ ioopm_hash_table_t *ioopm_hash_table_create(
   ioopm_eq_function eq_value,
   ioopm_hash_function hash_func
 ) {
-  return ioopm_hash_table_create_custom(eq_key, eq_value, hash_func, DEFAULT_LOAD_FACTOR, DEFAULT_CAPACITY);
+  return ioopm_hash_table_create_custom(eq_key, eq_value, hash_func, DEFAULT_LOAD_FACTOR, DEFAULT_CAPACITY, NULL);
 }
 
 ioopm_hash_table_t *ioopm_hash_table_create_custom(
@@ -173,7 +639,8 @@ ioopm_hash_table_t *ioopm_hash_table_create_custom(
   ioopm_eq_function eq_value,
   ioopm_hash_function hash_func,
   float load_factor,
-  size_t capacity
+  size_t capacity,
+  const ioopm_alloc_policy_t *policy
 ) {
   // Allocate space for a ioopm_hash_table_t and an array of buckets with the size of capacity
   ioopm_hash_table_t *ht = calloc(1, sizeof(ioopm_hash_table_t));
@@ -184,110 +651,457 @@ ioopm_hash_table_t *ioopm_hash_table_create_custom(
     .load_factor = load_factor,
     .eq_key = eq_key,
     .eq_value = eq_value,
+    .value_index = NULL,
   };
 
   // If the user did not provide a hash func, default to the integer value
+  // (which keeps small integer keys in order, so no seed is mixed in)
   if (hash_func == NULL) {
     ht->hash_func = extract_hash_code;
   } else {
     ht->hash_func = hash_func;
+    ht->seed = random_seed();
+  }
+
+  // Strings with equal string_knr_hash codes are easy to find ("Aa" and "BB"), and mixing in the seed
+  // afterwards keeps them in the same bucket, so the strings are hashed with the seed instead
+  if (hash_func == string_knr_hash) {
+    ht->seeded_hash = string_sip_hash;
   }
 
-  // Allocate memory for the buckets and insert dummies
-  ht->buckets = create_buckets(capacity);
+  if (policy != NULL) {
+    ht->policy = *policy;
+  }
+
+  // Allocate memory for the buckets and their dummies
+  ht->buckets = create_buckets(ht, capacity);
+
+  return ht;
+}
 
+ioopm_hash_table_t *ioopm_hash_table_create_seeded(
+  ioopm_eq_function eq_key,
+  ioopm_eq_function eq_value,
+  ioopm_seeded_hash_function seeded_hash
+) {
+  ioopm_hash_table_t *ht = ioopm_hash_table_create(eq_key, eq_value, NULL);
+  ht->seeded_hash = seeded_hash;
+  ht->seed = random_seed();
   return ht;
 }
 
+ioopm_hash_table_t *ioopm_hash_table_create_string_keys(
+  ioopm_eq_function eq_value,
+  ioopm_hash_function hash_func
+) {
+  ioopm_hash_table_t *ht = ioopm_hash_table_create(eq_elem_string, eq_value, hash_func);
+
+  // Keys of string tables often come from outside the program, so they are hashed with a secret seed
+  if (hash_func == NULL) {
+    ht->seeded_hash = string_sip_hash;
+    ht->seed = random_seed();
+  }
+
+  ht->owns_keys = true;
+  return ht;
+}
+
+ioopm_hash_table_t *ioopm_hash_table_clone(ioopm_hash_table_t *ht) {
+  if (ht->backend != NULL) {
+    FAILURE();
+    return NULL;
+  }
+
+  ioopm_hash_table_t *clone = calloc(1, sizeof(ioopm_hash_table_t));
+
+  // The clone has the same capacity and seed, so every entry stays in the same bucket
+  *clone = (ioopm_hash_table_t){
+    .size = ht->size,
+    .capacity = ht->capacity,
+    .load_factor = ht->load_factor,
+    .eq_key = ht->eq_key,
+    .eq_value = ht->eq_value,
+    .hash_func = ht->hash_func,
+    .seeded_hash = ht->seeded_hash,
+    .seed = ht->seed,
+    .policy = ht->policy,
+    .owns_keys = ht->owns_keys,
+  };
+
+  clone->buckets = create_buckets(clone, clone->capacity);
+
+  for (size_t i = 0; i < ht->capacity; i++) {
+    for (entry_t *entry = ht->buckets[i].next; entry != NULL; entry = entry->next) {
+      clone->entry_block_size += entry_size(ht, entry);
+    }
+  }
+
+  clone->entry_block = clone->entry_block_size > 0 ? malloc(clone->entry_block_size) : NULL;
+  char *cursor = clone->entry_block;
+
+  // Copy each chain in order, appending the copies to the end of the new chain
+  for (size_t i = 0; i < ht->capacity; i++) {
+    entry_t *last = &clone->buckets[i];
+
+    for (entry_t *entry = ht->buckets[i].next; entry != NULL; entry = entry->next) {
+      size_t size = entry_size(ht, entry);
+      entry_t *copy = (entry_t *)cursor;
+
+      *copy = (entry_t){ .key = entry->key, .value = entry->value, .next = NULL };
+
+      if (ht->owns_keys && entry->key.extra == entry->inline_key) {
+        copy->key = ptr_elem(strcpy(copy->inline_key, entry->inline_key));
+      } else if (ht->owns_keys) {
+        copy->key = ptr_elem(copy_long_key(entry->key.extra, strlen(entry->key.extra) + 1));
+      }
+
+      last->next = copy;
+      last = copy;
+      cursor += size;
+    }
+  }
+
+  if (ht->value_index != NULL) {
+    ioopm_hash_table_index_values(clone, ht->value_index->hash_func);
+  }
+
+  SUCCESS();
+  return clone;
+}
+
+ioopm_hash_table_t *ioopm_hash_table_create_compact(
+  ioopm_eq_function eq_key,
+  ioopm_eq_function eq_value,
+  ioopm_hash_function hash_func,
+  bool small_values
+) {
+  ioopm_hash_table_t *ht = calloc(1, sizeof(ioopm_hash_table_t));
+
+  *ht = (ioopm_hash_table_t){
+    .load_factor = DEFAULT_LOAD_FACTOR,
+    .eq_key = eq_key,
+    .eq_value = eq_value,
+    .hash_func = hash_func == NULL ? extract_hash_code : hash_func,
+    .backend = &compact_table_backend,
+    .storage = compact_table_create(eq_key, hash_func, small_values),
+  };
+
+  return ht;
+}
+
+ioopm_hash_table_t *ioopm_hash_table_open(
+  const char *path,
+  ioopm_eq_function eq_key,
+  ioopm_eq_function eq_value,
+  ioopm_hash_function hash_func,
+  bool string_keys,
+  size_t cache_pages
+) {
+  disk_table_t *storage = disk_table_open(path, eq_key, hash_func, string_keys, cache_pages);
+
+  if (storage == NULL) {
+    return NULL;
+  }
+
+  ioopm_hash_table_t *ht = calloc(1, sizeof(ioopm_hash_table_t));
+
+  *ht = (ioopm_hash_table_t){
+    .load_factor = DEFAULT_LOAD_FACTOR,
+    .eq_key = eq_key,
+    .eq_value = eq_value,
+    .hash_func = hash_func == NULL ? extract_hash_code : hash_func,
+    .backend = &disk_table_backend,
+    .storage = storage,
+  };
+
+  return ht;
+}
+
+ioopm_hash_table_t *ioopm_hash_table_recover(
+  const char *path,
+  ioopm_eq_function eq_key,
+  ioopm_eq_function eq_value,
+  ioopm_hash_function hash_func,
+  bool string_keys,
+  size_t sync_every
+) {
+  wal_t *log = wal_open(path, string_keys, sync_every);
+
+  if (log == NULL) {
+    return NULL;
+  }
+
+  // Owning the string keys means that recovered keys and keys inserted later are freed the same way
+  ioopm_hash_table_t *ht = string_keys
+    ? ioopm_hash_table_create_string_keys(eq_value, hash_func)
+    : ioopm_hash_table_create(eq_key, eq_value, hash_func);
+
+  // The log is attached after the replay, so that replayed operations are not logged again
+  wal_replay(log, ht);
+  ht->log = log;
+
+  SUCCESS();
+  return ht;
+}
+
+void ioopm_hash_table_sync(ioopm_hash_table_t *ht) {
+  bool success = true;
+
+  if (ht->backend != NULL && ht->backend->sync != NULL && !ht->backend->sync(ht->storage)) {
+    success = false;
+  }
+
+  if (ht->log != NULL && !wal_commit(ht->log)) {
+    success = false;
+  }
+
+  if (!success) {
+    FAILURE();
+    return;
+  }
+
+  SUCCESS();
+}
+
+void ioopm_hash_table_checkpoint(ioopm_hash_table_t *ht) {
+  if (ht->log == NULL || !wal_checkpoint(ht->log, ht)) {
+    FAILURE();
+    return;
+  }
+
+  SUCCESS();
+}
+
+void ioopm_hash_table_close(ioopm_hash_table_t *ht) {
+  // Synced first, since destroy has no way to report that the last changes were lost
+  ioopm_hash_table_sync(ht);
+  bool success = !HAS_ERROR();
+
+  ioopm_hash_table_destroy(ht);
+
+  if (!success) {
+    FAILURE();
+    return;
+  }
+
+  SUCCESS();
+}
+
 void ioopm_hash_table_destroy(ioopm_hash_table_t *ht) {
-  // Deallocate all values
-  ioopm_hash_table_clear(ht);
+  if (ht->log != NULL) {
+    // Closed first, so that removing the entries from memory is not logged
+    wal_close(ht->log);
+    ht->log = NULL;
+  }
+
+  if (ht->backend != NULL) {
+    ht->backend->destroy(ht->storage);
+  } else {
+    // Deallocate all values
+    ioopm_hash_table_clear(ht);
 
-  // Deallocate dummy entries
-  for (size_t i = 0; i < ht->capacity; i ++){
-    free(ht->buckets[i]);
+    // Deallocate dummy entries
+    destroy_buckets(ht, ht->buckets, ht->capacity);
+  }
+
+  if (ht->value_index != NULL) {
+    value_index_destroy(ht->value_index);
   }
 
-  free(ht->buckets);
   free(ht);
 }
 
-elem_t ioopm_hash_table_lookup(ioopm_hash_table_t *ht, elem_t key) {
-  unsigned long hashed_key = ht->hash_func(key);
-  unsigned long bucket = hashed_key % ht->capacity;
+bool ioopm_hash_table_try_lookup(ioopm_hash_table_t *ht, elem_t key, elem_t *out) {
+  if (ht->backend != NULL) {
+    return ht->backend->lookup(ht->storage, key, out);
+  }
 
-  entry_t *tmp = find_previous_entry_for_key(ht->eq_key, ht->buckets[bucket], key);
-  entry_t *next = tmp->next;
+  unsigned long bucket = hash_key(ht, key) % ht->capacity;
+  entry_t *next = find_previous_entry_for_key(ht->eq_key, &ht->buckets[bucket], key)->next;
 
   //Check if the entry existed in the hashtable.
-  if (!HAS_ERROR()) {
-    return next->value;
+  if (next == NULL) {
+    return false;
+  }
+
+  *out = next->value;
+  return true;
+}
+
+elem_t ioopm_hash_table_lookup(ioopm_hash_table_t *ht, elem_t key) {
+  elem_t value;
+
+  if (ioopm_hash_table_try_lookup(ht, key, &value)) {
+    SUCCESS();
+    return value;
   }
 
+  FAILURE();
   return ptr_elem(NULL);
 }
 
 void ioopm_hash_table_insert(ioopm_hash_table_t *ht, elem_t key, elem_t value) {
-  unsigned long hashed_key = ht->hash_func(key);
+  if (ht->backend != NULL) {
+    bool replaced;
+    elem_t old_value;
+
+    if (!ht->backend->insert(ht->storage, key, value, &replaced, &old_value)) {
+      FAILURE();
+      return;
+    }
+
+    if (ht->value_index != NULL) {
+      if (replaced) {
+        value_index_remove(ht, key, old_value);
+      }
+
+      value_index_add(ht, key, value);
+    }
+
+    SUCCESS();
+    log_insert(ht, key, value);
+    return;
+  }
+
+  unsigned long hashed_key = hash_key(ht, key);
 
   /// Calculate the bucket for this entry
   unsigned long bucket = hashed_key % ht->capacity;
 
   /// Search for an existing entry for a key
-  entry_t *entry = find_previous_entry_for_key(ht->eq_key, ht->buckets[bucket], key);
+  entry_t *entry = find_previous_entry_for_key(ht->eq_key, &ht->buckets[bucket], key);
   entry_t *next = entry->next;
 
   /// Check if the next entry should be updated or not
-  if (!HAS_ERROR()) {
+  if (next != NULL) {
+    if (ht->value_index != NULL) {
+      value_index_remove(ht, next->key, next->value);
+      value_index_add(ht, next->key, value);
+    }
+
     next->value = value;
   } else {
-    entry->next = entry_create(key, value, next);
+    if (ht->owns_keys) {
+      entry->next = entry_create_owned(ht, key, value, next);
+    } else {
+      entry->next = entry_create(key, value, next);
+    }
+
     ht->size++;
 
+    if (ht->value_index != NULL) {
+      value_index_add(ht, entry->next->key, value);
+    }
+
     if (should_increase_buckets(ht->load_factor, ht->capacity, ht->size)) {
       resize_hash_table(ht);
     }
+  }
 
-    // Reset errno
-    SUCCESS();
+  SUCCESS();
+  log_insert(ht, key, value);
+}
+
+bool ioopm_hash_table_try_remove(ioopm_hash_table_t *ht, elem_t key, elem_t *out) {
+  if (ht->backend != NULL) {
+    if (!ht->backend->remove(ht->storage, key, out)) {
+      return false;
+    }
+
+    if (ht->value_index != NULL) {
+      value_index_remove(ht, key, *out);
+    }
+
+    log_remove(ht, key);
+    return true;
+  }
+
+  unsigned long bucket = hash_key(ht, key) % ht->capacity;
+  entry_t *previous_entry = find_previous_entry_for_key(ht->eq_key, &ht->buckets[bucket], key);
+  entry_t *current_entry = previous_entry->next;
+
+  if (current_entry == NULL) {
+    return false;
   }
+
+  previous_entry->next = current_entry->next;
+
+  // Save the value before deallocating
+  *out = current_entry->value;
+
+  if (ht->value_index != NULL) {
+    value_index_remove(ht, current_entry->key, *out);
+  }
+
+  entry_destroy(ht, current_entry);
+
+  ht->size--;
+  log_remove(ht, key);
+  return true;
 }
 
 elem_t ioopm_hash_table_remove(ioopm_hash_table_t *ht, elem_t key) {
-  unsigned long hashed_key = ht->hash_func(key);
-  unsigned long bucket = hashed_key % ht->capacity;
-  entry_t *dummy = ht->buckets[bucket];
+  elem_t value;
 
-  // If the bucket is not empty and the key is valid, try to remove the key-value pair
-  if (dummy->next != NULL) {
-    entry_t *previous_entry = find_previous_entry_for_key(ht->eq_key, dummy, key);
-    entry_t *current_entry = previous_entry->next;
+  // Reset errno first, so that a failed write to the log is still reported
+  SUCCESS();
 
-    // find_previous_entry_for_key sets errno to EINVAL if no previous entry was found
-    if (!HAS_ERROR()) {
-      previous_entry->next = current_entry->next;
+  if (ioopm_hash_table_try_remove(ht, key, &value)) {
+    return value;
+  }
 
-      // Save the value before deallocating
-      elem_t value = current_entry->value;
+  FAILURE();
+  return ptr_elem(NULL);
+}
 
-      entry_destroy(current_entry);
+size_t ioopm_hash_table_remove_if(
+  ioopm_hash_table_t *ht,
+  ioopm_predicate pred,
+  void *arg,
+  ioopm_apply_function on_removed
+) {
+  removal_t removal = { .ht = ht, .on_removed = on_removed, .arg = arg };
+  size_t removed = 0;
+
+  SUCCESS();
+
+  if (ht->backend != NULL) {
+    return ht->backend->remove_if(ht->storage, pred, arg, entry_removed, &removal);
+  }
+
+  for (size_t i = 0; i < ht->capacity; i++) {
+    entry_t *previous = &ht->buckets[i];
+
+    // Unlink every matching entry while walking the bucket, instead of looking up each key again
+    while (previous->next != NULL) {
+      entry_t *entry = previous->next;
+
+      if (!pred(entry->key, entry->value, arg)) {
+        previous = entry;
+        continue;
+      }
 
-      ht->size--;
-      SUCCESS();
-      return value;
+      entry_removed(entry->key, &entry->value, &removal);
+      previous->next = entry->next;
+      entry_destroy(ht, entry);
+      removed++;
     }
   }
 
-  FAILURE();
-  return ptr_elem(NULL);
+  ht->size -= removed;
+  return removed;
 }
 
 size_t ioopm_hash_table_size(ioopm_hash_table_t *ht){
+  if (ht->backend != NULL) {
+    return ht->backend->size(ht->storage);
+  }
+
   return ht->size;
 }
 
 bool ioopm_hash_table_is_empty(ioopm_hash_table_t *ht) {
-  return ht->size == 0;
+  return ioopm_hash_table_size(ht) == 0;
 }
 
 void ioopm_hash_table_clear(ioopm_hash_table_t *ht) {
@@ -296,41 +1110,94 @@ void ioopm_hash_table_clear(ioopm_hash_table_t *ht) {
   entry_t *next_entry;
   entry_t *tmp;
 
+  if (ht->backend != NULL) {
+    ht->backend->clear(ht->storage);
+  }
+
   for (unsigned long i = 0; i < ht->capacity ; i ++){
-    dummy = ht->buckets[i];
+    dummy = &ht->buckets[i];
     next_entry = dummy->next;
     dummy->next = NULL; // make sure that the dummy does not point to an unallocated entry
 
     while (next_entry != NULL) {
       //Iterate through the bucket, destroying each entry.
       tmp = next_entry->next;
-      entry_destroy(next_entry);
+      entry_destroy(ht, next_entry);
       next_entry = tmp;
     }
   }
 
   ht->size = 0;
+  free(ht->entry_block);
+  ht->entry_block = NULL;
+  ht->entry_block_size = 0;
+
+  if (ht->value_index != NULL) {
+    value_index_clear(ht->value_index);
+  }
+
+  if (ht->log != NULL && !wal_log_clear(ht->log)) {
+    FAILURE();
+  }
 }
 
 ioopm_list_t *ioopm_hash_table_keys(ioopm_hash_table_t *ht) {
   //Creates a list, appending each key to the list and returns it.
-  ioopm_list_t *list = ioopm_linked_list_create(ht->eq_key);
-  ioopm_hash_table_apply_to_all(ht, append_key_to_list, list);
-  return list;
+  collector_t collector = { .ht = ht, .list = ioopm_linked_list_create(ht->eq_key) };
+  release_exported_keys(ht);
+  ioopm_hash_table_any(ht, collect_key, &collector);
+  return collector.list;
 }
 
 ioopm_list_t *ioopm_hash_table_values(ioopm_hash_table_t *ht) {
   //Creates a list, appending each value to the list and returns it.
-  ioopm_list_t *list = ioopm_linked_list_create(ht->eq_value);
-  ioopm_hash_table_apply_to_all(ht, append_value_to_list, list);
-  return list;
+  collector_t collector = { .ht = ht, .list = ioopm_linked_list_create(ht->eq_value) };
+  ioopm_hash_table_any(ht, collect_value, &collector);
+  return collector.list;
+}
+
+ioopm_vector_t *ioopm_hash_table_keys_vector(ioopm_hash_table_t *ht) {
+  // The size is known, so the vector never has to grow
+  ioopm_vector_t *keys = ioopm_vector_create_with_capacity(ht->eq_key, ioopm_hash_table_size(ht));
+  collector_t collector = { .ht = ht, .vector = keys };
+  release_exported_keys(ht);
+  ioopm_hash_table_any(ht, collect_key, &collector);
+  return keys;
+}
+
+ioopm_vector_t *ioopm_hash_table_values_vector(ioopm_hash_table_t *ht) {
+  ioopm_vector_t *values = ioopm_vector_create_with_capacity(ht->eq_value, ioopm_hash_table_size(ht));
+  collector_t collector = { .ht = ht, .vector = values };
+  ioopm_hash_table_any(ht, collect_value, &collector);
+  return values;
+}
+
+ioopm_hash_table_entry_t *ioopm_hash_table_top_k(ioopm_hash_table_t *ht, size_t k, ioopm_entry_compare cmp) {
+  size_t size = ioopm_hash_table_size(ht);
+  k = k < size ? k : size;
+
+  ioopm_hash_table_entry_t *entries = calloc(k, sizeof(ioopm_hash_table_entry_t));
+  top_k_collector_t top = { .ht = ht, .cmp = cmp };
+
+  top.heap = ioopm_top_k_create(entries, sizeof(ioopm_hash_table_entry_t), k, compare_entries, &top);
+
+  release_exported_keys(ht);
+  ioopm_hash_table_any(ht, collect_top_k, &top);
+
+  ioopm_top_k_sort(&top.heap);
+  return entries;
 }
 
 bool ioopm_hash_table_all(ioopm_hash_table_t *ht, ioopm_predicate pred, void *arg){
   entry_t *entry;
 
+  if (ht->backend != NULL) {
+    negated_predicate_t negated = { .pred = pred, .arg = arg };
+    return !ht->backend->any(ht->storage, negate_pred, &negated);
+  }
+
   for(size_t i = 0; i < ht->capacity; i++){
-    entry = ht->buckets[i]->next;
+    entry = ht->buckets[i].next;
 
     while(entry != NULL) {
       //If an entry doesn't conform to the predicate, return false.
@@ -344,9 +1211,26 @@ bool ioopm_hash_table_all(ioopm_hash_table_t *ht, ioopm_predicate pred, void *ar
 
 void ioopm_hash_table_apply_to_all(ioopm_hash_table_t *ht, ioopm_apply_function apply_fun, void *arg){
   entry_t *entry;
+  tracked_apply_t data = { .ht = ht, .apply_fun = apply_fun, .arg = arg };
+
+  if (ht->log != NULL) {
+    // Cleared first, since a replaced value that could not be logged sets errno
+    SUCCESS();
+  }
+
+  if (ht->value_index != NULL || ht->log != NULL) {
+    // The function may replace values, which means that they have to be re-indexed and logged
+    apply_fun = apply_and_track;
+    arg = &data;
+  }
+
+  if (ht->backend != NULL) {
+    ht->backend->apply_to_all(ht->storage, apply_fun, arg);
+    return;
+  }
 
   for(size_t i = 0; i < ht->capacity; i++){
-    entry = ht->buckets[i]->next;
+    entry = ht->buckets[i].next;
 
     while(entry != NULL) {
       apply_fun(entry->key, &entry->value, arg);
@@ -358,8 +1242,12 @@ void ioopm_hash_table_apply_to_all(ioopm_hash_table_t *ht, ioopm_apply_function
 bool ioopm_hash_table_any(ioopm_hash_table_t *ht, ioopm_predicate pred, void *arg){
   entry_t *entry;
 
+  if (ht->backend != NULL) {
+    return ht->backend->any(ht->storage, pred, arg);
+  }
+
   for (size_t i = 0; i < ht->capacity; i++) {
-    entry = ht->buckets[i]->next;
+    entry = ht->buckets[i].next;
 
     while(entry != NULL) {
       if (pred(entry->key, entry->value, arg)) return true;
@@ -371,11 +1259,57 @@ bool ioopm_hash_table_any(ioopm_hash_table_t *ht, ioopm_predicate pred, void *ar
 }
 
 bool ioopm_hash_table_has_key(ioopm_hash_table_t *ht, elem_t key){
+  if (ht->backend != NULL) {
+    elem_t value;
+    return ht->backend->lookup(ht->storage, key, &value);
+  }
+
   compare_data_t data = { .eq_func = ht->eq_key, .element = key };
   return ioopm_hash_table_any(ht, key_compare_pred, &data);
 }
 
 bool ioopm_hash_table_has_value(ioopm_hash_table_t *ht, elem_t value) {
+  if (ht->value_index != NULL) {
+    return value_index_find(ht, value) != NULL;
+  }
+
   compare_data_t data = { .eq_func = ht->eq_value, .element = value };
   return ioopm_hash_table_any(ht, value_compare_pred, &data);
 }
+
+void ioopm_hash_table_index_values(ioopm_hash_table_t *ht, ioopm_hash_function value_hash) {
+  if (ht->backend != NULL && ht->backend->export_key != NULL) {
+    // The keys of the backend are only valid for a short while, so they can not be indexed
+    FAILURE();
+    return;
+  }
+
+  if (ht->value_index != NULL) {
+    value_index_destroy(ht->value_index);
+  }
+
+  ht->value_index = value_index_create(value_hash == NULL ? extract_hash_code : value_hash, DEFAULT_CAPACITY, &ht->policy);
+
+  // Index all entries that were inserted before the index was enabled
+  ioopm_hash_table_any(ht, index_entry, ht);
+  SUCCESS();
+}
+
+ioopm_list_t *ioopm_hash_table_keys_for_value(ioopm_hash_table_t *ht, elem_t value) {
+  collector_t collector = { .ht = ht, .list = ioopm_linked_list_create(ht->eq_key), .value = value };
+
+  if (ht->value_index != NULL) {
+    value_group_t *group = value_index_find(ht, value);
+
+    for (key_node_t *node = group != NULL ? group->keys : NULL; node != NULL; node = node->next) {
+      ioopm_linked_list_append(collector.list, node->key);
+    }
+
+    return collector.list;
+  }
+
+  // Without an index, every entry has to be compared
+  release_exported_keys(ht);
+  ioopm_hash_table_any(ht, collect_keys_for_value, &collector);
+  return collector.list;
+}
@@ -5,6 +5,8 @@
 
 #include "common.h"
 #include "linked_list.h"
+#include "vector.h"
+#include "pages.h"
 
 /**
  * @file hash_table.h
@@ -15,12 +17,23 @@
 
 typedef bool(*ioopm_predicate)(elem_t key, elem_t value, void *extra);
 typedef void(*ioopm_apply_function)(elem_t key, elem_t *value, void *extra);
+typedef int(*ioopm_entry_compare)(elem_t key_a, elem_t value_a, elem_t key_b, elem_t value_b);
+
+//@brief a key together with its value, as returned by ioopm_hash_table_top_k.
+typedef struct hash_table_entry {
+  elem_t key;
+  elem_t value;
+} ioopm_hash_table_entry_t;
 
 /// @brief Create a new hash table
 /// @param eq_key the function used to compare two keys in the hash table
 /// @param eq_values the function used to compare two values in the hash table
-/// @param hash_func the function used to create a hash code from the key
+/// @param hash_func the function used to create a hash code from the key (mixed with a random seed)
 ///        if NULL, it fallbacks to extracting an integer value from your key
+///        Mixing in the seed does not separate keys with equal hash codes, so only tables that hash
+///        with the seed resist keys chosen to collide: string_knr_hash is replaced by string_sip_hash
+///        with the seed of the table, and other hash functions should be passed to
+///        ioopm_hash_table_create_seeded instead if the keys come from untrusted sources.
 /// @return A new empty hash table
 ioopm_hash_table_t *ioopm_hash_table_create(
   ioopm_eq_function eq_key,
@@ -33,19 +46,151 @@ ioopm_hash_table_t *ioopm_hash_table_create(
 /// @param eq_values the function used to compare two values in the hash table
 /// @param hash_func the function used to create a hash code from the key
 /// @param load_factor the load factor used to increase the amount of buckets when the size increases
+/// @param capacity the initial amount of buckets
+/// @param policy how the bucket arrays are allocated, e.g. with huge pages (NULL for the default, see pages.h)
 /// @return A new empty hash table
 ioopm_hash_table_t *ioopm_hash_table_create_custom(
   ioopm_eq_function eq_key,
   ioopm_eq_function eq_value,
   ioopm_hash_function hash_func,
   float load_factor,
-  size_t capacity
+  size_t capacity,
+  const ioopm_alloc_policy_t *policy
 );
 
-/// @brief Delete a hash table and free its memory
-/// If you store pointer elements in the hash table, e.g. char*, the hash table
-/// will not be able to deallocate them, since it does not know the type of the data.
-/// This means that you are responsible for deallocating any memory that is not stored
+/// @brief Create a new hash table that hashes keys with a secret random seed
+/// Every hash table that is given a hash function mixes a random seed into the hash codes of its keys,
+/// but keys with equal hash codes still end up in the same bucket (except for string_knr_hash, which
+/// is replaced by string_sip_hash). A seeded hash function makes it impossible to choose keys that collide without knowing
+/// the seed, which keeps lookups fast even if the keys are chosen by an attacker.
+/// @param eq_key the function used to compare two keys in the hash table
+/// @param eq_values the function used to compare two values in the hash table
+/// @param seeded_hash the function used to create a hash code from the key and the seed, e.g. string_sip_hash
+/// @return A new empty hash table
+ioopm_hash_table_t *ioopm_hash_table_create_seeded(
+  ioopm_eq_function eq_key,
+  ioopm_eq_function eq_value,
+  ioopm_seeded_hash_function seeded_hash
+);
+
+/// @brief Create a new hash table with NULL terminated string keys that are owned by the table
+/// Every inserted key is copied, so the caller does not have to keep it allocated. Keys up to
+/// 23 characters are stored together with their entry, longer keys in memory owned by the table.
+/// Keys returned by ioopm_hash_table_keys stay valid until they are removed or the table is cleared
+/// or destroyed. The memory of a long key is freed as soon as its entry is removed.
+/// @param eq_values the function used to compare two values in the hash table
+/// @param hash_func the function used to create a hash code from the key, if NULL string_sip_hash
+///        is used with a random seed (see ioopm_hash_table_create_seeded)
+/// @return A new empty hash table
+ioopm_hash_table_t *ioopm_hash_table_create_string_keys(
+  ioopm_eq_function eq_value,
+  ioopm_hash_function hash_func
+);
+
+/// @brief Create a hash table that uses less memory per entry, for tables with less than 4G entries
+/// Entries are stored in a pool of arrays linked together with 32-bit indices instead of pointers,
+/// and buckets do not have dummy entries. Each entry takes 16 bytes (20 bytes without small values)
+/// and each bucket 4 bytes, instead of a separately allocated entry and a bucket with a dummy entry.
+/// With 1M integer entries this is about 30 bytes per entry (26 with small values), against about
+/// 86 bytes for ioopm_hash_table_create (measured with compact_table_bench).
+/// All ioopm_hash_table_* functions can be used on the table.
+/// @param eq_key the function used to compare two keys in the hash table
+/// @param eq_values the function used to compare two values in the hash table
+/// @param hash_func the function used to create a hash code from the key
+///        if NULL, it fallbacks to extracting an integer value from your key
+/// @param small_values true if values only hold an integer or unsigned_int, which are then stored in 4 bytes
+/// @return the hash table
+ioopm_hash_table_t *ioopm_hash_table_create_compact(
+  ioopm_eq_function eq_key,
+  ioopm_eq_function eq_value,
+  ioopm_hash_function hash_func,
+  bool small_values
+);
+
+/// @brief Open a hash table that is stored in a file, creating the file if it does not exist
+/// The table uses linear hashing over fixed-size pages and only keeps cache_pages pages in memory,
+/// which means that it can hold more entries than fits in memory. All ioopm_hash_table_* functions
+/// can be used on the table, except for ioopm_hash_table_index_values.
+/// Values are stored as they are, so they should not be pointers. Keys are either stored as they are,
+/// or as NULL terminated strings (at most about 4000 bytes long) if string_keys is true.
+/// Keys passed to predicates and apply functions are only valid during the call, while keys returned
+/// by ioopm_hash_table_keys, ioopm_hash_table_keys_vector, ioopm_hash_table_keys_for_value and
+/// ioopm_hash_table_top_k stay valid until the next call of one of these functions, or until the
+/// table is closed or cleared.
+/// Changes are written to the file by ioopm_hash_table_sync and ioopm_hash_table_close.
+/// @param path the file holding the table
+/// @param eq_key the function used to compare two keys in the hash table
+/// @param eq_values the function used to compare two values in the hash table
+/// @param hash_func the function used to create a hash code from the key
+///        if NULL, it fallbacks to extracting an integer value from your key
+/// @param string_keys true if the keys are pointers to NULL terminated strings
+/// @param cache_pages the amount of 4 KiB pages to keep in memory
+/// @return the hash table or NULL if the file could not be opened, in which case errno is set
+ioopm_hash_table_t *ioopm_hash_table_open(
+  const char *path,
+  ioopm_eq_function eq_key,
+  ioopm_eq_function eq_value,
+  ioopm_hash_function hash_func,
+  bool string_keys,
+  size_t cache_pages
+);
+
+/// @brief Create an in-memory hash table whose changes are written to a log, restoring it from the log
+/// Every insert, remove, clear and value replaced by apply_to_all is appended to the log at path.
+/// When the table is recovered again (e.g. after a crash), the latest snapshot (path with ".snapshot"
+/// appended) and the log are replayed to rebuild the table.
+/// Operations are written in groups: every sync_every operations the log is written and fsynced,
+/// which means that at most sync_every operations are lost in a crash. With sync_every 0, operations
+/// are only guaranteed to be written by ioopm_hash_table_sync, ioopm_hash_table_checkpoint and
+/// ioopm_hash_table_close.
+/// Values are logged as they are, so they should not be pointers. Keys are either logged as they are,
+/// or as NULL terminated strings if string_keys is true. With string keys, the table copies every key
+/// like a table from ioopm_hash_table_create_string_keys, both those restored from the log and those
+/// inserted after that, and eq_key is not used.
+/// @param path the log file
+/// @param eq_key the function used to compare two keys in the hash table
+/// @param eq_values the function used to compare two values in the hash table
+/// @param hash_func the function used to create a hash code from the key
+///        if NULL, it fallbacks to extracting an integer value from your key
+/// @param string_keys true if the keys are pointers to NULL terminated strings
+/// @param sync_every the amount of operations per group commit, 0 to only commit when syncing
+/// @return the hash table or NULL if the log could not be opened, in which case errno is set
+ioopm_hash_table_t *ioopm_hash_table_recover(
+  const char *path,
+  ioopm_eq_function eq_key,
+  ioopm_eq_function eq_value,
+  ioopm_hash_function hash_func,
+  bool string_keys,
+  size_t sync_every
+);
+
+/// @brief Write all changes in a hash table opened with ioopm_hash_table_open or
+/// ioopm_hash_table_recover to its file
+/// Does nothing for hash tables that are only stored in memory.
+/// @param ht hash table operated upon
+/// sets errno to EINVAL if the file or log could not be written, e.g. because the disk is full
+void ioopm_hash_table_sync(ioopm_hash_table_t *ht);
+
+/// @brief Write every entry of a table created with ioopm_hash_table_recover to a new snapshot
+/// and truncate its log, so that the log does not keep growing
+/// @param ht hash table operated upon
+/// sets errno to EINVAL if the table has no log or the snapshot could not be written
+void ioopm_hash_table_checkpoint(ioopm_hash_table_t *ht);
+
+/// @brief Sync and close a hash table opened with ioopm_hash_table_open or ioopm_hash_table_recover
+/// This is the same as ioopm_hash_table_destroy, which also syncs the table, except that errors are reported.
+/// @param ht hash table to be closed
+/// sets errno to EINVAL if the last changes could not be written
+void ioopm_hash_table_close(ioopm_hash_table_t *ht);
+
+/// @brief Create a copy of a hash table with the same entries, functions and settings
+/// All entries of the copy are allocated in one block, and each bucket is copied without hashing
+/// its keys again, which is much faster than inserting every entry into a new table. Memory of
+/// removed entries in the block is not reused until the copy is cleared. Owned string keys are
+/// copied, while other keys and values are shared with the original. The copy has no log.
+/// @param ht the hash table to be copied
+/// @return the copy, or NULL and sets errno to EINVAL if ht is stored in a file or in compact mode
+ioopm_hash_table_t *ioopm_hash_table_clone(ioopm_hash_table_t *ht);
 
 /// @brief Delete a hash table and free its memory
 /// If you store pointer elements in the hash table, e.g. char*, the hash table
@@ -59,6 +204,7 @@ void ioopm_hash_table_destroy(ioopm_hash_table_t *ht);
 /// @param ht hash table operated upon
 /// @param key key to insert
 /// @param value value to insert
+/// sets errno to EINVAL if the entry could not be stored in a file or written to a log
 void ioopm_hash_table_insert(ioopm_hash_table_t *ht, elem_t key, elem_t value);
 
 /// @brief lookup value for key in hash table ht
@@ -67,12 +213,44 @@ void ioopm_hash_table_insert(ioopm_hash_table_t *ht, elem_t key, elem_t value);
 /// @return the value mapped to by key or it sets errno to EINVAL if key does not exist
 elem_t ioopm_hash_table_lookup(ioopm_hash_table_t *ht, elem_t key);
 
+/// @brief lookup value for key in hash table ht without touching errno
+/// @param ht hash table operated upon
+/// @param key key to lookup
+/// @param out where the value mapped to by key is stored (left unchanged if key does not exist)
+/// @return true if key exists, else false
+bool ioopm_hash_table_try_lookup(ioopm_hash_table_t *ht, elem_t key, elem_t *out);
+
 /// @brief remove any mapping from key to a value
 /// @param ht hash table operated upon
 /// @param key key to remove
 /// @return the value mapped to by key or it sets errno to EINVAL if the key does not exist
 elem_t ioopm_hash_table_remove(ioopm_hash_table_t *ht, elem_t key);
 
+/// @brief remove any mapping from key to a value without touching errno
+/// The only exception is a table with a log, where a failed write to the log sets errno to EINVAL.
+/// @param ht hash table operated upon
+/// @param key key to remove
+/// @param out where the value mapped to by key is stored (left unchanged if key does not exist)
+/// @return true if key existed, else false
+bool ioopm_hash_table_try_remove(ioopm_hash_table_t *ht, elem_t key, elem_t *out);
+
+/// @brief remove every entry for which pred returns true, walking each bucket once
+/// This is faster than removing the keys returned by ioopm_hash_table_keys one at a time.
+/// @param ht hash table operated upon
+/// @param pred the predicate deciding which entries to remove
+/// @param arg extra argument to pred and on_removed
+/// @param on_removed called with each entry before it is removed, e.g. to free a key owned by the caller
+///        (may be NULL). It must not free the keys of a table from ioopm_hash_table_create_string_keys
+///        (or ioopm_hash_table_recover with string keys), since these are owned and freed by the table.
+/// @return the amount of removed entries
+/// sets errno to EINVAL if the removals could not be written to the log
+size_t ioopm_hash_table_remove_if(
+  ioopm_hash_table_t *ht,
+  ioopm_predicate pred,
+  void *arg,
+  ioopm_apply_function on_removed
+);
+
 /// @brief returns the number of key => value entries in the hash table
 /// @param h hash table operated upon
 /// @return the number of key => value entries in the hash table
@@ -100,6 +278,27 @@ ioopm_list_t *ioopm_hash_table_keys(ioopm_hash_table_t *ht);
 /// @return a linked list with all the values in the hash table
 ioopm_list_t *ioopm_hash_table_values(ioopm_hash_table_t *ht);
 
+/// @brief return the keys for all entries in a hash map as a vector, in the same order as ioopm_hash_table_keys
+/// The vector is allocated once with room for all keys, and can be sorted in place through ioopm_vector_data.
+/// @param h hash table operated upon
+/// @return a vector with all the keys in the hash table
+ioopm_vector_t *ioopm_hash_table_keys_vector(ioopm_hash_table_t *ht);
+
+/// @brief return the values for all entries in a hash map as a vector, in the same order as ioopm_hash_table_keys_vector
+/// @param h hash table operated upon
+/// @return a vector with all the values in the hash table
+ioopm_vector_t *ioopm_hash_table_values_vector(ioopm_hash_table_t *ht);
+
+/// @brief return the k entries that come first when ordered by cmp, in one pass over the entries
+/// Only k entries are kept in a binary heap while walking the table, which takes O(n log k) time,
+/// instead of sorting all n entries. Keys stay valid as long as keys returned by ioopm_hash_table_keys.
+/// @param h hash table operated upon
+/// @param k the amount of entries sought
+/// @param cmp compares two entries, returning a negative number if entry a comes before entry b,
+///        a positive number if it comes after, and 0 if their order does not matter
+/// @return an array (which has to be freed) with the first min(k, size) entries, ordered by cmp
+ioopm_hash_table_entry_t *ioopm_hash_table_top_k(ioopm_hash_table_t *ht, size_t k, ioopm_entry_compare cmp);
+
 /// @brief check if a hash table has an entry with a given key
 /// @param h hash table operated upon
 /// @param key the key sought
@@ -110,6 +309,23 @@ bool ioopm_hash_table_has_key(ioopm_hash_table_t *ht, elem_t key);
 /// @param value the value sought
 bool ioopm_hash_table_has_value(ioopm_hash_table_t *ht, elem_t value);
 
+/// @brief enable a reverse index from values to keys in a hash table
+/// Once enabled, the index is maintained by insert, remove, clear and apply_to_all,
+/// which makes ioopm_hash_table_has_value and ioopm_hash_table_keys_for_value hashed lookups
+/// instead of scanning every entry. Keeping the index up to date takes O(1) expected time per change,
+/// also when many keys share a value. Enabling the index again rebuilds it with the new hash function.
+/// @param h hash table operated upon
+/// @param value_hash the function used to create a hash code from a value
+///        if NULL, it fallbacks to extracting an integer value from your value
+/// sets errno to EINVAL if the table is stored in a file
+void ioopm_hash_table_index_values(ioopm_hash_table_t *ht, ioopm_hash_function value_hash);
+
+/// @brief return the keys of all entries that has a given value
+/// @param h hash table operated upon
+/// @param value the value sought
+/// @return a linked list with all the keys that maps to value (in no particular order)
+ioopm_list_t *ioopm_hash_table_keys_for_value(ioopm_hash_table_t *ht, elem_t value);
+
 /// @brief check if a predicate is satisfied by all entries in a hash table
 /// @param h hash table operated upon
 /// @param pred the predicate
@@ -127,4 +343,5 @@ bool ioopm_hash_table_any(ioopm_hash_table_t *ht, ioopm_predicate pred, void *ar
 /// @param h hash table operated upon
 /// @param apply_fun the function to be applied to all elements
 /// @param arg extra argument to apply_fun
+/// sets errno to EINVAL if a replaced value could not be written to the log
 void ioopm_hash_table_apply_to_all(ioopm_hash_table_t *ht, ioopm_apply_function apply_fun, void *arg);
\ No newline at end of file
@@ -3,6 +3,7 @@
 #include <stdbool.h>
 #include <stdio.h>
 #include <string.h>
+#include <unistd.h>
 #include <CUnit/Basic.h>
 
 #include "common.h"
@@ -107,7 +108,7 @@ void test_create_destroy() {
 // Test that there are no valid keys after creating an empty hash table
 void test_lookup() {
   size_t capacity = 17;
-  ioopm_hash_table_t *ht = ioopm_hash_table_create_custom(eq_elem_int, eq_elem_string, NULL, 0.75, capacity);
+  ioopm_hash_table_t *ht = ioopm_hash_table_create_custom(eq_elem_int, eq_elem_string, NULL, 0.75, capacity, NULL);
 
   // Make sure that each bucket is empty (except for the dummy entry)
   // Also make sure that accessing a bucket with a key larger than the amount of buckets resolves to NULL
@@ -385,6 +386,43 @@ void test_hash_table_keys_modified() {
   ioopm_hash_table_destroy(ht);
 }
 
+/// @brief Compares two string elems, for sorting with qsort
+int cmp_string_elem(const void *a, const void *b) {
+  return strcmp(((const elem_t *)a)->extra, ((const elem_t *)b)->extra);
+}
+
+void test_hash_table_keys_vector() {
+  ioopm_hash_table_t *ht = ioopm_hash_table_create_string_keys(eq_elem_int, NULL);
+  char *words[] = { "pear", "apple", "fig", "banana" };
+
+  for (int i = 0; i < 4; i++) {
+    ioopm_hash_table_insert(ht, ptr_elem(words[i]), int_elem(i));
+  }
+
+  ioopm_vector_t *keys = ioopm_hash_table_keys_vector(ht);
+  ioopm_vector_t *values = ioopm_hash_table_values_vector(ht);
+
+  CU_ASSERT_EQUAL(ioopm_vector_size(keys), 4);
+  CU_ASSERT_EQUAL(ioopm_vector_size(values), 4);
+
+  // The keys and values are in the same order
+  for (int i = 0; i < 4; i++) {
+    CU_ASSERT_EQUAL(ioopm_hash_table_lookup(ht, ioopm_vector_get(keys, i)).integer, ioopm_vector_get(values, i).integer);
+  }
+
+  // The keys can be sorted in place
+  qsort(ioopm_vector_data(keys), ioopm_vector_size(keys), sizeof(elem_t), cmp_string_elem);
+
+  CU_ASSERT_STRING_EQUAL(ioopm_vector_get(keys, 0).extra, "apple");
+  CU_ASSERT_STRING_EQUAL(ioopm_vector_get(keys, 1).extra, "banana");
+  CU_ASSERT_STRING_EQUAL(ioopm_vector_get(keys, 2).extra, "fig");
+  CU_ASSERT_STRING_EQUAL(ioopm_vector_get(keys, 3).extra, "pear");
+
+  ioopm_vector_destroy(keys);
+  ioopm_vector_destroy(values);
+  ioopm_hash_table_destroy(ht);
+}
+
 void test_hash_table_values() {
   ioopm_hash_table_t *ht = ioopm_hash_table_create(eq_elem_int, eq_elem_string, NULL);
 
@@ -659,7 +697,8 @@ void test_hash_table_resize_keyvalue_order() {
     eq_elem_string,
     NULL,
     0.5,
-    initial_buckets
+    initial_buckets,
+    NULL
   );
 
   // Insert 4 elements to cause a resize (since 0.5*7 == 3.5 < 4) 
@@ -735,6 +774,757 @@ void test_hash_table_resize_large() {
   ioopm_hash_table_destroy(ht);
 }
 
+void test_hash_table_value_index() {
+  ioopm_hash_table_t *ht = ioopm_hash_table_create(eq_elem_int, eq_elem_string, NULL);
+
+  ioopm_hash_table_insert(ht, int_elem(1), ptr_elem("hello"));
+  ioopm_hash_table_index_values(ht, string_knr_hash);
+
+  // Entries inserted before the index was enabled are indexed as well
+  CU_ASSERT_TRUE(ioopm_hash_table_has_value(ht, ptr_elem("hello")));
+  CU_ASSERT_FALSE(ioopm_hash_table_has_value(ht, ptr_elem("world")));
+
+  // Replacing a value moves the key to the new value in the index
+  ioopm_hash_table_insert(ht, int_elem(1), ptr_elem("world"));
+  CU_ASSERT_FALSE(ioopm_hash_table_has_value(ht, ptr_elem("hello")));
+  CU_ASSERT_TRUE(ioopm_hash_table_has_value(ht, ptr_elem("world")));
+
+  ioopm_hash_table_remove(ht, int_elem(1));
+  CU_ASSERT_FALSE(ioopm_hash_table_has_value(ht, ptr_elem("world")));
+
+  // Make sure that the index survives a resize of the hash table
+  for (int i = 0; i < 100; i++) {
+    ioopm_hash_table_insert(ht, int_elem(i), i % 2 == 0 ? ptr_elem("even") : ptr_elem("odd"));
+  }
+
+  CU_ASSERT_TRUE(ioopm_hash_table_has_value(ht, ptr_elem("even")));
+  CU_ASSERT_TRUE(ioopm_hash_table_has_value(ht, ptr_elem("odd")));
+
+  ioopm_hash_table_clear(ht);
+  CU_ASSERT_FALSE(ioopm_hash_table_has_value(ht, ptr_elem("even")));
+
+  ioopm_hash_table_destroy(ht);
+}
+
+void test_hash_table_keys_for_value() {
+  ioopm_hash_table_t *ht = ioopm_hash_table_create(eq_elem_int, eq_elem_string, NULL);
+
+  for (int i = 0; i < 100; i++) {
+    ioopm_hash_table_insert(ht, int_elem(i), i % 2 == 0 ? ptr_elem("even") : ptr_elem("odd"));
+  }
+
+  // The query works both with and without the index
+  for (int indexed = 0; indexed < 2; indexed++) {
+    if (indexed) {
+      ioopm_hash_table_index_values(ht, string_knr_hash);
+    }
+
+    ioopm_list_t *keys = ioopm_hash_table_keys_for_value(ht, ptr_elem("odd"));
+
+    CU_ASSERT_EQUAL(ioopm_linked_list_size(keys), 50);
+    CU_ASSERT_TRUE(ioopm_linked_list_contains(keys, int_elem(1)));
+    CU_ASSERT_TRUE(ioopm_linked_list_contains(keys, int_elem(99)));
+    CU_ASSERT_FALSE(ioopm_linked_list_contains(keys, int_elem(2)));
+
+    ioopm_linked_list_destroy(keys);
+  }
+
+  ioopm_list_t *keys = ioopm_hash_table_keys_for_value(ht, ptr_elem("none"));
+  CU_ASSERT_TRUE(ioopm_linked_list_is_empty(keys));
+  ioopm_linked_list_destroy(keys);
+
+  ioopm_hash_table_destroy(ht);
+}
+
+void test_hash_table_value_index_apply_all() {
+  ioopm_hash_table_t *ht = ioopm_hash_table_create(eq_elem_int, eq_elem_string, NULL);
+
+  elem_t new_value = ptr_elem("goodbye");
+
+  ioopm_hash_table_index_values(ht, string_knr_hash);
+  ioopm_hash_table_insert(ht, int_elem(1), ptr_elem("hello"));
+  ioopm_hash_table_insert(ht, int_elem(2), ptr_elem("hello"));
+
+  ioopm_hash_table_apply_to_all(ht, change_all_values, &new_value);
+
+  CU_ASSERT_FALSE(ioopm_hash_table_has_value(ht, ptr_elem("hello")));
+  CU_ASSERT_TRUE(ioopm_hash_table_has_value(ht, new_value));
+
+  ioopm_list_t *keys = ioopm_hash_table_keys_for_value(ht, new_value);
+  CU_ASSERT_EQUAL(ioopm_linked_list_size(keys), 2);
+  ioopm_linked_list_destroy(keys);
+
+  ioopm_hash_table_destroy(ht);
+}
+
+void test_hash_table_value_index_shared_values() {
+  ioopm_hash_table_t *ht = ioopm_hash_table_create(eq_elem_int, eq_elem_int, NULL);
+
+  ioopm_hash_table_index_values(ht, NULL);
+
+  // Many keys with the same value, of which some move to another value and some are removed
+  for (int i = 0; i < 1000; i++) {
+    ioopm_hash_table_insert(ht, int_elem(i), int_elem(1));
+  }
+
+  for (int i = 0; i < 1000; i += 2) {
+    ioopm_hash_table_insert(ht, int_elem(i), int_elem(2));
+  }
+
+  for (int i = 0; i < 1000; i += 4) {
+    ioopm_hash_table_remove(ht, int_elem(i));
+  }
+
+  ioopm_list_t *ones = ioopm_hash_table_keys_for_value(ht, int_elem(1));
+  ioopm_list_t *twos = ioopm_hash_table_keys_for_value(ht, int_elem(2));
+
+  CU_ASSERT_EQUAL(ioopm_linked_list_size(ones), 500);
+  CU_ASSERT_EQUAL(ioopm_linked_list_size(twos), 250);
+  CU_ASSERT_TRUE(ioopm_linked_list_contains(twos, int_elem(2)));
+  CU_ASSERT_FALSE(ioopm_linked_list_contains(twos, int_elem(4)));
+
+  ioopm_linked_list_destroy(ones);
+  ioopm_linked_list_destroy(twos);
+
+  // A value is forgotten when its last key is gone
+  for (int i = 2; i < 1000; i += 4) {
+    ioopm_hash_table_remove(ht, int_elem(i));
+  }
+
+  CU_ASSERT_FALSE(ioopm_hash_table_has_value(ht, int_elem(2)));
+  CU_ASSERT_TRUE(ioopm_hash_table_has_value(ht, int_elem(1)));
+
+  ioopm_hash_table_destroy(ht);
+}
+
+bool value_is_odd(elem_t key, elem_t value, void *x) {
+  return value.integer % 2 != 0;
+}
+
+// Used to create unique string keys for the disk tests
+void test_hash_table_string_keys() {
+  char buf[64];
+  ioopm_hash_table_t *ht = ioopm_hash_table_create_string_keys(eq_elem_int, NULL);
+
+  // The keys are copied, so the buffer can be reused
+  strcpy(buf, "short");
+  ioopm_hash_table_insert(ht, ptr_elem(buf), int_elem(1));
+  strcpy(buf, "a key that is too long to be stored inline");
+  ioopm_hash_table_insert(ht, ptr_elem(buf), int_elem(2));
+  strcpy(buf, "exactly 23 characters!!");
+  ioopm_hash_table_insert(ht, ptr_elem(buf), int_elem(3));
+  strcpy(buf, "overwritten");
+
+  CU_ASSERT_EQUAL(ioopm_hash_table_size(ht), 3);
+  assert_lookup(ht, ptr_elem("short"), int_elem(1), false);
+  assert_lookup(ht, ptr_elem("a key that is too long to be stored inline"), int_elem(2), false);
+  assert_lookup(ht, ptr_elem("exactly 23 characters!!"), int_elem(3), false);
+  assert_lookup(ht, ptr_elem("overwritten"), int_elem(0), true);
+
+  // Replacing a value keeps the copy made by the first insertion
+  ioopm_hash_table_insert(ht, ptr_elem("short"), int_elem(10));
+  ioopm_list_t *keys = ioopm_hash_table_keys(ht);
+  CU_ASSERT_EQUAL(ioopm_linked_list_size(keys), 3);
+  CU_ASSERT_TRUE(ioopm_linked_list_contains(keys, ptr_elem("short")));
+  CU_ASSERT_FALSE(ioopm_linked_list_contains(keys, ptr_elem(buf)));
+  ioopm_linked_list_destroy(keys);
+
+  ioopm_hash_table_index_values(ht, NULL);
+  keys = ioopm_hash_table_keys_for_value(ht, int_elem(2));
+  CU_ASSERT_STRING_EQUAL(ioopm_linked_list_get(keys, 0).extra, "a key that is too long to be stored inline");
+  ioopm_linked_list_destroy(keys);
+
+  assert_elems_equal(ioopm_hash_table_remove(ht, ptr_elem("short")), int_elem(10));
+  ioopm_hash_table_clear(ht);
+  CU_ASSERT_TRUE(ioopm_hash_table_is_empty(ht));
+
+  for (int i = 0; i < 1000; i++) {
+    sprintf(buf, "%d: a key that is long enough to be allocated on its own", i);
+    ioopm_hash_table_insert(ht, ptr_elem(buf), int_elem(i));
+  }
+
+  assert_lookup(ht, ptr_elem("999: a key that is long enough to be allocated on its own"), int_elem(999), false);
+
+  // Removed long keys are freed right away, also by remove_if
+  for (int i = 0; i < 1000; i += 2) {
+    sprintf(buf, "%d: a key that is long enough to be allocated on its own", i);
+    ioopm_hash_table_remove(ht, ptr_elem(buf));
+  }
+
+  CU_ASSERT_EQUAL(ioopm_hash_table_remove_if(ht, value_is_odd, NULL, NULL), 500);
+  CU_ASSERT_TRUE(ioopm_hash_table_is_empty(ht));
+
+  ioopm_hash_table_insert(ht, ptr_elem("1: a key that is long enough to be allocated on its own"), int_elem(1));
+
+  // Destroying the table frees all keys
+  ioopm_hash_table_destroy(ht);
+}
+
+bool value_is_even(elem_t key, elem_t value, void *x) {
+  return value.integer % 2 == 0;
+}
+
+void count_removed(elem_t key, elem_t *value, void *x) {
+  (*(int*)x)++;
+}
+
+char *word_for_number(char *buf, int i) {
+  sprintf(buf, "word%d", i);
+  return buf;
+}
+
+void test_hash_table_remove_if() {
+  int removed_count = 0;
+  ioopm_hash_table_t *ht = ioopm_hash_table_create(eq_elem_int, eq_elem_int, NULL);
+
+  CU_ASSERT_EQUAL(ioopm_hash_table_remove_if(ht, value_is_even, &removed_count, count_removed), 0);
+
+  for (int i = 0; i < 1000; i++) {
+    ioopm_hash_table_insert(ht, int_elem(i), int_elem(i));
+  }
+
+  ioopm_hash_table_index_values(ht, NULL);
+
+  CU_ASSERT_EQUAL(ioopm_hash_table_remove_if(ht, value_is_even, &removed_count, count_removed), 500);
+  CU_ASSERT_EQUAL(removed_count, 500);
+  CU_ASSERT_EQUAL(ioopm_hash_table_size(ht), 500);
+  CU_ASSERT_FALSE(ioopm_hash_table_any(ht, value_is_even, NULL));
+  CU_ASSERT_FALSE(ioopm_hash_table_has_value(ht, int_elem(2)));
+  CU_ASSERT_TRUE(ioopm_hash_table_has_value(ht, int_elem(3)));
+  assert_lookup(ht, int_elem(999), int_elem(999), false);
+
+  // Nothing matches the second time, and on_removed may be NULL
+  CU_ASSERT_EQUAL(ioopm_hash_table_remove_if(ht, value_is_even, NULL, NULL), 0);
+
+  ioopm_hash_table_destroy(ht);
+}
+
+void test_hash_table_remove_if_storages() {
+  char *path = "remove_if_test.db";
+  ioopm_hash_table_t *tables[3];
+
+  unlink(path);
+  tables[0] = ioopm_hash_table_create_compact(eq_elem_int, eq_elem_int, NULL, true);
+  tables[1] = ioopm_hash_table_open(path, eq_elem_int, eq_elem_int, NULL, false, 8);
+  tables[2] = ioopm_hash_table_create_string_keys(eq_elem_int, NULL);
+
+  for (int t = 0; t < 3; t++) {
+    char buf[32];
+    ioopm_hash_table_t *ht = tables[t];
+
+    for (int i = 0; i < 3000; i++) {
+      elem_t key = t == 2 ? ptr_elem(word_for_number(buf, i)) : int_elem(i);
+      ioopm_hash_table_insert(ht, key, int_elem(i));
+    }
+
+    CU_ASSERT_EQUAL(ioopm_hash_table_remove_if(ht, value_is_even, NULL, NULL), 1500);
+    CU_ASSERT_EQUAL(ioopm_hash_table_size(ht), 1500);
+    CU_ASSERT_FALSE(ioopm_hash_table_any(ht, value_is_even, NULL));
+
+    // Removed entries can be inserted again
+    elem_t key = t == 2 ? ptr_elem("word0") : int_elem(0);
+    ioopm_hash_table_insert(ht, key, int_elem(1));
+    assert_lookup(ht, key, int_elem(1), false);
+    CU_ASSERT_EQUAL(ioopm_hash_table_size(ht), 1501);
+
+    ioopm_hash_table_destroy(ht);
+  }
+
+  unlink(path);
+}
+
+void test_hash_table_try_lookup_and_remove() {
+  ioopm_hash_table_t *tables[2];
+  elem_t value = int_elem(-1);
+
+  tables[0] = ioopm_hash_table_create(eq_elem_int, eq_elem_int, NULL);
+  tables[1] = ioopm_hash_table_create_compact(eq_elem_int, eq_elem_int, NULL, false);
+
+  for (int t = 0; t < 2; t++) {
+    ioopm_hash_table_t *ht = tables[t];
+
+    ioopm_hash_table_insert(ht, int_elem(5), int_elem(50));
+
+    // errno is left as it is, whether the key exists or not
+    errno = EINVAL;
+    CU_ASSERT_TRUE(ioopm_hash_table_try_lookup(ht, int_elem(5), &value));
+    CU_ASSERT_EQUAL(value.integer, 50);
+    CU_ASSERT_TRUE(HAS_ERROR());
+
+    errno = 0;
+    CU_ASSERT_FALSE(ioopm_hash_table_try_lookup(ht, int_elem(6), &value));
+    CU_ASSERT_EQUAL(value.integer, 50);
+    CU_ASSERT_FALSE(HAS_ERROR());
+
+    CU_ASSERT_FALSE(ioopm_hash_table_try_remove(ht, int_elem(6), &value));
+    CU_ASSERT_EQUAL(ioopm_hash_table_size(ht), 1);
+
+    value = int_elem(-1);
+    CU_ASSERT_TRUE(ioopm_hash_table_try_remove(ht, int_elem(5), &value));
+    CU_ASSERT_EQUAL(value.integer, 50);
+    CU_ASSERT_FALSE(HAS_ERROR());
+    CU_ASSERT_TRUE(ioopm_hash_table_is_empty(ht));
+    CU_ASSERT_FALSE(ioopm_hash_table_try_lookup(ht, int_elem(5), &value));
+
+    ioopm_hash_table_destroy(ht);
+  }
+}
+
+void test_hash_table_alloc_policy() {
+  ioopm_alloc_policy_t policies[] = {
+    { .pages = IOOPM_PAGES_TRANSPARENT, .numa = IOOPM_NUMA_DEFAULT },
+    { .pages = IOOPM_PAGES_HUGETLB, .numa = IOOPM_NUMA_INTERLEAVE },
+    { .pages = IOOPM_PAGES_DEFAULT, .numa = IOOPM_NUMA_BIND, .node = 0 },
+  };
+
+  for (int p = 0; p < 3; p++) {
+    // Large enough for the buckets to be mapped with the policy, and resized once
+    ioopm_hash_table_t *ht = ioopm_hash_table_create_custom(eq_elem_int, eq_elem_int, NULL, 0.75, 100000, &policies[p]);
+    ioopm_hash_table_index_values(ht, NULL);
+
+    for (int i = 0; i < 100000; i++) {
+      ioopm_hash_table_insert(ht, int_elem(i), int_elem(i * 2));
+    }
+
+    CU_ASSERT_EQUAL(ioopm_hash_table_size(ht), 100000);
+    CU_ASSERT_EQUAL(ioopm_hash_table_lookup(ht, int_elem(99999)).integer, 199998);
+    CU_ASSERT_FALSE(HAS_ERROR());
+    ioopm_hash_table_lookup(ht, int_elem(100000));
+    CU_ASSERT_TRUE(HAS_ERROR());
+    CU_ASSERT_TRUE(ioopm_hash_table_has_value(ht, int_elem(1000)));
+
+    ioopm_hash_table_destroy(ht);
+  }
+}
+
+int highest_value_first(elem_t key_a, elem_t value_a, elem_t key_b, elem_t value_b) {
+  return value_b.integer - value_a.integer;
+}
+
+void test_hash_table_top_k() {
+  char *path = "top_k_test.db";
+  ioopm_hash_table_t *tables[2];
+
+  unlink(path);
+  tables[0] = ioopm_hash_table_create(eq_elem_int, eq_elem_int, NULL);
+  tables[1] = ioopm_hash_table_open(path, eq_elem_string, eq_elem_int, string_knr_hash, true, 8);
+
+  for (int t = 0; t < 2; t++) {
+    char buf[32];
+    ioopm_hash_table_t *ht = tables[t];
+
+    // The values are a permutation of 0..999, so that the best entries are spread over the buckets
+    for (int i = 0; i < 1000; i++) {
+      elem_t key = t == 1 ? ptr_elem(word_for_number(buf, i)) : int_elem(i);
+      ioopm_hash_table_insert(ht, key, int_elem((i * 7) % 1000));
+    }
+
+    ioopm_hash_table_entry_t *top = ioopm_hash_table_top_k(ht, 10, highest_value_first);
+
+    for (int i = 0; i < 10; i++) {
+      CU_ASSERT_EQUAL(top[i].value.integer, 999 - i);
+      CU_ASSERT_TRUE(eq_elem_int(ioopm_hash_table_lookup(ht, top[i].key), top[i].value));
+    }
+
+    free(top);
+
+    // Asking for more entries than there are returns all of them
+    top = ioopm_hash_table_top_k(ht, 5000, highest_value_first);
+    CU_ASSERT_EQUAL(top[0].value.integer, 999);
+    CU_ASSERT_EQUAL(top[999].value.integer, 0);
+    free(top);
+
+    free(ioopm_hash_table_top_k(ht, 0, highest_value_first));
+    ioopm_hash_table_destroy(ht);
+  }
+
+  unlink(path);
+}
+
+void test_hash_table_clone() {
+  ioopm_hash_table_t *ht = ioopm_hash_table_create(eq_elem_int, eq_elem_int, NULL);
+  ioopm_hash_table_index_values(ht, NULL);
+
+  for (int i = 0; i < 100; i++) {
+    ioopm_hash_table_insert(ht, int_elem(i), int_elem(i % 10));
+  }
+
+  ioopm_hash_table_t *clone = ioopm_hash_table_clone(ht);
+
+  CU_ASSERT_FALSE(HAS_ERROR());
+  CU_ASSERT_EQUAL(ioopm_hash_table_size(clone), 100);
+
+  // Changing the clone (including removing entries from the block and resizing) does not change the original
+  ioopm_hash_table_remove(clone, int_elem(5));
+  ioopm_hash_table_insert(clone, int_elem(6), int_elem(60));
+
+  for (int i = 100; i < 1000; i++) {
+    ioopm_hash_table_insert(clone, int_elem(i), int_elem(i % 10));
+  }
+
+  CU_ASSERT_EQUAL(ioopm_hash_table_size(clone), 999);
+  CU_ASSERT_FALSE(ioopm_hash_table_has_key(clone, int_elem(5)));
+  CU_ASSERT_EQUAL(ioopm_hash_table_lookup(clone, int_elem(6)).integer, 60);
+  CU_ASSERT_EQUAL(ioopm_hash_table_lookup(clone, int_elem(7)).integer, 7);
+  CU_ASSERT_TRUE(ioopm_hash_table_has_value(clone, int_elem(60)));
+
+  CU_ASSERT_EQUAL(ioopm_hash_table_size(ht), 100);
+  CU_ASSERT_EQUAL(ioopm_hash_table_lookup(ht, int_elem(6)).integer, 6);
+  CU_ASSERT_FALSE(ioopm_hash_table_has_value(ht, int_elem(60)));
+
+  ioopm_hash_table_clear(clone);
+  CU_ASSERT_TRUE(ioopm_hash_table_is_empty(clone));
+  ioopm_hash_table_insert(clone, int_elem(1), int_elem(1));
+
+  ioopm_hash_table_destroy(clone);
+  ioopm_hash_table_destroy(ht);
+}
+
+void test_hash_table_clone_string_keys() {
+  ioopm_hash_table_t *ht = ioopm_hash_table_create_string_keys(eq_elem_int, NULL);
+  char *long_key = "a key that is too long to be stored inline in its entry";
+  char buf[32];
+
+  for (int i = 0; i < 200; i++) {
+    ioopm_hash_table_insert(ht, ptr_elem(word_for_number(buf, i)), int_elem(i));
+  }
+
+  ioopm_hash_table_insert(ht, ptr_elem(long_key), int_elem(-1));
+
+  ioopm_hash_table_t *clone = ioopm_hash_table_clone(ht);
+
+  // The keys are copied, so they are still valid after the original is destroyed
+  ioopm_hash_table_destroy(ht);
+
+  CU_ASSERT_EQUAL(ioopm_hash_table_size(clone), 201);
+  CU_ASSERT_EQUAL(ioopm_hash_table_lookup(clone, ptr_elem("word123")).integer, 123);
+  CU_ASSERT_EQUAL(ioopm_hash_table_lookup(clone, ptr_elem(long_key)).integer, -1);
+
+  ioopm_list_t *keys = ioopm_hash_table_keys(clone);
+  CU_ASSERT_TRUE(ioopm_linked_list_contains(keys, ptr_elem("word0")));
+  ioopm_linked_list_destroy(keys);
+
+  ioopm_hash_table_destroy(clone);
+
+  // Compact and file-backed tables can not be cloned
+  ht = ioopm_hash_table_create_compact(eq_elem_int, eq_elem_int, NULL, false);
+  CU_ASSERT_PTR_NULL(ioopm_hash_table_clone(ht));
+  CU_ASSERT_TRUE(HAS_ERROR());
+  ioopm_hash_table_destroy(ht);
+}
+
+void test_hash_table_seeded() {
+  elem_t colliding[] = { ptr_elem("AaAa"), ptr_elem("AaBB"), ptr_elem("BBAa"), ptr_elem("BBBB") };
+
+  // The keys collide for string_knr_hash, but not for the seeded hash function
+  CU_ASSERT_EQUAL(string_knr_hash(colliding[0]), string_knr_hash(colliding[3]));
+  CU_ASSERT_NOT_EQUAL(string_sip_hash(colliding[0], 1), string_sip_hash(colliding[3], 1));
+
+  // The hash code depends on the seed
+  CU_ASSERT_NOT_EQUAL(string_sip_hash(colliding[0], 1), string_sip_hash(colliding[0], 2));
+  CU_ASSERT_EQUAL(string_sip_hash(ptr_elem(""), 1), string_sip_hash(ptr_elem(""), 1));
+
+  ioopm_hash_table_t *ht = ioopm_hash_table_create_seeded(eq_elem_string, eq_elem_int, string_sip_hash);
+
+  for (int i = 0; i < 4; i++) {
+    ioopm_hash_table_insert(ht, colliding[i], int_elem(i));
+  }
+
+  for (int i = 0; i < 4; i++) {
+    assert_lookup(ht, colliding[i], int_elem(i), false);
+  }
+
+  assert_elems_equal(ioopm_hash_table_remove(ht, colliding[1]), int_elem(1));
+  CU_ASSERT_EQUAL(ioopm_hash_table_size(ht), 3);
+
+  ioopm_hash_table_destroy(ht);
+}
+
+void test_disk_table_persists() {
+  char *path = "disk_table_test.db";
+  char buf[32];
+
+  unlink(path);
+
+  // A cache of 8 pages is much smaller than the table, which means that pages are evicted
+  ioopm_hash_table_t *ht = ioopm_hash_table_open(path, eq_elem_string, eq_elem_int, string_knr_hash, true, 8);
+  CU_ASSERT_PTR_NOT_NULL(ht);
+
+  for (int i = 0; i < 5000; i++) {
+    ioopm_hash_table_insert(ht, ptr_elem(word_for_number(buf, i)), int_elem(i));
+    CU_ASSERT_FALSE(HAS_ERROR());
+  }
+
+  // Replace some of the values
+  for (int i = 0; i < 5000; i += 10) {
+    ioopm_hash_table_insert(ht, ptr_elem(word_for_number(buf, i)), int_elem(-i));
+  }
+
+  CU_ASSERT_EQUAL(ioopm_hash_table_size(ht), 5000);
+  ioopm_hash_table_close(ht);
+
+  ht = ioopm_hash_table_open(path, eq_elem_string, eq_elem_int, string_knr_hash, true, 8);
+  CU_ASSERT_EQUAL(ioopm_hash_table_size(ht), 5000);
+
+  for (int i = 0; i < 5000; i++) {
+    elem_t value = ioopm_hash_table_lookup(ht, ptr_elem(word_for_number(buf, i)));
+    CU_ASSERT_FALSE(HAS_ERROR());
+    CU_ASSERT_EQUAL(value.integer, i % 10 == 0 ? -i : i);
+  }
+
+  ioopm_hash_table_lookup(ht, ptr_elem("missing"));
+  CU_ASSERT_TRUE(HAS_ERROR());
+
+  for (int i = 0; i < 5000; i += 2) {
+    ioopm_hash_table_remove(ht, ptr_elem(word_for_number(buf, i)));
+    CU_ASSERT_FALSE(HAS_ERROR());
+  }
+
+  ioopm_hash_table_remove(ht, ptr_elem("word0"));
+  CU_ASSERT_TRUE(HAS_ERROR());
+
+  // The keys stay valid after the pages they were read from are evicted
+  ioopm_list_t *keys = ioopm_hash_table_keys(ht);
+  CU_ASSERT_EQUAL(ioopm_linked_list_size(keys), 2500);
+  CU_ASSERT_TRUE(ioopm_linked_list_contains(keys, ptr_elem("word4999")));
+  CU_ASSERT_FALSE(ioopm_linked_list_contains(keys, ptr_elem("word4998")));
+  ioopm_linked_list_destroy(keys);
+
+  // The keys of the previous call are freed, so asking again does not use more memory
+  keys = ioopm_hash_table_keys(ht);
+  CU_ASSERT_TRUE(ioopm_linked_list_contains(keys, ptr_elem("word1")));
+  ioopm_linked_list_destroy(keys);
+
+  ioopm_hash_table_close(ht);
+  CU_ASSERT_FALSE(HAS_ERROR());
+
+  // Opening the file with another key type fails
+  CU_ASSERT_PTR_NULL(ioopm_hash_table_open(path, eq_elem_int, eq_elem_int, NULL, false, 8));
+
+  unlink(path);
+}
+
+void test_disk_table_int_keys() {
+  char *path = "disk_table_test.db";
+  elem_t new_value = int_elem(7);
+
+  unlink(path);
+
+  ioopm_hash_table_t *ht = ioopm_hash_table_open(path, eq_elem_int, eq_elem_int, NULL, false, 8);
+
+  CU_ASSERT_TRUE(ioopm_hash_table_is_empty(ht));
+
+  for (int i = 0; i < 1000; i++) {
+    ioopm_hash_table_insert(ht, int_elem(i), int_elem(i));
+  }
+
+  CU_ASSERT_TRUE(ioopm_hash_table_has_key(ht, int_elem(999)));
+  CU_ASSERT_FALSE(ioopm_hash_table_has_key(ht, int_elem(1000)));
+  CU_ASSERT_TRUE(ioopm_hash_table_has_value(ht, int_elem(500)));
+
+  ioopm_hash_table_apply_to_all(ht, change_all_values, &new_value);
+  CU_ASSERT_FALSE(ioopm_hash_table_has_value(ht, int_elem(500)));
+  CU_ASSERT_TRUE(eq_elem_int(ioopm_hash_table_lookup(ht, int_elem(500)), new_value));
+
+  ioopm_list_t *keys = ioopm_hash_table_keys_for_value(ht, new_value);
+  CU_ASSERT_EQUAL(ioopm_linked_list_size(keys), 1000);
+  ioopm_linked_list_destroy(keys);
+
+  ioopm_hash_table_index_values(ht, NULL);
+  CU_ASSERT_TRUE(HAS_ERROR());
+
+  ioopm_hash_table_clear(ht);
+  CU_ASSERT_TRUE(ioopm_hash_table_is_empty(ht));
+  CU_ASSERT_FALSE(ioopm_hash_table_has_key(ht, int_elem(1)));
+
+  ioopm_hash_table_insert(ht, int_elem(1), int_elem(2));
+  ioopm_hash_table_sync(ht);
+  CU_ASSERT_FALSE(HAS_ERROR());
+  CU_ASSERT_TRUE(ioopm_hash_table_has_key(ht, int_elem(1)));
+
+  ioopm_hash_table_close(ht);
+  CU_ASSERT_FALSE(HAS_ERROR());
+  unlink(path);
+}
+
+void test_wal_recovers_string_keys() {
+  char *path = "wal_test.db";
+  char *snapshot_path = "wal_test.db.snapshot";
+  char buf[32];
+
+  unlink(path);
+  unlink(snapshot_path);
+
+  ioopm_hash_table_t *ht = ioopm_hash_table_recover(path, eq_elem_string, eq_elem_int, string_knr_hash, true, 64);
+  CU_ASSERT_PTR_NOT_NULL(ht);
+  CU_ASSERT_TRUE(ioopm_hash_table_is_empty(ht));
+
+  // The table copies every key, so the same buffer can be used for all of them
+  for (int i = 0; i < 1000; i++) {
+    ioopm_hash_table_insert(ht, ptr_elem(word_for_number(buf, i)), int_elem(i));
+  }
+
+  for (int i = 0; i < 1000; i += 2) {
+    ioopm_hash_table_remove(ht, ptr_elem(word_for_number(buf, i)));
+  }
+
+  ioopm_hash_table_insert(ht, ptr_elem(word_for_number(buf, 1)), int_elem(-1));
+  ioopm_hash_table_close(ht);
+
+  ht = ioopm_hash_table_recover(path, eq_elem_string, eq_elem_int, string_knr_hash, true, 64);
+  CU_ASSERT_EQUAL(ioopm_hash_table_size(ht), 500);
+  assert_lookup(ht, ptr_elem("word0"), int_elem(0), true);
+  assert_lookup(ht, ptr_elem("word1"), int_elem(-1), false);
+  assert_lookup(ht, ptr_elem("word999"), int_elem(999), false);
+
+  // After a checkpoint the log only holds the operations made after it
+  ioopm_hash_table_checkpoint(ht);
+  CU_ASSERT_FALSE(HAS_ERROR());
+  ioopm_hash_table_remove(ht, ptr_elem("word3"));
+  ioopm_hash_table_insert(ht, ptr_elem(word_for_number(buf, 0)), int_elem(100));
+  ioopm_hash_table_close(ht);
+
+  // Simulate a crash in the middle of writing a record
+  FILE *f = fopen(path, "ab");
+  fwrite("I\0\0\0\7", 1, 5, f);
+  fclose(f);
+
+  ht = ioopm_hash_table_recover(path, eq_elem_string, eq_elem_int, string_knr_hash, true, 0);
+  CU_ASSERT_EQUAL(ioopm_hash_table_size(ht), 500);
+  assert_lookup(ht, ptr_elem("word0"), int_elem(100), false);
+  assert_lookup(ht, ptr_elem("word3"), int_elem(0), true);
+
+  // The torn record is discarded, so that new records can be read after recovering again
+  ioopm_hash_table_insert(ht, ptr_elem(word_for_number(buf, 2)), int_elem(2));
+  ioopm_hash_table_close(ht);
+
+  ht = ioopm_hash_table_recover(path, eq_elem_string, eq_elem_int, string_knr_hash, true, 0);
+  CU_ASSERT_EQUAL(ioopm_hash_table_size(ht), 501);
+  assert_lookup(ht, ptr_elem("word2"), int_elem(2), false);
+  ioopm_hash_table_close(ht);
+
+  // A log can not be opened with another key type
+  CU_ASSERT_PTR_NULL(ioopm_hash_table_recover(path, eq_elem_int, eq_elem_int, NULL, false, 0));
+
+  unlink(path);
+  unlink(snapshot_path);
+}
+
+void test_wal_logs_apply_and_clear() {
+  char *path = "wal_test.db";
+  char *snapshot_path = "wal_test.db.snapshot";
+  elem_t new_value = int_elem(7);
+
+  unlink(path);
+  unlink(snapshot_path);
+
+  // A table without a log can not be checkpointed
+  ioopm_hash_table_t *ht = ioopm_hash_table_create(eq_elem_int, eq_elem_int, NULL);
+  ioopm_hash_table_checkpoint(ht);
+  CU_ASSERT_TRUE(HAS_ERROR());
+  ioopm_hash_table_destroy(ht);
+
+  ht = ioopm_hash_table_recover(path, eq_elem_int, eq_elem_int, NULL, false, 1);
+
+  for (int i = 0; i < 100; i++) {
+    ioopm_hash_table_insert(ht, int_elem(i), int_elem(i));
+  }
+
+  ioopm_hash_table_checkpoint(ht);
+  ioopm_hash_table_clear(ht);
+  ioopm_hash_table_insert(ht, int_elem(1), int_elem(1));
+  ioopm_hash_table_insert(ht, int_elem(2), int_elem(2));
+  ioopm_hash_table_apply_to_all(ht, change_all_values, &new_value);
+  CU_ASSERT_FALSE(HAS_ERROR());
+  ioopm_hash_table_insert(ht, int_elem(4), int_elem(4));
+  CU_ASSERT_EQUAL(ioopm_hash_table_remove_if(ht, value_is_even, NULL, NULL), 1);
+  ioopm_hash_table_sync(ht);
+  CU_ASSERT_FALSE(HAS_ERROR());
+  ioopm_hash_table_close(ht);
+
+  ht = ioopm_hash_table_recover(path, eq_elem_int, eq_elem_int, NULL, false, 1);
+  CU_ASSERT_EQUAL(ioopm_hash_table_size(ht), 2);
+  assert_lookup(ht, int_elem(1), new_value, false);
+  assert_lookup(ht, int_elem(2), new_value, false);
+  assert_lookup(ht, int_elem(3), int_elem(0), true);
+  assert_lookup(ht, int_elem(4), int_elem(0), true);
+  ioopm_hash_table_close(ht);
+
+  unlink(path);
+  unlink(snapshot_path);
+}
+
+void test_compact_table() {
+  elem_t new_value = int_elem(-7);
+  ioopm_hash_table_t *ht = ioopm_hash_table_create_compact(eq_elem_int, eq_elem_int, NULL, true);
+
+  CU_ASSERT_TRUE(ioopm_hash_table_is_empty(ht));
+  assert_lookup(ht, int_elem(1), int_elem(0), true);
+
+  for (int i = 0; i < 10000; i++) {
+    ioopm_hash_table_insert(ht, int_elem(i), int_elem(-i));
+  }
+
+  CU_ASSERT_EQUAL(ioopm_hash_table_size(ht), 10000);
+  assert_lookup(ht, int_elem(9999), int_elem(-9999), false);
+
+  // Removed entries are reused by later insertions
+  for (int i = 0; i < 10000; i += 2) {
+    assert_elems_equal(ioopm_hash_table_remove(ht, int_elem(i)), int_elem(-i));
+  }
+
+  ioopm_hash_table_remove(ht, int_elem(0));
+  CU_ASSERT_TRUE(HAS_ERROR());
+
+  for (int i = 10000; i < 15000; i++) {
+    ioopm_hash_table_insert(ht, int_elem(i), int_elem(i));
+  }
+
+  CU_ASSERT_EQUAL(ioopm_hash_table_size(ht), 10000);
+  assert_lookup(ht, int_elem(2), int_elem(0), true);
+  assert_lookup(ht, int_elem(3), int_elem(-3), false);
+  assert_lookup(ht, int_elem(14999), int_elem(14999), false);
+
+  ioopm_hash_table_index_values(ht, NULL);
+  CU_ASSERT_FALSE(HAS_ERROR());
+  ioopm_hash_table_apply_to_all(ht, change_all_values, &new_value);
+  CU_ASSERT_FALSE(ioopm_hash_table_has_value(ht, int_elem(3)));
+  CU_ASSERT_TRUE(ioopm_hash_table_has_value(ht, new_value));
+
+  ioopm_list_t *keys = ioopm_hash_table_keys_for_value(ht, new_value);
+  CU_ASSERT_EQUAL(ioopm_linked_list_size(keys), 10000);
+  ioopm_linked_list_destroy(keys);
+
+  ioopm_hash_table_clear(ht);
+  CU_ASSERT_TRUE(ioopm_hash_table_is_empty(ht));
+  ioopm_hash_table_insert(ht, int_elem(5), int_elem(5));
+  assert_lookup(ht, int_elem(5), int_elem(5), false);
+
+  ioopm_hash_table_destroy(ht);
+}
+
+void test_compact_table_string_keys() {
+  ioopm_hash_table_t *ht = ioopm_hash_table_create_compact(eq_elem_string, eq_elem_string, string_knr_hash, false);
+
+  ioopm_hash_table_insert(ht, ptr_elem("a"), ptr_elem("first"));
+  ioopm_hash_table_insert(ht, ptr_elem("b"), ptr_elem("second"));
+  ioopm_hash_table_insert(ht, ptr_elem("a"), ptr_elem("third"));
+
+  // Values that are not small keep all of their bytes
+  CU_ASSERT_STRING_EQUAL(ioopm_hash_table_lookup(ht, ptr_elem("a")).extra, "third");
+  CU_ASSERT_TRUE(ioopm_hash_table_has_key(ht, ptr_elem("b")));
+  CU_ASSERT_TRUE(ioopm_hash_table_has_value(ht, ptr_elem("second")));
+
+  ioopm_list_t *keys = ioopm_hash_table_keys(ht);
+  ioopm_list_t *values = ioopm_hash_table_values(ht);
+  CU_ASSERT_EQUAL(ioopm_linked_list_size(keys), 2);
+  CU_ASSERT_TRUE(ioopm_linked_list_contains(values, ptr_elem("third")));
+  ioopm_linked_list_destroy(keys);
+  ioopm_linked_list_destroy(values);
+
+  ioopm_hash_table_destroy(ht);
+}
+
 int main() {
   CU_pSuite test_suite1 = NULL;
 
@@ -769,6 +1559,7 @@ int main() {
     (NULL == CU_add_test(test_suite1, "it returns an array of all values", test_hash_table_values)) ||
     (NULL == CU_add_test(test_suite1, "it returns an empty array of values when the hash table is empty", test_hash_table_values_empty)) ||
     (NULL == CU_add_test(test_suite1, "it returns an updated array of values after removing", test_hash_table_values_modified)) ||
+    (NULL == CU_add_test(test_suite1, "it returns the keys and values as vectors", test_hash_table_keys_vector)) ||
     (NULL == CU_add_test(test_suite1, "it returns true when searching for an entry with a valid key", test_hash_table_has_key)) ||
     (NULL == CU_add_test(test_suite1, "it returns true when searching for an entry with a valid string-key", test_hash_table_has_key_string)) ||
     (NULL == CU_add_test(test_suite1, "it returns false when searching for an entry with an invalid key", test_hash_table_has_key_invalid)) ||
@@ -782,7 +1573,26 @@ int main() {
     (NULL == CU_add_test(test_suite1, "it applies a function to all entries and updates the values", test_hash_table_apply_all)) ||
     (NULL == CU_add_test(test_suite1, "it can take in the hash function as an argument", test_hash_table_hash_function)) ||
     (NULL == CU_add_test(test_suite1, "it resizes and rehashes the hash table for a large amount of insertions", test_hash_table_resize_large)) ||
-    (NULL == CU_add_test(test_suite1, "it creates synced key and value arrays after resizing and rehashing", test_hash_table_resize_keyvalue_order))
+    (NULL == CU_add_test(test_suite1, "it creates synced key and value arrays after resizing and rehashing", test_hash_table_resize_keyvalue_order)) ||
+    (NULL == CU_add_test(test_suite1, "it keeps the value index up to date when modifying entries", test_hash_table_value_index)) ||
+    (NULL == CU_add_test(test_suite1, "it returns all keys for a value with and without an index", test_hash_table_keys_for_value)) ||
+    (NULL == CU_add_test(test_suite1, "it re-indexes values that are changed by apply_to_all", test_hash_table_value_index_apply_all)) ||
+    (NULL == CU_add_test(test_suite1, "it indexes many keys with the same value", test_hash_table_value_index_shared_values)) ||
+    (NULL == CU_add_test(test_suite1, "it copies string keys into the table and frees them", test_hash_table_string_keys)) ||
+    (NULL == CU_add_test(test_suite1, "it stores string keys in a file that can be reopened", test_disk_table_persists)) ||
+    (NULL == CU_add_test(test_suite1, "it supports the hash table functions when stored in a file", test_disk_table_int_keys)) ||
+    (NULL == CU_add_test(test_suite1, "it recovers a table from its snapshot and write-ahead log", test_wal_recovers_string_keys)) ||
+    (NULL == CU_add_test(test_suite1, "it logs values changed by apply_to_all and clearing", test_wal_logs_apply_and_clear)) ||
+    (NULL == CU_add_test(test_suite1, "it supports the hash table functions in compact mode", test_compact_table)) ||
+    (NULL == CU_add_test(test_suite1, "it keeps pointer values and string keys in compact mode", test_compact_table_string_keys)) ||
+    (NULL == CU_add_test(test_suite1, "it removes all entries matching a predicate in one pass", test_hash_table_remove_if)) ||
+    (NULL == CU_add_test(test_suite1, "it removes entries matching a predicate from every kind of storage", test_hash_table_remove_if_storages)) ||
+    (NULL == CU_add_test(test_suite1, "it hashes keys with a seed so that chosen keys do not collide", test_hash_table_seeded)) ||
+    (NULL == CU_add_test(test_suite1, "it looks up and removes keys without setting errno", test_hash_table_try_lookup_and_remove)) ||
+    (NULL == CU_add_test(test_suite1, "it allocates the buckets with huge pages and NUMA policies", test_hash_table_alloc_policy)) ||
+    (NULL == CU_add_test(test_suite1, "it finds the k first entries by a custom order", test_hash_table_top_k)) ||
+    (NULL == CU_add_test(test_suite1, "it clones a hash table into an independent copy", test_hash_table_clone)) ||
+    (NULL == CU_add_test(test_suite1, "it clones a hash table with owned string keys", test_hash_table_clone_string_keys))
    ) {
     CU_cleanup_registry();
     return CU_get_error();
@@ -0,0 +1,188 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "common.h"
+#include "intern.h"
+
+#define INITIAL_SLOTS 64
+#define INITIAL_STRINGS 64
+#define INITIAL_BYTES 1024
+#define GROWTH_FACTOR 2
+#define NO_ID 0
+
+//@brief a pool of interned strings.
+// The slots form an open addressing hash table (with linear probing) of ID + 1, where NO_ID is an empty slot.
+struct intern {
+  char *bytes;           // The interned strings, each followed by a NULL terminator.
+  size_t used_bytes;     // The amount of bytes used in bytes.
+  size_t byte_capacity;  // The size of bytes.
+  size_t *offsets;       // Where the string with each ID starts in bytes.
+  uint32_t *hashes;      // The hash code of the string with each ID.
+  size_t size;           // The amount of interned strings.
+  size_t capacity;       // The amount of IDs that fit in offsets and hashes.
+  uint32_t *slots;       // The hash table from strings to ID + 1.
+  size_t slot_count;     // The amount of slots (always a power of 2).
+};
+
+/// @brief Computes the same polynomial as string_knr_hash, and the length of the string
+static uint32_t hash_string(const char *string, size_t *length) {
+  uint32_t result = 0;
+  const char *c = string;
+
+  for (; *c != '\0'; c++) {
+    result = result * 31 + *c;
+  }
+
+  *length = c - string;
+
+  // Mix the bits, since the slot is taken from the lowest bits
+  result ^= result >> 16;
+  result *= 0x45d9f3b;
+  result ^= result >> 16;
+
+  return result;
+}
+
+/// @brief Gets the length of the string with an ID, from where the next string starts
+static size_t string_length(ioopm_intern_t *pool, uint32_t id) {
+  size_t end = id + 1 < pool->size ? pool->offsets[id + 1] : pool->used_bytes;
+  return end - pool->offsets[id] - 1;
+}
+
+/// @brief Finds the slot holding string, or the empty slot where it should be inserted
+static uint32_t *find_slot(ioopm_intern_t *pool, const char *string, size_t length, uint32_t hash) {
+  size_t mask = pool->slot_count - 1;
+
+  for (size_t i = hash & mask; ; i = (i + 1) & mask) {
+    uint32_t *slot = &pool->slots[i];
+
+    if (*slot == NO_ID) {
+      return slot;
+    }
+
+    uint32_t id = *slot - 1;
+
+    // Comparing the hash codes first avoids touching the bytes of most strings that are not equal,
+    // and comparing the lengths keeps memcmp from reading past the end of either string
+    if (pool->hashes[id] == hash
+        && string_length(pool, id) == length
+        && memcmp(pool->bytes + pool->offsets[id], string, length) == 0
+    ) {
+      return slot;
+    }
+  }
+}
+
+static void grow_slots(ioopm_intern_t *pool) {
+  free(pool->slots);
+
+  pool->slot_count *= GROWTH_FACTOR;
+  pool->slots = calloc(pool->slot_count, sizeof(uint32_t));
+
+  size_t mask = pool->slot_count - 1;
+
+  for (size_t id = 0; id < pool->size; id++) {
+    size_t i = pool->hashes[id] & mask;
+
+    while (pool->slots[i] != NO_ID) {
+      i = (i + 1) & mask;
+    }
+
+    pool->slots[i] = id + 1;
+  }
+}
+
+ioopm_intern_t *ioopm_intern_create() {
+  ioopm_intern_t *pool = calloc(1, sizeof(ioopm_intern_t));
+
+  *pool = (ioopm_intern_t){
+    .bytes = malloc(INITIAL_BYTES),
+    .byte_capacity = INITIAL_BYTES,
+    .offsets = calloc(INITIAL_STRINGS, sizeof(size_t)),
+    .hashes = calloc(INITIAL_STRINGS, sizeof(uint32_t)),
+    .capacity = INITIAL_STRINGS,
+    .slots = calloc(INITIAL_SLOTS, sizeof(uint32_t)),
+    .slot_count = INITIAL_SLOTS,
+  };
+
+  return pool;
+}
+
+void ioopm_intern_destroy(ioopm_intern_t *pool) {
+  free(pool->bytes);
+  free(pool->offsets);
+  free(pool->hashes);
+  free(pool->slots);
+  free(pool);
+}
+
+uint32_t ioopm_intern(ioopm_intern_t *pool, const char *string) {
+  size_t length;
+  uint32_t hash = hash_string(string, &length);
+  uint32_t *slot = find_slot(pool, string, length, hash);
+
+  if (*slot != NO_ID) {
+    return *slot - 1;
+  }
+
+  // Copy the string to the end of the contiguous block
+  if (pool->byte_capacity - pool->used_bytes < length + 1) {
+    while (pool->byte_capacity - pool->used_bytes < length + 1) {
+      pool->byte_capacity *= GROWTH_FACTOR;
+    }
+
+    pool->bytes = realloc(pool->bytes, pool->byte_capacity);
+  }
+
+  if (pool->size == pool->capacity) {
+    pool->capacity *= GROWTH_FACTOR;
+    pool->offsets = realloc(pool->offsets, pool->capacity * sizeof(size_t));
+    pool->hashes = realloc(pool->hashes, pool->capacity * sizeof(uint32_t));
+  }
+
+  uint32_t id = pool->size++;
+
+  memcpy(pool->bytes + pool->used_bytes, string, length + 1);
+  pool->offsets[id] = pool->used_bytes;
+  pool->hashes[id] = hash;
+  pool->used_bytes += length + 1;
+  *slot = id + 1;
+
+  // Keep at most half of the slots in use, so that the probe sequences stay short
+  if (pool->size * 2 > pool->slot_count) {
+    grow_slots(pool);
+  }
+
+  return id;
+}
+
+uint32_t ioopm_intern_find(ioopm_intern_t *pool, const char *string) {
+  size_t length;
+  uint32_t hash = hash_string(string, &length);
+  uint32_t *slot = find_slot(pool, string, length, hash);
+
+  if (*slot == NO_ID) {
+    FAILURE();
+    return 0;
+  }
+
+  SUCCESS();
+  return *slot - 1;
+}
+
+const char *ioopm_intern_lookup(ioopm_intern_t *pool, uint32_t id) {
+  if (id >= pool->size) {
+    FAILURE();
+    return NULL;
+  }
+
+  SUCCESS();
+  return pool->bytes + pool->offsets[id];
+}
+
+size_t ioopm_intern_size(ioopm_intern_t *pool) {
+  return pool->size;
+}
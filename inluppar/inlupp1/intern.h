@@ -0,0 +1,52 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "common.h"
+
+/**
+ * @file intern.h
+ * @author Fredrik Engstrand, Alex Alstergren
+ * @date 19 October 2026
+ * @brief String interning pool mapping each distinct string to a dense integer ID.
+ *
+ * The first string interned gets ID 0, the next distinct string ID 1, and so on.
+ * Since equal strings always get the same ID, the IDs can be used as integer keys in a
+ * hash table (with eq_elem_int and the default hash function) instead of the strings.
+ * The strings are copied into one contiguous block of memory owned by the pool.
+ */
+
+typedef struct intern ioopm_intern_t;
+
+/// @brief Create a new empty interning pool
+/// @return A new empty pool
+ioopm_intern_t *ioopm_intern_create();
+
+/// @brief Tear down the pool, including all interned strings
+/// @param pool the pool to be destroyed
+void ioopm_intern_destroy(ioopm_intern_t *pool);
+
+/// @brief Get the ID of a string, interning it if it has not been interned before
+/// @param pool the pool operated upon
+/// @param string a NULL terminated string, which is copied into the pool
+/// @return the ID of the string (a pool holds at most 2^32 - 1 strings)
+uint32_t ioopm_intern(ioopm_intern_t *pool, const char *string);
+
+/// @brief Get the ID of a string without interning it
+/// @param pool the pool operated upon
+/// @param string a NULL terminated string
+/// @return the ID of the string, or sets errno to EINVAL if the string has not been interned
+uint32_t ioopm_intern_find(ioopm_intern_t *pool, const char *string);
+
+/// @brief Get the string for an ID
+/// The string is only valid until the next string is interned, since the pool may move its memory.
+/// @param pool the pool operated upon
+/// @param id the ID of an interned string
+/// @return the string, or NULL and sets errno to EINVAL if there is no string with the ID
+const char *ioopm_intern_lookup(ioopm_intern_t *pool, uint32_t id);
+
+/// @brief Get the amount of distinct strings in the pool
+/// @param pool the pool operated upon
+/// @return the amount of interned strings, which is also the next ID to be handed out
+size_t ioopm_intern_size(ioopm_intern_t *pool);
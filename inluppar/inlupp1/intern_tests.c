@@ -0,0 +1,132 @@
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <CUnit/Basic.h>
+
+#include "common.h"
+#include "intern.h"
+#include "hash_table.h"
+
+int init_suite(void) {
+  return 0;
+}
+
+int clean_suite(void) {
+  return 0;
+}
+
+void test_create_destroy() {
+  ioopm_intern_t *pool = ioopm_intern_create();
+
+  CU_ASSERT_PTR_NOT_NULL(pool);
+  CU_ASSERT_EQUAL(ioopm_intern_size(pool), 0);
+
+  ioopm_intern_destroy(pool);
+}
+
+void test_intern_same_id() {
+  ioopm_intern_t *pool = ioopm_intern_create();
+  char buf[16];
+
+  CU_ASSERT_EQUAL(ioopm_intern(pool, "hello"), 0);
+  CU_ASSERT_EQUAL(ioopm_intern(pool, "world"), 1);
+  CU_ASSERT_EQUAL(ioopm_intern(pool, ""), 2);
+
+  // The string is copied, so an equal string in another buffer gets the same ID
+  strcpy(buf, "hello");
+  CU_ASSERT_EQUAL(ioopm_intern(pool, buf), 0);
+  CU_ASSERT_EQUAL(ioopm_intern(pool, ""), 2);
+  CU_ASSERT_EQUAL(ioopm_intern_size(pool), 3);
+
+  ioopm_intern_destroy(pool);
+}
+
+void test_intern_find_lookup() {
+  ioopm_intern_t *pool = ioopm_intern_create();
+
+  ioopm_intern(pool, "hello");
+
+  CU_ASSERT_EQUAL(ioopm_intern_find(pool, "hello"), 0);
+  CU_ASSERT_FALSE(HAS_ERROR());
+  ioopm_intern_find(pool, "world");
+  CU_ASSERT_TRUE(HAS_ERROR());
+  CU_ASSERT_EQUAL(ioopm_intern_size(pool), 1);
+
+  CU_ASSERT_STRING_EQUAL(ioopm_intern_lookup(pool, 0), "hello");
+  CU_ASSERT_FALSE(HAS_ERROR());
+  CU_ASSERT_PTR_NULL(ioopm_intern_lookup(pool, 1));
+  CU_ASSERT_TRUE(HAS_ERROR());
+
+  ioopm_intern_destroy(pool);
+}
+
+void test_intern_many() {
+  ioopm_intern_t *pool = ioopm_intern_create();
+  char buf[32];
+
+  // Enough strings to grow the slots and the memory for the strings several times
+  for (int i = 0; i < 20000; i++) {
+    sprintf(buf, "word%d", i);
+    CU_ASSERT_EQUAL(ioopm_intern(pool, buf), i);
+  }
+
+  for (int i = 0; i < 20000; i++) {
+    sprintf(buf, "word%d", i);
+    CU_ASSERT_EQUAL(ioopm_intern_find(pool, buf), i);
+    CU_ASSERT_STRING_EQUAL(ioopm_intern_lookup(pool, i), buf);
+  }
+
+  CU_ASSERT_EQUAL(ioopm_intern_size(pool), 20000);
+
+  ioopm_intern_destroy(pool);
+}
+
+void test_intern_as_keys() {
+  ioopm_intern_t *pool = ioopm_intern_create();
+  ioopm_hash_table_t *ht = ioopm_hash_table_create(eq_elem_int, eq_elem_int, NULL);
+  char *words[] = { "a", "b", "a", "c", "b", "a" };
+
+  // Count the words using their IDs as keys
+  for (int i = 0; i < 6; i++) {
+    elem_t key = uint_elem(ioopm_intern(pool, words[i]));
+    elem_t count = ioopm_hash_table_lookup(ht, key);
+    ioopm_hash_table_insert(ht, key, int_elem(HAS_ERROR() ? 1 : count.integer + 1));
+  }
+
+  CU_ASSERT_EQUAL(ioopm_hash_table_lookup(ht, uint_elem(ioopm_intern_find(pool, "a"))).integer, 3);
+  CU_ASSERT_EQUAL(ioopm_hash_table_lookup(ht, uint_elem(ioopm_intern_find(pool, "b"))).integer, 2);
+  CU_ASSERT_EQUAL(ioopm_hash_table_lookup(ht, uint_elem(ioopm_intern_find(pool, "c"))).integer, 1);
+
+  ioopm_hash_table_destroy(ht);
+  ioopm_intern_destroy(pool);
+}
+
+int main() {
+  CU_pSuite test_suite1 = NULL;
+
+  if (CUE_SUCCESS != CU_initialize_registry())
+    return CU_get_error();
+
+  test_suite1 = CU_add_suite("Intern", init_suite, clean_suite);
+  if (NULL == test_suite1) {
+    CU_cleanup_registry();
+    return CU_get_error();
+  }
+
+  if (
+    (NULL == CU_add_test(test_suite1, "it creates and returns a pointer to an empty pool", test_create_destroy)) ||
+    (NULL == CU_add_test(test_suite1, "it gives equal strings the same ID and new strings the next ID", test_intern_same_id)) ||
+    (NULL == CU_add_test(test_suite1, "it finds IDs and strings and gives an error for unknown ones", test_intern_find_lookup)) ||
+    (NULL == CU_add_test(test_suite1, "it keeps IDs and strings valid after growing", test_intern_many)) ||
+    (NULL == CU_add_test(test_suite1, "it can be used to get integer keys for a hash table", test_intern_as_keys))
+  ) {
+    CU_cleanup_registry();
+    return CU_get_error();
+  }
+
+  CU_basic_set_mode(CU_BRM_VERBOSE);  // Detaljerna utav testerna skrivs ut.
+  CU_basic_run_tests();               // Kör alla testen.
+  CU_cleanup_registry();              // Städar upp testerna (avallokerar minnen bland annat)
+  return CU_get_error();              // Returnerar alla fel som hänt
+}
@@ -1,8 +1,18 @@
+#pragma once
+
 #include <stdbool.h>
 #include "common.h"
 
 
-//typedef struct iter ioopm_list_iterator_t;
+//@brief an iterator that goes through a list, with the iterators current index.
+// The struct is defined here so that iterators can be placed on the stack (or inside other structs)
+// with ioopm_list_iterator_init. The fields should only be used through the functions below.
+struct iter {
+  size_t index;         // Which index the iterator's currently on.
+  struct link *current; // The link the iterator's currently on.
+  ioopm_list_t *list;   // The list the iterator's working on.
+  size_t position;      // The amount of elements stepped past (instead of current if the list has a backend).
+};
 
 /// @brief Checks if there are more elements to iterate over
 /// @param iter the iterator
@@ -14,12 +24,12 @@ bool ioopm_iterator_has_next(ioopm_list_iterator_t *iter);
 /// @return the next element or sets errno to EINVAL if there are no next element
 elem_t ioopm_iterator_next(ioopm_list_iterator_t *iter);
 
-/// @brief Remove the current element from the underlying list
+/// @brief Remove the current element from the underlying list (in O(1) time for a list of links)
 /// @param iter the iterator
 /// @return the removed element or sets errno to EINVAL if the linked list is empty
 elem_t ioopm_iterator_remove(ioopm_list_iterator_t *iter);
 
-/// @brief Insert a new element into the underlying list making the current element it's next
+/// @brief Insert a new element into the underlying list making the current element it's next (in O(1) time for a list of links)
 /// @param iter the iterator
 /// @param element the element to be inserted
 void ioopm_iterator_insert(ioopm_list_iterator_t *iter, elem_t element);
@@ -34,5 +44,6 @@ void ioopm_iterator_reset(ioopm_list_iterator_t *iter);
 elem_t ioopm_iterator_current(ioopm_list_iterator_t *iter);
 
 /// @brief Destroy the iterator and return its resources
+/// Only for iterators created with ioopm_list_iterator, not with ioopm_list_iterator_init.
 /// @param iter the iterator
 void ioopm_iterator_destroy(ioopm_list_iterator_t *iter);
@@ -2,34 +2,60 @@
 #include <stdlib.h>
 #include <errno.h>
 #include <stdbool.h>
+#include <string.h>
+#include <stdint.h>
 
 #include "linked_list.h"
 #include "common.h"
+#include "list_backend.h"
+#include "unrolled_list.h"
+#include "skip_list.h"
 
 typedef struct link link_t;
 
-//@brief the value within a list, with a pointer towards the next value.
+//@brief the value within a list, with pointers towards the next and previous values.
+// The previous pointer is free in terms of memory, since malloc rounds 16 bytes up to 24 anyway.
 struct link {
   elem_t value; //The value of a link.
   link_t *next; // The next link in the list (Possibly NULL)
+  link_t *prev; // The previous link in the list (the dummy for the first link, NULL for the dummy), see prev_of
 };
 
+#define BLOCK_SIZE 16384
+#define LINKS_PER_BLOCK ((BLOCK_SIZE - sizeof(link_block_t)) / sizeof(link_t))
+#define IN_BLOCK ((uintptr_t)1)
+
+//@brief links allocated together by ioopm_linked_list_append_array.
+// Blocks are aligned to BLOCK_SIZE, so that a link finds its block by rounding down its address.
+// The links of a block are marked by setting the lowest bit of their prev pointer (which is otherwise
+// always 0), since a link has no room for another field: 24 bytes is exactly what malloc hands out.
+// A list keeps its last block until it is full, so that small batches are carved from the same block.
+typedef struct link_block {
+  size_t live;     // The amount of links in the block that are not destroyed yet, plus 1 while a list carves from it.
+  size_t used;     // The amount of links carved from the block.
+  link_t links[];
+} link_block_t;
+
 //@brief a list, with a pointer on the dummy link, and the last link, the size of the list, and the equality function for the values.
 struct list {
   link_t *first;             // A dummy link in the first spot of the list.
   link_t *last;              // The last link in the list (possibly the dummy if empty)
   size_t size;               // The amount of links in the list.
   ioopm_eq_function eq_func; // Equality function to compare with te values within the list.
+  const list_backend_t *backend; // Alternative storage for the elements (NULL if the links are used).
+  void *storage;             // The state of the backend.
+  link_t *finger;            // The link of the last indexed access (NULL if not known).
+  size_t finger_index;       // The index of finger.
+  link_block_t *block;       // The block that append_array carves new links from (NULL if none).
 };
 
-//@brief an iterator that goes through a list, with the iterators current index.
-struct iter {
-  size_t index;      // Which index the iterator's currently on.
-  link_t *current;   // The link the iterator's currently on.
-  ioopm_list_t *list;// The list the iterator's working on.
-};
+//@brief the predicate and argument used when implementing all using any.
+typedef struct negated_predicate {
+  ioopm_char_predicate prop;
+  void *extra;
+} negated_predicate_t;
 
-static link_t *link_create(elem_t value, link_t *next) {
+static link_t *link_create(elem_t value, link_t *next, link_t *prev) {
   // Allocate memory for the new entry.
   link_t *result = calloc(1, sizeof(link_t));
 
@@ -37,26 +63,108 @@ static link_t *link_create(elem_t value, link_t *next) {
   *result = (link_t){
     .value = value,
     .next = next,
+    .prev = prev,
   };
 
   return result;
 }
 
+/// @brief Gets the previous link of a link, without the mark of links in a block
+static link_t *prev_of(link_t *link) {
+  return (link_t *)((uintptr_t)link->prev & ~IN_BLOCK);
+}
+
+/// @brief Sets the previous link of a link, keeping the mark of links in a block
+static void set_prev(link_t *link, link_t *prev) {
+  link->prev = (link_t *)((uintptr_t)prev | ((uintptr_t)link->prev & IN_BLOCK));
+}
+
+/// @brief Drops one reference to a block (a link or the list carving from it), freeing it after the last one
+static void block_release(link_block_t *block) {
+  // Lists split from one another may share a block, so the count is decremented atomically
+  if (__atomic_sub_fetch(&block->live, 1, __ATOMIC_ACQ_REL) == 0) {
+    free(block);
+  }
+}
+
 static void link_destroy(link_t *link) {
-  free(link);
+  if (((uintptr_t)link->prev & IN_BLOCK) == 0) {
+    free(link);
+    return;
+  }
+
+  block_release((link_block_t *)((uintptr_t)link & ~(uintptr_t)(BLOCK_SIZE - 1)));
+}
+
+/// @brief Allocates an empty block, referenced by the list that carves from it
+static link_block_t *block_create() {
+  link_block_t *block;
+
+  if (posix_memalign((void **)&block, BLOCK_SIZE, BLOCK_SIZE) != 0) {
+    abort();
+  }
+
+  block->live = 1;
+  block->used = 0;
+
+  return block;
+}
+
+/// @brief Carves linked links holding values from the unused part of a block, marked as being part of the block
+/// @param n the amount of links, at most LINKS_PER_BLOCK minus the links already used
+/// @return the first link, with prev set to NULL (the last link is the n-1:th after it)
+static link_t *block_carve(link_block_t *block, elem_t *values, size_t n) {
+  link_t *links = &block->links[block->used];
+
+  for (size_t i = 0; i < n; i++) {
+    links[i] = (link_t){
+      .value = values[i],
+      .next = i + 1 < n ? &links[i + 1] : NULL,
+      .prev = (link_t *)((uintptr_t)(i > 0 ? &links[i - 1] : NULL) | IN_BLOCK),
+    };
+  }
+
+  block->used += n;
+  __atomic_add_fetch(&block->live, n, __ATOMIC_RELAXED);
+
+  return links;
+}
+
+/// @brief Inserts a new link into the linked list
+/// @param list the list to insert a link into
+/// @param previous the link that the new link is inserted after (may be the dummy)
+/// @param value the value of the new link
+static void insert_link(ioopm_list_t *list, link_t *previous, elem_t value) {
+  link_t *new_link = link_create(value, previous->next, previous);
+
+  if (previous->next == NULL) {
+    list->last = new_link;
+  } else {
+    set_prev(previous->next, new_link);
+  }
+
+  previous->next = new_link;
+  list->size++;
 }
 
 /// @brief Removes a link from the linked list and deallocates the memory
 /// @param list the list to remove a link from
-/// @param previous the previous link to the link that should be removed (may not be NULL)
-/// @param remove the link to be removed (may not be NULL)
-static elem_t remove_link(ioopm_list_t *list, link_t *previous, link_t *remove) {
+/// @param remove the link to be removed (may not be NULL or the dummy)
+static elem_t remove_link(ioopm_list_t *list, link_t *remove) {
   // Save the value of the link that should be removed
   elem_t value = remove->value;
+  link_t *previous = prev_of(remove);
 
   // Update the previous next pointer to point to the element after
   // the removed element or NULL (if the removed element is the last)
   previous->next = remove->next;
+
+  if (remove->next == NULL) {
+    list->last = previous;
+  } else {
+    set_prev(remove->next, previous);
+  }
+
   list->size--;
 
   link_destroy(remove);
@@ -69,15 +177,44 @@ static bool is_valid_index(ioopm_list_t *list, size_t index) {
   return (index >= 0 && index < list->size);
 }
 
+/// @brief Forgets the link of the last indexed access if its index is changed by inserting or removing at index
+static void forget_finger(ioopm_list_t *list, size_t index) {
+  if (list->finger_index >= index) {
+    list->finger = NULL;
+  }
+}
+
+/// @brief Gets a link, starting from the link of the last indexed access if it is not after index
+/// This makes accessing the links with increasing indices O(1) per access instead of O(n).
+/// Links closer to the end than to the starting point are found by walking backwards from the last link.
 /// @param index the index to get from list (must be a valid index [0..n-1])
 static link_t *get_link_from_index(ioopm_list_t *list, size_t index) {
   link_t *previous = list->first->next;
+  size_t current = 0;
 
-  while (index != 0) {
+  if (list->finger != NULL && list->finger_index <= index) {
+    previous = list->finger;
+    current = list->finger_index;
+  }
+
+  if (list->size - 1 - index < index - current) {
+    previous = list->last;
+    current = list->size - 1;
+
+    while (current != index) {
+      previous = prev_of(previous);
+      current--;
+    }
+  }
+
+  while (current != index) {
     previous = previous->next;
-    index--;
+    current++;
   }
 
+  list->finger = previous;
+  list->finger_index = index;
+
   return previous;
 }
 
@@ -86,9 +223,14 @@ static bool value_equiv(elem_t value, void *x) {
   return data->eq_func(value, data->element);
 }
 
+static bool negated(elem_t value, void *x) {
+  negated_predicate_t *data = x;
+  return !data->prop(value, data->extra);
+}
+
 ioopm_list_t *ioopm_linked_list_create(ioopm_eq_function eq_func) {
   ioopm_list_t *result = calloc(1, sizeof(ioopm_list_t));
-  link_t *dummy = link_create(int_elem(0), NULL);
+  link_t *dummy = link_create(int_elem(0), NULL, NULL);
 
   // Create an empty hash table and assign to the allocated memory
   *result = (ioopm_list_t){
@@ -101,10 +243,41 @@ ioopm_list_t *ioopm_linked_list_create(ioopm_eq_function eq_func) {
   return result;
 }
 
+static ioopm_list_t *create_with_backend(ioopm_eq_function eq_func, const list_backend_t *backend, void *storage) {
+  ioopm_list_t *result = calloc(1, sizeof(ioopm_list_t));
+
+  *result = (ioopm_list_t){
+    .size = 0,
+    .eq_func = eq_func,
+    .backend = backend,
+    .storage = storage,
+  };
+
+  return result;
+}
+
+ioopm_list_t *ioopm_linked_list_create_unrolled(ioopm_eq_function eq_func) {
+  return create_with_backend(eq_func, &unrolled_list_backend, unrolled_list_create());
+}
+
+ioopm_list_t *ioopm_linked_list_create_skip(ioopm_eq_function eq_func) {
+  return create_with_backend(eq_func, &skip_list_backend, skip_list_create());
+}
+
 void ioopm_linked_list_destroy(ioopm_list_t *list) {
+  if (list->backend != NULL) {
+    list->backend->destroy(list->storage);
+    free(list);
+    return;
+  }
+
   // Deallocate all links
   ioopm_linked_list_clear(list);
 
+  if (list->block != NULL) {
+    block_release(list->block);
+  }
+
   // Deallocate dummy entry
   free(list->first);
 
@@ -112,27 +285,58 @@ void ioopm_linked_list_destroy(ioopm_list_t *list) {
 }
 
 void ioopm_linked_list_append(ioopm_list_t *list, elem_t value) {
-  link_t *new_link = link_create(value, NULL);
+  if (list->backend != NULL) {
+    list->backend->append(list->storage, value);
+    list->size++;
+    return;
+  }
 
   // No need to handle the case where the list is empty, since
-  // in that case first and last is the same (dummy entry) and updating
-  // one of them will ultimately update both
-  list->last->next  = new_link;
-  list->last = new_link;
+  // in that case first and last is the same (dummy entry)
+  insert_link(list, list->last, value);
+}
 
-  list->size++;
+void ioopm_linked_list_append_array(ioopm_list_t *list, elem_t *values, size_t n) {
+  if (list->backend != NULL) {
+    list->backend->append_array(list->storage, values, n);
+    list->size += n;
+    return;
+  }
+
+  // Appending does not move any link, so the finger stays valid
+  while (n > 0) {
+    if (list->block == NULL) {
+      list->block = block_create();
+    }
+
+    size_t space = LINKS_PER_BLOCK - list->block->used;
+    size_t count = n < space ? n : space;
+    link_t *first = block_carve(list->block, values, count);
+
+    // A full block is left to its links
+    if (list->block->used == LINKS_PER_BLOCK) {
+      block_release(list->block);
+      list->block = NULL;
+    }
+
+    list->last->next = first;
+    set_prev(first, list->last);
+    list->last = &first[count - 1];
+    list->size += count;
+    values += count;
+    n -= count;
+  }
 }
 
 void ioopm_linked_list_prepend(ioopm_list_t *list, elem_t value) {
-  link_t *new_link = link_create(value, list->first->next);
-
-  // Make sure that we update the last pointer if the list is empty
-  if (list->size == 0) {
-    list->last = new_link;
+  if (list->backend != NULL) {
+    list->backend->prepend(list->storage, value);
+    list->size++;
+    return;
   }
 
-  list->first->next = new_link;
-  list->size++;
+  forget_finger(list, 0);
+  insert_link(list, list->first, value);
 }
 
 void ioopm_linked_list_insert(ioopm_list_t *list, size_t index, elem_t value) {
@@ -142,52 +346,63 @@ void ioopm_linked_list_insert(ioopm_list_t *list, size_t index, elem_t value) {
     return;
   }
 
-  if (index == list->size) {
+  if (list->backend != NULL) {
+    list->backend->insert(list->storage, index, value);
+    list->size++;
+  } else if (index == list->size) {
     ioopm_linked_list_append(list, value);
   } else if (index == 0 || list->size == 0) {
     ioopm_linked_list_prepend(list, value);
   } else {
     link_t *previous = get_link_from_index(list, index - 1);
 
-    // Insert new link at the chosen index
-    link_t *new_link = link_create(value, previous->next);
-    previous->next = new_link;
+    // The link before index keeps its index, so the finger stays valid
+    forget_finger(list, index);
 
-    list->size++;
+    // Insert new link at the chosen index
+    insert_link(list, previous, value);
   }
 
   SUCCESS();
 }
 
-elem_t ioopm_linked_list_remove(ioopm_list_t *list, size_t index) {
+bool ioopm_linked_list_try_remove(ioopm_list_t *list, size_t index, elem_t *out) {
   // Make sure that the index is in the range [0..n-1]
   // and that we have at least one element in the linked list
   if (!is_valid_index(list, index)){
-    FAILURE();
-    return int_elem(-1);
+    return false;
   }
 
-  elem_t removed_value;
-  link_t *previous;
-  link_t *dummy = list->first;
-
-  // We know that if this code runs, the size must be >= 1
-  // and therefore there must be at least one non-dummy entry
-  link_t *current = dummy->next;
+  if (list->backend != NULL) {
+    *out = list->backend->remove(list->storage, index);
+    list->size--;
+    return true;
+  }
 
-  // If the first index is specified, we simply remove that element
+  // If the first or last index is specified, we simply remove that element
   // directly, rather than going through the entire list
+  link_t *previous;
+
   if (index == 0) {
-    removed_value = remove_link(list, dummy, current);
+    previous = list->first;
+  } else if (index == list->size - 1) {
+    previous = prev_of(list->last);
   } else {
     previous = get_link_from_index(list, index - 1);
+  }
 
-    // Check if the last pointer in ioopm_list_t should be updated
-    if (index == list->size - 1) {
-      list->last = previous;
-    }
+  forget_finger(list, index);
+
+  *out = remove_link(list, previous->next);
+  return true;
+}
+
+elem_t ioopm_linked_list_remove(ioopm_list_t *list, size_t index) {
+  elem_t removed_value;
 
-    removed_value = remove_link(list, previous, previous->next);
+  if (!ioopm_linked_list_try_remove(list, index, &removed_value)) {
+    FAILURE();
+    return int_elem(-1);
   }
 
   SUCCESS();
@@ -203,6 +418,12 @@ bool ioopm_linked_list_is_empty(ioopm_list_t *list) {
 }
 
 void ioopm_linked_list_clear(ioopm_list_t *list) {
+  if (list->backend != NULL) {
+    list->backend->clear(list->storage);
+    list->size = 0;
+    return;
+  }
+
   link_t *first = list->first;
   link_t *link  = first->next;
   link_t *tmp;
@@ -215,6 +436,7 @@ void ioopm_linked_list_clear(ioopm_list_t *list) {
   }
 
   list->size = 0;
+  list->finger = NULL;
 
   // Set next of dummy node to NULL to avoid memory leaks
   first->next = NULL;
@@ -226,20 +448,39 @@ bool ioopm_linked_list_contains(ioopm_list_t *list, elem_t value) {
   return ioopm_linked_list_any(list, value_equiv, &data);
 }
 
+bool ioopm_linked_list_try_get(ioopm_list_t *list, size_t index, elem_t *out) {
+  if (!is_valid_index(list, index)) {
+    return false;
+  }
+
+  if (list->backend != NULL) {
+    *out = *list->backend->get(list->storage, index);
+    return true;
+  }
+
+  *out = get_link_from_index(list, index)->value;
+  return true;
+}
+
 elem_t ioopm_linked_list_get(ioopm_list_t *list, size_t index) {
+  elem_t value;
+
   //if the linked list doesn't have that index, set errno to EINVAL and return.
-  if (!is_valid_index(list, index)) {
+  if (!ioopm_linked_list_try_get(list, index, &value)) {
     FAILURE();
     return int_elem(-1);
   }
 
-  link_t *link = get_link_from_index(list, index);
-
   SUCCESS();
-  return link->value;
+  return value;
 }
 
 bool ioopm_linked_list_all(ioopm_list_t *list, ioopm_char_predicate prop, void *extra){
+  if (list->backend != NULL) {
+    negated_predicate_t data = { .prop = prop, .extra = extra };
+    return !list->backend->any(list->storage, negated, &data);
+  }
+
   link_t *link = list->first->next;
 
   //Loop through the linked list, applying the predicate on each element.
@@ -253,6 +494,10 @@ bool ioopm_linked_list_all(ioopm_list_t *list, ioopm_char_predicate prop, void *
 }
 
 bool ioopm_linked_list_any(ioopm_list_t *list, ioopm_char_predicate prop, void *extra){
+  if (list->backend != NULL) {
+    return list->backend->any(list->storage, prop, extra);
+  }
+
   link_t *link = list->first->next;
 
   while (link != NULL) {
@@ -265,6 +510,11 @@ bool ioopm_linked_list_any(ioopm_list_t *list, ioopm_char_predicate prop, void *
 }
 
 void ioopm_linked_apply_to_all(ioopm_list_t *list, ioopm_apply_char_function fun, void *extra){
+  if (list->backend != NULL) {
+    list->backend->apply_to_all(list->storage, fun, extra);
+    return;
+  }
+
   link_t *link = list->first->next;
 
   while(link != NULL){
@@ -273,15 +523,310 @@ void ioopm_linked_apply_to_all(ioopm_list_t *list, ioopm_apply_char_function fun
   }
 }
 
-ioopm_list_iterator_t *ioopm_list_iterator(ioopm_list_t *list) {
-  ioopm_list_iterator_t *result = calloc(1, sizeof(ioopm_list_iterator_t));
+/// @brief Merges the sorted halves [0..middle-1] and [middle..n-1] of values into merged
+static void merge_values(elem_t *values, size_t middle, size_t n, elem_t *merged, ioopm_compare_function cmp) {
+  size_t a = 0;
+  size_t b = middle;
+
+  for (size_t i = 0; i < n; i++) {
+    // Taking from the first half when equal keeps the sort stable
+    if (b == n || (a < middle && cmp(values[a], values[b]) <= 0)) {
+      merged[i] = values[a++];
+    } else {
+      merged[i] = values[b++];
+    }
+  }
+}
 
+/// @brief Sorts an array with a bottom-up merge sort, using a buffer of the same size
+static void sort_values(elem_t *values, size_t n, ioopm_compare_function cmp) {
+  elem_t *buffer = calloc(n, sizeof(elem_t));
+  elem_t *from = values;
+  elem_t *to = buffer;
+
+  for (size_t width = 1; width < n; width *= 2) {
+    for (size_t start = 0; start < n; start += 2 * width) {
+      size_t middle = start + width < n ? width : n - start;
+      size_t length = start + 2 * width < n ? 2 * width : n - start;
+
+      merge_values(&from[start], middle, length, &to[start], cmp);
+    }
+
+    elem_t *tmp = from;
+    from = to;
+    to = tmp;
+  }
+
+  if (from != values) {
+    memcpy(values, from, n * sizeof(elem_t));
+  }
+
+  free(buffer);
+}
+
+/// @brief Used in conjuction with apply_to_all to copy the elements of a list into an array
+static void copy_out(elem_t *value, void *x) {
+  elem_t **next = x;
+  *(*next)++ = *value;
+}
+
+void ioopm_linked_list_to_array(ioopm_list_t *list, elem_t *out) {
+  if (list->backend != NULL) {
+    list->backend->apply_to_all(list->storage, copy_out, &out);
+    return;
+  }
+
+  for (link_t *link = list->first->next; link != NULL; link = link->next) {
+    *out++ = link->value;
+  }
+}
+
+/// @brief Used in conjuction with apply_to_all to copy the elements of an array into a list
+static void copy_in(elem_t *value, void *x) {
+  elem_t **next = x;
+  *value = *(*next)++;
+}
+
+/// @brief Sorts the links of a list with a bottom-up merge sort on the next pointers
+/// Runs of width links are merged pairwise, doubling width until a single run is left.
+static void sort_links(ioopm_list_t *list, ioopm_compare_function cmp) {
+  link_t *head = list->first->next;
+  size_t merges;
+
+  for (size_t width = 1; ; width *= 2) {
+    link_t *run = head;
+    link_t *tail = NULL;
+    merges = 0;
+
+    while (run != NULL) {
+      link_t *other = run;
+      size_t run_size = 0;
+      size_t other_size = width;
+
+      merges++;
+
+      // The second run starts after (at most) width links
+      while (run_size < width && other != NULL) {
+        other = other->next;
+        run_size++;
+      }
+
+      while (run_size > 0 || (other_size > 0 && other != NULL)) {
+        link_t *next;
+
+        // Taking from the first run when equal keeps the sort stable
+        if (other_size == 0 || other == NULL || (run_size > 0 && cmp(run->value, other->value) <= 0)) {
+          next = run;
+          run = run->next;
+          run_size--;
+        } else {
+          next = other;
+          other = other->next;
+          other_size--;
+        }
+
+        if (tail == NULL) {
+          head = next;
+        } else {
+          tail->next = next;
+        }
+
+        tail = next;
+      }
+
+      run = other;
+    }
+
+    tail->next = NULL;
+
+    if (merges <= 1) {
+      break;
+    }
+  }
+
+  // Restore the prev pointers and the last link
+  link_t *previous = list->first;
+  previous->next = head;
+
+  for (link_t *link = head; link != NULL; link = link->next) {
+    set_prev(link, previous);
+    previous = link;
+  }
+
+  list->last = previous;
+}
+
+void ioopm_linked_list_sort(ioopm_list_t *list, ioopm_compare_function cmp) {
+  if (list->size < 2) {
+    return;
+  }
+
+  if (list->backend == NULL) {
+    sort_links(list, cmp);
+    list->finger = NULL;
+    return;
+  }
+
+  elem_t *values = calloc(list->size, sizeof(elem_t));
+  elem_t *next = values;
+
+  ioopm_linked_list_to_array(list, values);
+  sort_values(values, list->size, cmp);
+
+  list->backend->apply_to_all(list->storage, copy_in, &next);
+
+  free(values);
+}
+
+//@brief where the elements of another list are inserted, when they are not moved as links.
+typedef struct insertion {
+  ioopm_list_t *list;  // The list to insert into.
+  size_t index;        // The index of the next inserted element (if list has a backend).
+  link_t *previous;    // The link the next element is inserted after (if list has no backend).
+} insertion_t;
+
+/// @brief Used in conjuction with apply_to_all to insert the elements of one list into another
+static void insert_each(elem_t *value, void *x) {
+  insertion_t *insertion = x;
+
+  if (insertion->list->backend != NULL) {
+    ioopm_linked_list_insert(insertion->list, insertion->index++, *value);
+    return;
+  }
+
+  insert_link(insertion->list, insertion->previous, *value);
+  insertion->previous = insertion->previous->next;
+}
+
+/// @brief Moves all links of src after a link of list, leaving src empty
+/// @param previous the link of list that the links of src are placed after (may be the dummy)
+static void move_links(ioopm_list_t *list, link_t *previous, ioopm_list_t *src) {
+  link_t *first = src->first->next;
+  link_t *last = src->last;
+
+  last->next = previous->next;
+
+  if (previous->next == NULL) {
+    list->last = last;
+  } else {
+    set_prev(previous->next, last);
+  }
+
+  previous->next = first;
+  set_prev(first, previous);
+  list->size += src->size;
+
+  src->first->next = NULL;
+  src->last = src->first;
+  src->size = 0;
+  src->finger = NULL;
+}
+
+/// @brief Inserts the elements of src after previous (or at index if list has a backend), leaving src empty
+static void insert_all(ioopm_list_t *list, size_t index, link_t *previous, ioopm_list_t *src) {
+  if (list->backend == NULL && src->backend == NULL) {
+    move_links(list, previous, src);
+    return;
+  }
+
+  insertion_t insertion = { .list = list, .index = index, .previous = previous };
+
+  ioopm_linked_apply_to_all(src, insert_each, &insertion);
+  ioopm_linked_list_clear(src);
+}
+
+void ioopm_linked_list_concat(ioopm_list_t *dst, ioopm_list_t *src) {
+  if (src->size == 0) {
+    return;
+  }
+
+  // The finger of dst stays valid, since all elements are placed after it
+  insert_all(dst, dst->size, dst->last, src);
+}
+
+void ioopm_linked_list_splice_at(ioopm_list_iterator_t *iter, ioopm_list_t *src) {
+  ioopm_list_t *list = iter->list;
+
+  if (src->size == 0) {
+    return;
+  }
+
+  if (list->backend != NULL) {
+    insert_all(list, iter->index, NULL, src);
+
+    // The first inserted element becomes the current element
+    iter->position = iter->index;
+    return;
+  }
+
+  if (!ioopm_iterator_has_next(iter) && list->size > 0) {
+    // Like ioopm_iterator_insert, the elements are placed before the last element
+    iter->current = prev_of(iter->current);
+  }
+
+  forget_finger(list, iter->index);
+  insert_all(list, iter->index, iter->current, src);
+}
+
+ioopm_list_t *ioopm_linked_list_split_at(ioopm_list_t *list, size_t index) {
+  if (index > list->size) {
+    FAILURE();
+    return NULL;
+  }
+
+  SUCCESS();
+
+  if (list->backend != NULL) {
+    ioopm_list_t *rest = create_with_backend(list->eq_func, list->backend, list->backend->create());
+
+    list->backend->split(list->storage, index, rest->storage);
+    rest->size = list->size - index;
+    list->size = index;
+
+    return rest;
+  }
+
+  ioopm_list_t *rest = ioopm_linked_list_create(list->eq_func);
+
+  if (index == list->size) {
+    return rest;
+  }
+
+  link_t *previous = index == 0 ? list->first : get_link_from_index(list, index - 1);
+
+  rest->first->next = previous->next;
+  set_prev(previous->next, rest->first);
+  rest->last = list->last;
+  rest->size = list->size - index;
+
+  previous->next = NULL;
+  list->last = previous;
+  list->size = index;
+  forget_finger(list, index);
+
+  return rest;
+}
+
+/// @brief Updates the index of an iterator over a backend from its position
+/// Like with links, the current element is the next one, except at the end where it is the last one.
+static void update_index(ioopm_list_iterator_t *iter) {
+  size_t size = iter->list->size;
+  iter->index = iter->position < size || size == 0 ? iter->position : size - 1;
+}
+
+void ioopm_list_iterator_init(ioopm_list_iterator_t *iter, ioopm_list_t *list) {
   //Set the current pointer to dummy at start.
-  *result = (ioopm_list_iterator_t){
+  *iter = (ioopm_list_iterator_t){
     .index = 0,
     .current = list->first,
     .list = list,
   };
+}
+
+ioopm_list_iterator_t *ioopm_list_iterator(ioopm_list_t *list) {
+  ioopm_list_iterator_t *result = calloc(1, sizeof(ioopm_list_iterator_t));
+
+  ioopm_list_iterator_init(result, list);
 
   return result;
 }
@@ -292,6 +837,16 @@ elem_t ioopm_iterator_next(ioopm_list_iterator_t *iter) {
     return ptr_elem(NULL);
   }
 
+  if (iter->list->backend != NULL) {
+    elem_t value = *iter->list->backend->get(iter->list->storage, iter->position);
+
+    iter->position++;
+    update_index(iter);
+
+    SUCCESS();
+    return value;
+  }
+
   iter->current = iter->current->next;
 
   // Do not increase the index if we are now
@@ -305,6 +860,10 @@ elem_t ioopm_iterator_next(ioopm_list_iterator_t *iter) {
 }
 
 bool ioopm_iterator_has_next(ioopm_list_iterator_t *iter){
+  if (iter->list->backend != NULL) {
+    return iter->position < iter->list->size;
+  }
+
   return iter->current->next != NULL;
 }
 
@@ -313,20 +872,31 @@ void ioopm_iterator_destroy(ioopm_list_iterator_t *iter){
 }
 
 void ioopm_iterator_reset(ioopm_list_iterator_t *iter){
+  iter->position = 0;
   iter->current = iter->list->first;
   iter->index = 0;
 }
 
 void ioopm_iterator_insert(ioopm_list_iterator_t *iter, elem_t value) {
-  ioopm_linked_list_insert(iter->list, iter->index, value);
+  if (iter->list->backend != NULL) {
+    ioopm_linked_list_insert(iter->list, iter->index, value);
 
-  if (!ioopm_iterator_has_next(iter)) {
+    // The inserted element becomes the current element
+    iter->position = iter->index;
+    return;
+  }
+
+  if (!ioopm_iterator_has_next(iter) && iter->list->size > 0) {
     // If we were previously positioned at the last element, we will no longer
-    // be positioned at the last element after linserting. This means that
+    // be positioned at the last element after inserting. This means that
     // iter->current should point to the element previous to the newly inserted one.
-    // Therefore, we get the link using index-1 instead of just index.
-    iter->current = get_link_from_index(iter->list, iter->index - 1);
+    iter->current = prev_of(iter->current);
   }
+
+  // Insert right after the current link, without going through the list
+  forget_finger(iter->list, iter->index);
+  insert_link(iter->list, iter->current, value);
+  SUCCESS();
 }
 
 elem_t ioopm_iterator_current(ioopm_list_iterator_t *iter) {
@@ -337,6 +907,10 @@ elem_t ioopm_iterator_current(ioopm_list_iterator_t *iter) {
 
   SUCCESS();
 
+  if (iter->list->backend != NULL) {
+    return *iter->list->backend->get(iter->list->storage, iter->index);
+  }
+
   // Prevent segfault when positioned at the last element
   if (ioopm_iterator_has_next(iter)) {
     return iter->current->next->value;
@@ -346,16 +920,47 @@ elem_t ioopm_iterator_current(ioopm_list_iterator_t *iter) {
 }
 
 elem_t ioopm_iterator_remove(ioopm_list_iterator_t *iter) {
-  link_t *next = iter->current->next;
+  if (iter->list->backend != NULL) {
+    bool at_end = !ioopm_iterator_has_next(iter);
+    elem_t remove_value = ioopm_linked_list_remove(iter->list, iter->index);
 
-  // Delete the element at the current index
-  elem_t remove_value = ioopm_linked_list_remove(iter->list, iter->index);
+    // At the end, the iterator stays at the end (positioned at the new last element)
+    iter->position = at_end ? iter->list->size : iter->index;
+    update_index(iter);
 
-  // Check if we were at the last element before removing
-  if (next == NULL) {
-    iter->current = iter->list->last;
+    return remove_value;
+  }
+
+  if (iter->list->size == 0) {
+    FAILURE();
+    return int_elem(-1);
+  }
+
+  forget_finger(iter->list, iter->index);
+
+  // Delete the element at the current index, without going through the list
+  if (ioopm_iterator_has_next(iter)) {
+    elem_t remove_value = remove_link(iter->list, iter->current->next);
+
+    // If the last element was removed, we are now positioned at the new last element
+    if (!ioopm_iterator_has_next(iter) && iter->current != iter->list->first) {
+      iter->index--;
+    }
+
+    SUCCESS();
+    return remove_value;
+  }
+
+  // At the end, the current link is the last element itself
+  link_t *previous = prev_of(iter->current);
+  elem_t remove_value = remove_link(iter->list, iter->current);
+
+  iter->current = previous;
+
+  if (previous != iter->list->first) {
     iter->index--;
   }
 
+  SUCCESS();
   return remove_value;
 }
@@ -5,16 +5,37 @@
 
 typedef bool(*ioopm_char_predicate)(elem_t value, void *extra); 
 typedef void(*ioopm_apply_char_function)(elem_t *value, void *extra); 
+typedef int(*ioopm_compare_function)(elem_t a, elem_t b);
 
 /// @brief Creates a new list with 1 dummy-link.
 /// @return an empty linked list
 ioopm_list_t *ioopm_linked_list_create(ioopm_eq_function eq_func);
 
+/// @brief Creates a new unrolled list, which stores up to 13 elements in each node.
+/// All ioopm_linked_list_* and ioopm_iterator_* functions can be used on the list. Traversals
+/// (any, all, contains and apply_to_all) read the elements of each node from an array, and each
+/// element uses about 10 bytes instead of a link of its own. Reading the elements with get or an
+/// iterator in increasing order only walks the nodes once.
+/// @return an empty unrolled list
+ioopm_list_t *ioopm_linked_list_create_unrolled(ioopm_eq_function eq_func);
+
+/// @brief Creates a new skip list, where getting, inserting and removing at an index takes O(log n) time.
+/// All ioopm_linked_list_* and ioopm_iterator_* functions can be used on the list. Appending and
+/// prepending take O(1) expected time, and each element uses about 7 bytes more than in a list of links.
+/// @return an empty skip list
+ioopm_list_t *ioopm_linked_list_create_skip(ioopm_eq_function eq_func);
+
 /// @brief Create an iterator for a given list
 /// @param the list to be iterated over
 /// @return an iteration positioned at the start of list
 ioopm_list_iterator_t *ioopm_list_iterator(ioopm_list_t *list);
 
+/// @brief Initialize an iterator in place, e.g. on the stack, without allocating any memory
+/// The iterator does not need to be destroyed.
+/// @param iter the iterator to initialize
+/// @param list the list to be iterated over
+void ioopm_list_iterator_init(ioopm_list_iterator_t *iter, ioopm_list_t *list);
+
 /// @brief Tear down the linked list and return all its memory (but not the memory of the elements)
 /// @param list the list to be destroyed
 void ioopm_linked_list_destroy(ioopm_list_t *list);
@@ -24,6 +45,17 @@ void ioopm_linked_list_destroy(ioopm_list_t *list);
 /// @param value the value to be appended
 void ioopm_linked_list_append(ioopm_list_t *list, elem_t value);
 
+/// @brief Insert the elements of an array at the end of a linked list, in order
+/// A list of links carves its new links from blocks of about 16 KiB instead of allocating them one
+/// at a time. The list keeps carving from its last block in later calls until it is full, so small
+/// batches share a block. A block is returned when all its links are removed (and the list no longer
+/// carves from it), so removing a few of them keeps the memory of the rest of the block. An unrolled
+/// list copies the elements straight into its nodes.
+/// @param list the linked list that will be appended
+/// @param values the values to be appended
+/// @param n the amount of values
+void ioopm_linked_list_append_array(ioopm_list_t *list, elem_t *values, size_t n);
+
 /// @brief Insert at the front of a linked list in O(1) time
 /// @param list the linked list that will be prepended
 /// @param value the value to be appended
@@ -43,20 +75,42 @@ void ioopm_linked_list_insert(ioopm_list_t *list, size_t index, elem_t value);
 /// @brief Remove an element from a linked list in O(n) time.
 /// The valid values of index are [0,n-1] for a list of n elements,
 /// where 0 means the first element and n-1 means the last element.
+/// Removing the first or the last element takes O(1) time.
 /// @param list the linked list that will be extended
 /// @param index the position in the list
 /// @param value the value to be appended
 /// @return the value returned (*) or sets errno to EINVAL if index is invalid
 elem_t ioopm_linked_list_remove(ioopm_list_t *list, size_t index);
 
+/// @brief Remove an element from a linked list in O(n) time without touching errno.
+/// @param list the linked list
+/// @param index the position in the list
+/// @param out where the removed value is stored (left unchanged if index is invalid)
+/// @return true if an element was removed, false if index is invalid
+bool ioopm_linked_list_try_remove(ioopm_list_t *list, size_t index, elem_t *out);
+
 /// @brief Retrieve an element from a linked list in O(n) time.
 /// The valid values of index are [0,n-1] for a list of n elements,
 /// where 0 means the first element and n-1 means the last element.
+/// The list remembers the last accessed index, so getting the elements with increasing
+/// indices (e.g. for i in [0,n-1]) only takes O(1) time per element.
 /// @param list the linked list that will be extended
 /// @param index the position in the list
 /// @return the value at the given position or sets errno to EINVAL if index is invalid
 elem_t ioopm_linked_list_get(ioopm_list_t *list, size_t index);
 
+/// @brief Copy all elements of a linked list into an array, in order, with a single traversal
+/// @param list the linked list
+/// @param out the array, with room for at least ioopm_linked_list_size(list) elements
+void ioopm_linked_list_to_array(ioopm_list_t *list, elem_t *out);
+
+/// @brief Retrieve an element from a linked list in O(n) time without touching errno.
+/// @param list the linked list
+/// @param index the position in the list
+/// @param out where the value at the given position is stored (left unchanged if index is invalid)
+/// @return true if index is valid, else false
+bool ioopm_linked_list_try_get(ioopm_list_t *list, size_t index, elem_t *out);
+
 /// @brief Test if an element is in the list
 /// @param list the linked list
 /// @param value of the element sought
@@ -98,3 +152,36 @@ bool ioopm_linked_list_any(ioopm_list_t *list, ioopm_char_predicate prop, void *
 /// @param fun the function to be applied
 /// @param extra an additional argument (may be NULL) that will be passed to all internal calls of fun
 void ioopm_linked_apply_to_all(ioopm_list_t *list, ioopm_apply_char_function fun, void *extra);
+
+/// @brief Sort a list in O(n log n) time, keeping equal elements in the same order (stable).
+/// A list of links is sorted by relinking its links (with a bottom-up merge sort), without allocating
+/// any memory. Other lists are sorted through a temporary array of their elements.
+/// Iterators over the list are invalid after sorting, and have to be reset.
+/// @param list the linked list
+/// @param cmp returns a negative number if a should come before b, a positive number if b should come
+///        before a, and 0 if they are equal
+void ioopm_linked_list_sort(ioopm_list_t *list, ioopm_compare_function cmp);
+
+/// @brief Move all elements of one list to the end of another
+/// Between two lists of links this takes O(1) time, since the links themselves are moved. Otherwise
+/// the elements are inserted one at a time. Iterators over src are invalid afterwards.
+/// @param dst the list to be extended
+/// @param src the list whose elements are moved (left empty, but still has to be destroyed)
+void ioopm_linked_list_concat(ioopm_list_t *dst, ioopm_list_t *src);
+
+/// @brief Move all elements of a list into the underlying list of an iterator, before its current element
+/// Like ioopm_iterator_insert, the first moved element becomes the current element. Between two
+/// lists of links this takes O(1) time. Other iterators over either list are invalid afterwards.
+/// @param iter the iterator
+/// @param src the list whose elements are moved (left empty, but still has to be destroyed)
+void ioopm_linked_list_splice_at(ioopm_list_iterator_t *iter, ioopm_list_t *src);
+
+/// @brief Split a list in two, moving the elements from an index onwards into a new list
+/// For a list of links this takes O(1) time once the link before index is found (walking from
+/// the closest end). An unrolled list only splits the node holding index, and a skip list cuts
+/// each of its levels at index in O(log n) expected time, so no elements are moved one at a time.
+/// The new list is of the same kind as list and uses the same equality function.
+/// @param list the linked list, which keeps the elements before index
+/// @param index the position of the first moved element, in [0,n]
+/// @return a list of the elements at index and after, or NULL and sets errno to EINVAL if index is invalid
+ioopm_list_t *ioopm_linked_list_split_at(ioopm_list_t *list, size_t index);
@@ -75,6 +75,56 @@ void test_get_invalid() {
   ioopm_linked_list_destroy(list);
 }
 
+void test_try_get() {
+  ioopm_list_t *list = ioopm_linked_list_create(eq_elem_int);
+  elem_t value = int_elem(-1);
+
+  ioopm_linked_list_append(list, int_elem(420));
+  ioopm_linked_list_append(list, int_elem(1337));
+
+  // errno is left as it is, whether the index is valid or not
+  errno = EINVAL;
+  CU_ASSERT_TRUE(ioopm_linked_list_try_get(list, 1, &value));
+  assert_elem_int_equal(value, 1337);
+  CU_ASSERT_TRUE(HAS_ERROR());
+
+  errno = 0;
+  CU_ASSERT_FALSE(ioopm_linked_list_try_get(list, 2, &value));
+  CU_ASSERT_FALSE(ioopm_linked_list_try_get(list, -1, &value));
+  assert_elem_int_equal(value, 1337);
+  CU_ASSERT_FALSE(HAS_ERROR());
+
+  ioopm_linked_list_destroy(list);
+}
+
+void test_get_after_changes() {
+  ioopm_list_t *list = ioopm_linked_list_create(eq_elem_int);
+
+  for (int i = 0; i < 10; i++) {
+    ioopm_linked_list_append(list, int_elem(i));
+  }
+
+  // Remembers index 5, which is moved by changes at or before it but not after it
+  assert_link_index(list, int_elem(5), 5);
+  ioopm_linked_list_insert(list, 8, int_elem(80));
+  assert_link_index(list, int_elem(80), 8);
+  ioopm_linked_list_insert(list, 3, int_elem(30));
+  assert_link_index(list, int_elem(5), 6);
+  ioopm_linked_list_remove(list, 6);
+  assert_link_index(list, int_elem(6), 6);
+  ioopm_linked_list_remove(list, 7);
+  assert_link_index(list, int_elem(80), 7);
+  ioopm_linked_list_prepend(list, int_elem(-1));
+  assert_link_index(list, int_elem(80), 8);
+  assert_link_index(list, int_elem(-1), 0);
+
+  ioopm_linked_list_clear(list);
+  ioopm_linked_list_append(list, int_elem(1));
+  assert_link_index(list, int_elem(1), 0);
+
+  ioopm_linked_list_destroy(list);
+}
+
 void test_size_empty() {
   ioopm_list_t *list = ioopm_linked_list_create(eq_elem_int);
 
@@ -280,6 +330,33 @@ void test_remove_edges() {
   ioopm_linked_list_destroy(list);
 }
 
+void test_remove_both_ends() {
+  ioopm_list_t *list = ioopm_linked_list_create(eq_elem_int);
+
+  // Used as a work queue, taking elements from both ends
+  for (int i = 0; i < 10; i++) {
+    ioopm_linked_list_append(list, int_elem(i));
+  }
+
+  for (int i = 0; i < 5; i++) {
+    assert_elem_int_equal(ioopm_linked_list_remove(list, ioopm_linked_list_size(list) - 1), 9 - i);
+    assert_elem_int_equal(ioopm_linked_list_remove(list, 0), i);
+  }
+
+  CU_ASSERT_TRUE(ioopm_linked_list_is_empty(list));
+
+  // The first and last links are still correct after emptying the list
+  ioopm_linked_list_append(list, int_elem(1));
+  ioopm_linked_list_prepend(list, int_elem(0));
+  ioopm_linked_list_append(list, int_elem(2));
+  assert_link_index(list, int_elem(0), 0);
+  assert_link_index(list, int_elem(2), 2);
+  assert_elem_int_equal(ioopm_linked_list_remove(list, 2), 2);
+  assert_link_index(list, int_elem(1), 1);
+
+  ioopm_linked_list_destroy(list);
+}
+
 void test_remove_empty() {
   ioopm_list_t *list = ioopm_linked_list_create(eq_elem_int);
 
@@ -296,6 +373,28 @@ void test_remove_empty() {
   ioopm_linked_list_destroy(list);
 }
 
+void test_try_remove() {
+  ioopm_list_t *list = ioopm_linked_list_create(eq_elem_int);
+  elem_t value = int_elem(-1);
+
+  CU_ASSERT_FALSE(ioopm_linked_list_try_remove(list, 0, &value));
+
+  ioopm_linked_list_append(list, int_elem(1));
+  ioopm_linked_list_append(list, int_elem(2));
+
+  CU_ASSERT_TRUE(ioopm_linked_list_try_remove(list, 1, &value));
+  assert_elem_int_equal(value, 2);
+  CU_ASSERT_TRUE(ioopm_linked_list_try_remove(list, 0, &value));
+  assert_elem_int_equal(value, 1);
+  CU_ASSERT_TRUE(ioopm_linked_list_is_empty(list));
+
+  // The list can still be appended to after removing its only element
+  ioopm_linked_list_append(list, int_elem(3));
+  assert_elem_int_equal(ioopm_linked_list_get(list, 0), 3);
+
+  ioopm_linked_list_destroy(list);
+}
+
 void test_clear() {
   ioopm_list_t *list = ioopm_linked_list_create(eq_elem_int);
 
@@ -387,6 +486,346 @@ void test_clear_empty() {
 
 //////    TEST: ITERATOR
 
+/// @brief Checks that two lists hold the same elements, in the same order
+void assert_lists_equal(ioopm_list_t *list, ioopm_list_t *expected) {
+  CU_ASSERT_EQUAL(ioopm_linked_list_size(list), ioopm_linked_list_size(expected));
+
+  for (size_t i = 0; i < ioopm_linked_list_size(expected); i++) {
+    CU_ASSERT_EQUAL(ioopm_linked_list_get(list, i).integer, ioopm_linked_list_get(expected, i).integer);
+  }
+}
+
+/// @brief Checks that a list with a backend behaves like a list of links
+void assert_behaves_like_links(ioopm_list_t *list) {
+  ioopm_list_t *expected = ioopm_linked_list_create(eq_elem_int);
+
+  // Enough elements to use many nodes, with changes at the start, in the middle and at the end
+  for (int i = 0; i < 2000; i++) {
+    size_t index = (i * 7919) % (ioopm_linked_list_size(expected) + 1);
+
+    if (i % 3 == 0) {
+      ioopm_linked_list_prepend(list, int_elem(i));
+      ioopm_linked_list_prepend(expected, int_elem(i));
+    } else if (i % 3 == 1) {
+      ioopm_linked_list_append(list, int_elem(i));
+      ioopm_linked_list_append(expected, int_elem(i));
+    } else {
+      ioopm_linked_list_insert(list, index, int_elem(i));
+      ioopm_linked_list_insert(expected, index, int_elem(i));
+    }
+  }
+
+  assert_lists_equal(list, expected);
+
+  for (int i = 0; i < 1900; i++) {
+    size_t index = i % 4 == 0 ? ioopm_linked_list_size(expected) - 1 : (i * 7919) % ioopm_linked_list_size(expected);
+
+    CU_ASSERT_EQUAL(ioopm_linked_list_remove(list, index).integer, ioopm_linked_list_remove(expected, index).integer);
+  }
+
+  assert_lists_equal(list, expected);
+
+  // Append and prepend after the removes, and get the elements in order (continuing from the previous get)
+  for (int i = 0; i < 100; i++) {
+    ioopm_linked_list_append(list, int_elem(i));
+    ioopm_linked_list_append(expected, int_elem(i));
+    ioopm_linked_list_prepend(list, int_elem(-i));
+    ioopm_linked_list_prepend(expected, int_elem(-i));
+  }
+
+  assert_lists_equal(list, expected);
+
+  elem_t value = int_elem(5);
+  ioopm_linked_apply_to_all(list, update_value, &value);
+
+  CU_ASSERT_TRUE(ioopm_linked_list_all(list, value_equiv, &value));
+  CU_ASSERT_TRUE(ioopm_linked_list_contains(list, int_elem(5)));
+  CU_ASSERT_FALSE(ioopm_linked_list_contains(list, int_elem(6)));
+
+  // Invalid indices are handled like for a list of links
+  ioopm_linked_list_get(list, 1000);
+  CU_ASSERT_EQUAL(errno, EINVAL);
+
+  ioopm_linked_list_clear(list);
+  CU_ASSERT_TRUE(ioopm_linked_list_is_empty(list));
+
+  ioopm_linked_list_append(list, int_elem(1));
+  assert_link_index(list, int_elem(1), 0);
+
+  ioopm_linked_list_destroy(expected);
+  ioopm_linked_list_destroy(list);
+}
+
+void test_unrolled() {
+  assert_behaves_like_links(ioopm_linked_list_create_unrolled(eq_elem_int));
+
+  ioopm_list_t *list = ioopm_linked_list_create_unrolled(eq_elem_int);
+
+  for (int i = 0; i < 1000; i++) {
+    ioopm_linked_list_append(list, int_elem(i));
+  }
+
+  // Emptied nodes at the end are freed, and walking backwards reads every element
+  for (int i = 999; i >= 500; i--) {
+    assert_elem_int_equal(ioopm_linked_list_remove(list, i), i);
+    assert_elem_int_equal(ioopm_linked_list_get(list, i - 1), i - 1);
+  }
+
+  for (int i = 499; i >= 0; i--) {
+    assert_elem_int_equal(ioopm_linked_list_get(list, i), i);
+  }
+
+  // Emptied nodes at the start are freed as well
+  for (int i = 0; i < 499; i++) {
+    assert_elem_int_equal(ioopm_linked_list_remove(list, 0), i);
+  }
+
+  assert_elem_int_equal(ioopm_linked_list_remove(list, 0), 499);
+  CU_ASSERT_TRUE(ioopm_linked_list_is_empty(list));
+
+  ioopm_linked_list_append(list, int_elem(1));
+  ioopm_linked_list_prepend(list, int_elem(0));
+  assert_elem_int_equal(ioopm_linked_list_get(list, 1), 1);
+
+  ioopm_linked_list_destroy(list);
+}
+
+void test_skip() {
+  assert_behaves_like_links(ioopm_linked_list_create_skip(eq_elem_int));
+}
+
+/// @brief Compares the tens of two integers, so that e.g. 12 and 17 are equal
+int cmp_tens(elem_t a, elem_t b) {
+  return a.integer / 10 - b.integer / 10;
+}
+
+/// @brief Sorts a list of 1000 integers and checks that the result is sorted and stable
+void assert_sorts(ioopm_list_t *list) {
+  // Each ten occurs ten times, with the ones in increasing order
+  for (int i = 0; i < 1000; i++) {
+    ioopm_linked_list_append(list, int_elem((i * 7 % 100) * 10 + i / 100));
+  }
+
+  ioopm_linked_list_sort(list, cmp_tens);
+
+  CU_ASSERT_EQUAL(ioopm_linked_list_size(list), 1000);
+
+  for (int i = 0; i < 1000; i++) {
+    assert_link_index(list, int_elem(i), i);
+  }
+
+  // The list still works as usual at both ends
+  ioopm_linked_list_append(list, int_elem(1000));
+  ioopm_linked_list_prepend(list, int_elem(-1));
+  assert_link_index(list, int_elem(1000), 1001);
+  assert_elem_int_equal(ioopm_linked_list_remove(list, 1001), 1000);
+  assert_elem_int_equal(ioopm_linked_list_remove(list, 1000), 999);
+
+  ioopm_linked_list_destroy(list);
+}
+
+void test_sort() {
+  assert_sorts(ioopm_linked_list_create(eq_elem_int));
+  assert_sorts(ioopm_linked_list_create_unrolled(eq_elem_int));
+  assert_sorts(ioopm_linked_list_create_skip(eq_elem_int));
+}
+
+void test_sort_small() {
+  ioopm_list_t *list = ioopm_linked_list_create(eq_elem_int);
+
+  ioopm_linked_list_sort(list, cmp_tens);
+  CU_ASSERT_TRUE(ioopm_linked_list_is_empty(list));
+
+  ioopm_linked_list_append(list, int_elem(20));
+  ioopm_linked_list_sort(list, cmp_tens);
+  assert_link_index(list, int_elem(20), 0);
+
+  ioopm_linked_list_append(list, int_elem(10));
+  ioopm_linked_list_append(list, int_elem(30));
+  ioopm_linked_list_sort(list, cmp_tens);
+  assert_link_index(list, int_elem(10), 0);
+  assert_link_index(list, int_elem(20), 1);
+  assert_link_index(list, int_elem(30), 2);
+
+  ioopm_linked_list_destroy(list);
+}
+
+/// @brief The ways of creating a list, to test operations between lists of different kinds
+ioopm_list_t *(*list_creators[])(ioopm_eq_function) = {
+  ioopm_linked_list_create,
+  ioopm_linked_list_create_unrolled,
+  ioopm_linked_list_create_skip,
+};
+
+/// @brief Creates a list of a given kind with the integers [from..to-1]
+ioopm_list_t *create_range(size_t kind, int from, int to) {
+  ioopm_list_t *list = list_creators[kind](eq_elem_int);
+
+  for (int i = from; i < to; i++) {
+    ioopm_linked_list_append(list, int_elem(i));
+  }
+
+  return list;
+}
+
+/// @brief Checks that a list holds the integers [0..n-1] and still works as usual at both ends
+void assert_range(ioopm_list_t *list, int n) {
+  CU_ASSERT_EQUAL(ioopm_linked_list_size(list), n);
+
+  for (int i = 0; i < n; i++) {
+    assert_link_index(list, int_elem(i), i);
+  }
+
+  ioopm_linked_list_append(list, int_elem(n));
+  ioopm_linked_list_prepend(list, int_elem(-1));
+  assert_elem_int_equal(ioopm_linked_list_remove(list, n + 1), n);
+  assert_elem_int_equal(ioopm_linked_list_remove(list, 0), -1);
+}
+
+void test_concat() {
+  for (size_t a = 0; a < 3; a++) {
+    for (size_t b = 0; b < 3; b++) {
+      ioopm_list_t *dst = create_range(a, 0, 100);
+      ioopm_list_t *src = create_range(b, 100, 250);
+
+      ioopm_linked_list_concat(dst, src);
+
+      assert_range(dst, 250);
+      CU_ASSERT_TRUE(ioopm_linked_list_is_empty(src));
+
+      // Both lists can still be used, also with an empty list on either side
+      ioopm_linked_list_concat(dst, src);
+      ioopm_linked_list_concat(src, dst);
+      assert_range(src, 250);
+      CU_ASSERT_TRUE(ioopm_linked_list_is_empty(dst));
+
+      ioopm_linked_list_append(dst, int_elem(1));
+      assert_elem_int_equal(ioopm_linked_list_get(dst, 0), 1);
+
+      ioopm_linked_list_destroy(dst);
+      ioopm_linked_list_destroy(src);
+    }
+  }
+}
+
+void test_split_at() {
+  for (size_t kind = 0; kind < 3; kind++) {
+    ioopm_list_t *list = create_range(kind, 0, 200);
+
+    // Access an element after the split, so that lists of links have a finger there
+    ioopm_linked_list_get(list, 150);
+
+    ioopm_list_t *rest = ioopm_linked_list_split_at(list, 120);
+    CU_ASSERT_FALSE(HAS_ERROR());
+
+    assert_range(list, 120);
+    CU_ASSERT_EQUAL(ioopm_linked_list_size(rest), 80);
+    assert_link_index(rest, int_elem(120), 0);
+    assert_link_index(rest, int_elem(199), 79);
+
+    // Both halves can still be changed anywhere, since whole nodes are moved and the cut is fixed up
+    ioopm_linked_list_insert(rest, 40, int_elem(-1));
+    ioopm_linked_list_prepend(rest, int_elem(-2));
+    ioopm_linked_list_append(list, int_elem(-3));
+    assert_link_index(rest, int_elem(-1), 41);
+    assert_link_index(rest, int_elem(199), 81);
+    assert_elem_int_equal(ioopm_linked_list_remove(rest, 41), -1);
+    assert_elem_int_equal(ioopm_linked_list_remove(rest, 0), -2);
+    assert_elem_int_equal(ioopm_linked_list_remove(list, 120), -3);
+    assert_range(list, 120);
+
+    // Splitting at either end gives an empty list or moves all elements
+    ioopm_list_t *empty = ioopm_linked_list_split_at(list, 120);
+    ioopm_list_t *all = ioopm_linked_list_split_at(list, 0);
+
+    CU_ASSERT_TRUE(ioopm_linked_list_is_empty(empty));
+    CU_ASSERT_TRUE(ioopm_linked_list_is_empty(list));
+    assert_range(all, 120);
+
+    CU_ASSERT_PTR_NULL(ioopm_linked_list_split_at(list, 1));
+    CU_ASSERT_TRUE(HAS_ERROR());
+
+    // Splitting and concatenating again gives back the original list
+    ioopm_linked_list_concat(all, rest);
+    assert_range(all, 200);
+
+    ioopm_linked_list_destroy(list);
+    ioopm_linked_list_destroy(rest);
+    ioopm_linked_list_destroy(empty);
+    ioopm_linked_list_destroy(all);
+  }
+}
+
+void test_append_array() {
+  elem_t values[2000];
+
+  for (int i = 0; i < 2000; i++) {
+    values[i] = int_elem(i);
+  }
+
+  for (size_t kind = 0; kind < 3; kind++) {
+    ioopm_list_t *list = create_range(kind, 0, 10);
+
+    // Enough elements for a few blocks of links
+    ioopm_linked_list_append_array(list, &values[10], 1990);
+    ioopm_linked_list_append_array(list, values, 0);
+    assert_range(list, 2000);
+
+    // Links of a block can be removed one at a time, and moved to other lists
+    for (int i = 1999; i >= 1000; i -= 3) {
+      assert_elem_int_equal(ioopm_linked_list_remove(list, i), i);
+    }
+
+    ioopm_list_t *rest = ioopm_linked_list_split_at(list, 500);
+
+    CU_ASSERT_EQUAL(ioopm_linked_list_size(list) + ioopm_linked_list_size(rest), 1666);
+    assert_range(list, 500);
+
+    ioopm_linked_list_clear(list);
+    ioopm_linked_list_append_array(list, values, 3);
+    ioopm_linked_list_concat(rest, list);
+    assert_link_index(rest, int_elem(2), ioopm_linked_list_size(rest) - 1);
+
+    // Small batches are carved from the same block, which outlives its removed links while the list carves from it
+    ioopm_linked_list_clear(rest);
+
+    for (int i = 0; i < 2000; i++) {
+      ioopm_linked_list_append_array(rest, &values[i], 1);
+
+      if (i % 100 == 99) {
+        ioopm_linked_list_clear(rest);
+      }
+    }
+
+    ioopm_linked_list_append_array(rest, values, 2);
+    assert_range(rest, 2);
+
+    ioopm_linked_list_destroy(list);
+    ioopm_linked_list_destroy(rest);
+  }
+}
+
+void test_to_array() {
+  for (size_t kind = 0; kind < 3; kind++) {
+    ioopm_list_t *list = create_range(kind, 0, 1000);
+    elem_t values[1000];
+
+    ioopm_linked_list_to_array(list, values);
+
+    for (int i = 0; i < 1000; i++) {
+      assert_elem_int_equal(values[i], i);
+    }
+
+    // An empty list writes nothing
+    ioopm_linked_list_clear(list);
+    values[0] = int_elem(-1);
+    ioopm_linked_list_to_array(list, values);
+    assert_elem_int_equal(values[0], -1);
+
+    ioopm_linked_list_destroy(list);
+  }
+}
+
 void test_iterator_create_destroy() {
   ioopm_list_t *list = ioopm_linked_list_create(eq_elem_int);
   ioopm_list_iterator_t *iterator = ioopm_list_iterator(list);
@@ -611,6 +1050,31 @@ void test_iterator_remove_last() {
   ioopm_linked_list_destroy(list);
 }
 
+void test_iterator_remove_before_end() {
+  ioopm_list_t *list = ioopm_linked_list_create(eq_elem_int);
+
+  ioopm_linked_list_append(list, int_elem(20));
+  ioopm_linked_list_append(list, int_elem(200));
+
+  ioopm_list_iterator_t *iterator = ioopm_list_iterator(list);
+
+  // Remove the last element while positioned at it, but before stepping to the end
+  ioopm_iterator_next(iterator);
+  assert_elem_int_equal(ioopm_iterator_current(iterator), 200);
+  assert_elem_int_equal(ioopm_iterator_remove(iterator), 200);
+
+  // Now positioned at the new last element
+  CU_ASSERT_FALSE(ioopm_iterator_has_next(iterator));
+  assert_elem_int_equal(ioopm_iterator_current(iterator), 20);
+
+  ioopm_iterator_insert(iterator, int_elem(10));
+  assert_link_index(list, int_elem(10), 0);
+  assert_link_index(list, int_elem(20), 1);
+
+  ioopm_iterator_destroy(iterator);
+  ioopm_linked_list_destroy(list);
+}
+
 void test_iterator_insert_empty() {
   ioopm_list_t *list = ioopm_linked_list_create(eq_elem_int);
   ioopm_list_iterator_t *iterator = ioopm_list_iterator(list);
@@ -747,6 +1211,142 @@ void test_iterator_reset() {
   ioopm_linked_list_destroy(list);
 }
 
+void test_iterator_init() {
+  ioopm_list_t *list = ioopm_linked_list_create(eq_elem_int);
+  ioopm_list_iterator_t iterator;
+
+  for (int i = 0; i < 100; i++) {
+    ioopm_linked_list_append(list, int_elem(i));
+  }
+
+  // Double every element on the way, and remove the odd ones
+  ioopm_list_iterator_init(&iterator, list);
+
+  for (int i = 0; i < 100; i++) {
+    if (i % 2 == 1) {
+      assert_elem_int_equal(ioopm_iterator_remove(&iterator), i);
+      continue;
+    }
+
+    ioopm_iterator_insert(&iterator, int_elem(i));
+    ioopm_iterator_next(&iterator);
+    ioopm_iterator_next(&iterator);
+  }
+
+  CU_ASSERT_EQUAL(ioopm_linked_list_size(list), 100);
+
+  for (int i = 0; i < 100; i++) {
+    assert_link_index(list, int_elem(i / 2 * 2), i);
+  }
+
+  ioopm_iterator_reset(&iterator);
+  assert_elem_int_equal(ioopm_iterator_current(&iterator), 0);
+
+  ioopm_linked_list_destroy(list);
+}
+
+void test_splice_at() {
+  for (size_t a = 0; a < 3; a++) {
+    for (size_t b = 0; b < 3; b++) {
+      ioopm_list_t *list = create_range(a, 0, 10);
+      ioopm_list_t *middle = create_range(b, 10, 20);
+      ioopm_list_t *end = create_range(b, 20, 30);
+      ioopm_list_iterator_t iterator;
+
+      // Move 0..9 to the end, by splicing them in before 10..19 and 20..29
+      ioopm_list_t *start = ioopm_linked_list_split_at(list, 0);
+      ioopm_list_iterator_init(&iterator, list);
+
+      ioopm_linked_list_splice_at(&iterator, end);
+      assert_elem_int_equal(ioopm_iterator_current(&iterator), 20);
+
+      ioopm_linked_list_splice_at(&iterator, middle);
+      assert_elem_int_equal(ioopm_iterator_current(&iterator), 10);
+
+      // At the end, the elements are placed before the last element
+      while (ioopm_iterator_has_next(&iterator)) {
+        ioopm_iterator_next(&iterator);
+      }
+
+      ioopm_linked_list_splice_at(&iterator, start);
+      assert_elem_int_equal(ioopm_iterator_current(&iterator), 0);
+      assert_elem_int_equal(ioopm_iterator_next(&iterator), 0);
+      assert_elem_int_equal(ioopm_linked_list_remove(list, 29), 29);
+
+      // Splicing an empty list changes nothing
+      ioopm_linked_list_splice_at(&iterator, end);
+      assert_elem_int_equal(ioopm_iterator_current(&iterator), 1);
+
+      CU_ASSERT_EQUAL(ioopm_linked_list_size(list), 29);
+
+      for (int i = 0; i < 19; i++) {
+        assert_link_index(list, int_elem(10 + i), i);
+      }
+
+      for (int i = 0; i < 10; i++) {
+        assert_link_index(list, int_elem(i), 19 + i);
+      }
+
+      CU_ASSERT_TRUE(ioopm_linked_list_is_empty(middle));
+      CU_ASSERT_TRUE(ioopm_linked_list_is_empty(end));
+
+      ioopm_linked_list_destroy(list);
+      ioopm_linked_list_destroy(start);
+      ioopm_linked_list_destroy(middle);
+      ioopm_linked_list_destroy(end);
+    }
+  }
+}
+
+/// @brief Checks that an iterator over a list with a backend behaves like over a list of links
+void assert_iterator_behaves_like_links(ioopm_list_t *list) {
+  ioopm_list_iterator_t *iterator = ioopm_list_iterator(list);
+
+  ioopm_iterator_insert(iterator, int_elem(100));
+  assert_elem_int_equal(ioopm_iterator_current(iterator), 100);
+
+  for (int i = 1; i < 40; i++) {
+    ioopm_linked_list_append(list, int_elem(100 * (i + 1)));
+  }
+
+  // Step through all nodes, removing every other element
+  for (int i = 0; i < 20; i++) {
+    assert_elem_int_equal(ioopm_iterator_remove(iterator), 200 * i + 100);
+    assert_elem_int_equal(ioopm_iterator_next(iterator), 200 * i + 200);
+  }
+
+  CU_ASSERT_FALSE(ioopm_iterator_has_next(iterator));
+  CU_ASSERT_EQUAL(ioopm_linked_list_size(list), 20);
+
+  // At the end, the iterator is positioned at the last element like for a list of links
+  assert_elem_int_equal(ioopm_iterator_current(iterator), 4000);
+  ioopm_iterator_insert(iterator, int_elem(1));
+  assert_elem_int_equal(ioopm_iterator_current(iterator), 1);
+  assert_link_index(list, int_elem(4000), 20);
+
+  ioopm_iterator_reset(iterator);
+  assert_elem_int_equal(ioopm_iterator_current(iterator), 200);
+
+  while (ioopm_iterator_has_next(iterator)) {
+    ioopm_iterator_remove(iterator);
+  }
+
+  CU_ASSERT_TRUE(ioopm_linked_list_is_empty(list));
+  ioopm_iterator_current(iterator);
+  CU_ASSERT_EQUAL(errno, EINVAL);
+
+  ioopm_iterator_destroy(iterator);
+  ioopm_linked_list_destroy(list);
+}
+
+void test_iterator_unrolled() {
+  assert_iterator_behaves_like_links(ioopm_linked_list_create_unrolled(eq_elem_int));
+}
+
+void test_iterator_skip() {
+  assert_iterator_behaves_like_links(ioopm_linked_list_create_skip(eq_elem_int));
+}
+
 int main() {
   CU_pSuite test_suite1 = NULL;
   CU_pSuite test_suite2 = NULL;
@@ -773,6 +1373,8 @@ int main() {
     (NULL == CU_add_test(test_suite1, "it calculates the correct size after removing", test_size_remove)) ||
     (NULL == CU_add_test(test_suite1, "it returns the value of a link given a valid index", test_get)) ||
     (NULL == CU_add_test(test_suite1, "it returns an error when getting a link with an invalid index", test_get_invalid)) ||
+    (NULL == CU_add_test(test_suite1, "it gets a link without setting errno", test_try_get)) ||
+    (NULL == CU_add_test(test_suite1, "it gets the correct links after inserting and removing", test_get_after_changes)) ||
     (NULL == CU_add_test(test_suite1, "it appends links into the linked list", test_append)) ||
     (NULL == CU_add_test(test_suite1, "it prepends links into the linked list", test_prepend)) ||
     (NULL == CU_add_test(test_suite1, "it inserts links into the linked list at the specified index", test_insert)) ||
@@ -781,14 +1383,24 @@ int main() {
     (NULL == CU_add_test(test_suite1, "it appends links when specifying an index equal to the current size", test_insert_last)) ||
     (NULL == CU_add_test(test_suite1, "it removes links from the linked list", test_remove)) ||
     (NULL == CU_add_test(test_suite1, "it removes the first and last links from the linked list", test_remove_edges)) ||
+    (NULL == CU_add_test(test_suite1, "it removes links from both ends of the linked list", test_remove_both_ends)) ||
     (NULL == CU_add_test(test_suite1, "it gives an error when removing invalid indices", test_remove_empty)) ||
+    (NULL == CU_add_test(test_suite1, "it removes links without setting errno", test_try_remove)) ||
     (NULL == CU_add_test(test_suite1, "it returns true if all values matches the predicate", test_all)) ||
     (NULL == CU_add_test(test_suite1, "it returns true when applying a predicate to an empty linked list", test_all_empty)) ||
     (NULL == CU_add_test(test_suite1, "it returns true when applying a predicate to an empty linked list", test_all_empty)) ||
     (NULL == CU_add_test(test_suite1, "it applies a function to all elements and updates the values", test_apply_all)) ||
     (NULL == CU_add_test(test_suite1, "it applies a function to an empty linked list", test_apply_all_empty)) ||
     (NULL == CU_add_test(test_suite1, "it clears an empty linked list", test_clear_empty)) ||
-    (NULL == CU_add_test(test_suite1, "it clears a non empty linked list", test_clear))
+    (NULL == CU_add_test(test_suite1, "it clears a non empty linked list", test_clear)) ||
+    (NULL == CU_add_test(test_suite1, "it stores elements in an unrolled list like in a list of links", test_unrolled)) ||
+    (NULL == CU_add_test(test_suite1, "it stores elements in a skip list like in a list of links", test_skip)) ||
+    (NULL == CU_add_test(test_suite1, "it sorts lists and keeps equal elements in order", test_sort)) ||
+    (NULL == CU_add_test(test_suite1, "it sorts empty and small lists", test_sort_small)) ||
+    (NULL == CU_add_test(test_suite1, "it moves all elements of one list to the end of another", test_concat)) ||
+    (NULL == CU_add_test(test_suite1, "it splits a list in two at an index", test_split_at)) ||
+    (NULL == CU_add_test(test_suite1, "it appends the elements of an array", test_append_array)) ||
+    (NULL == CU_add_test(test_suite1, "it copies all elements into an array", test_to_array))
   ) {
     CU_cleanup_registry();
     return CU_get_error();
@@ -806,12 +1418,17 @@ int main() {
     (NULL == CU_add_test(test_suite2, "it removes an element from the linked list and updates the iterator", test_iterator_remove)) ||
     (NULL == CU_add_test(test_suite2, "it removes the first element from the linked list", test_iterator_remove_first)) ||
     (NULL == CU_add_test(test_suite2, "it removes the last element from the linked list", test_iterator_remove_last)) ||
+    (NULL == CU_add_test(test_suite2, "it removes the last element before stepping to the end", test_iterator_remove_before_end)) ||
     (NULL == CU_add_test(test_suite2, "it inserts links into the empty linked list and updates the iterator", test_iterator_insert_empty)) ||
     (NULL == CU_add_test(test_suite2, "it inserts links into the linked list and updates the iterator", test_iterator_insert)) ||
     (NULL == CU_add_test(test_suite2, "it inserts links first into the linked list and updates the iterator", test_iterator_insert_first)) ||
     (NULL == CU_add_test(test_suite2, "it inserts links last into the linked list and updates the iterator", test_iterator_insert_last)) ||
     (NULL == CU_add_test(test_suite2, "it iterates through the linked list and removes all links", test_iterator_remove_all)) ||
-    (NULL == CU_add_test(test_suite2, "it resets the iterator to the start of the linked list", test_iterator_reset))
+    (NULL == CU_add_test(test_suite2, "it resets the iterator to the start of the linked list", test_iterator_reset)) ||
+    (NULL == CU_add_test(test_suite2, "it initializes an iterator without allocating it", test_iterator_init)) ||
+    (NULL == CU_add_test(test_suite2, "it moves all elements of a list to the current position of the iterator", test_splice_at)) ||
+    (NULL == CU_add_test(test_suite2, "it iterates through an unrolled list and updates it", test_iterator_unrolled)) ||
+    (NULL == CU_add_test(test_suite2, "it iterates through a skip list and updates it", test_iterator_skip))
   ) {
     CU_cleanup_registry();
     return CU_get_error();
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <stdbool.h>
+
+#include "common.h"
+#include "linked_list.h"
+
+/**
+ * @file list_backend.h
+ * @author Fredrik Engstrand, Alex Alstergren
+ * @date 19 October 2026
+ * @brief Internal interface for alternative storages behind the ioopm_linked_list_* functions.
+ *
+ * A list either keeps its elements in its own links, or forwards every operation to a backend.
+ * The public functions in linked_list.c check indices and take care of errno, which means that
+ * the operations below are only called with valid indices and never touch errno.
+ * Iterators over a backend step through the list with get, so get should be O(1) when
+ * called with the index after the previous call.
+ */
+
+typedef struct list_backend list_backend_t;
+
+struct list_backend {
+  /// @brief create an empty storage of the same kind, e.g. for ioopm_linked_list_split_at
+  void *(*create)();
+
+  void (*append)(void *storage, elem_t value);
+  void (*prepend)(void *storage, elem_t value);
+
+  /// @brief append the n elements of values, in order
+  void (*append_array)(void *storage, elem_t *values, size_t n);
+
+  /// @brief insert value so that it gets the position index (in [0..n])
+  void (*insert)(void *storage, size_t index, elem_t value);
+
+  /// @brief remove the element at index (in [0..n-1]) and return it
+  elem_t (*remove)(void *storage, size_t index);
+
+  /// @brief move the elements from index (in [0..n]) to the end, in order, to rest
+  /// @param rest an empty storage from create
+  void (*split)(void *storage, size_t index, void *rest);
+
+  /// @brief return a pointer to the element at index (in [0..n-1]), valid until the list is changed
+  elem_t *(*get)(void *storage, size_t index);
+
+  void (*clear)(void *storage);
+  bool (*any)(void *storage, ioopm_char_predicate prop, void *extra);
+  void (*apply_to_all)(void *storage, ioopm_apply_char_function fun, void *extra);
+  void (*destroy)(void *storage);
+};
@@ -0,0 +1,163 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <time.h>
+#include <malloc.h>
+
+#include "common.h"
+#include "linked_list.h"
+#include "parallel_list.h"
+#include "thread_pool.h"
+
+#define DEFAULT_ELEMENTS 1000000
+#define ROUNDS 20
+#define RANDOM_EDITS 1000
+#define WORK_PER_ELEMENT 200
+
+static double seconds_since(struct timespec *start) {
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (now.tv_sec - start->tv_sec) + (now.tv_nsec - start->tv_nsec) / 1e9;
+}
+
+static void add_value(elem_t *value, void *sum) {
+  *(long *)sum += value->integer;
+}
+
+/// @brief An expensive function on an element, which scrambles it WORK_PER_ELEMENT times
+static void scramble(elem_t *value, void *extra) {
+  uint64_t bits = value->integer;
+
+  for (int i = 0; i < WORK_PER_ELEMENT; i++) {
+    bits = bits * 6364136223846793005u + 1442695040888963407u;
+  }
+
+  value->integer = bits >> 33;
+}
+
+/// @brief Measures an expensive apply_to_all on one thread and on a pool with a thread per processor
+static void measure_parallel(size_t elements) {
+  ioopm_thread_pool_t *pool = ioopm_thread_pool_create(0);
+  ioopm_list_t *list = ioopm_linked_list_create(eq_elem_int);
+  struct timespec start;
+
+  for (size_t i = 0; i < elements; i++) {
+    ioopm_linked_list_append(list, int_elem(i));
+  }
+
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  ioopm_linked_apply_to_all(list, scramble, NULL);
+  double sequential_time = seconds_since(&start);
+
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  ioopm_linked_list_parallel_apply_to_all(pool, list, scramble, NULL);
+  double parallel_time = seconds_since(&start);
+
+  printf("links, %d steps of work per element:\n", WORK_PER_ELEMENT);
+  printf("  apply_to_all %.2fms, parallel on %zu threads %.2fms\n",
+    sequential_time * 1000, ioopm_thread_pool_size(pool), parallel_time * 1000);
+
+  ioopm_linked_list_destroy(list);
+  ioopm_thread_pool_destroy(pool);
+}
+
+/// @brief Fills a list and measures the memory it uses and the time of traversing it
+static void measure(char *name, ioopm_list_t *(*create)(ioopm_eq_function), size_t elements) {
+  size_t before = mallinfo2().uordblks;
+  ioopm_list_t *list = create(eq_elem_int);
+  struct timespec start;
+  long sum = 0;
+
+  clock_gettime(CLOCK_MONOTONIC, &start);
+
+  for (size_t i = 0; i < elements; i++) {
+    ioopm_linked_list_append(list, int_elem(i));
+  }
+
+  double append_time = seconds_since(&start);
+  double bytes = (double)(mallinfo2().uordblks - before) / elements;
+  elem_t *values = calloc(elements, sizeof(elem_t));
+  ioopm_list_t *copy = create(eq_elem_int);
+
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  ioopm_linked_list_to_array(list, values);
+  double to_array_time = seconds_since(&start);
+
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  ioopm_linked_list_append_array(copy, values, elements);
+  double append_array_time = seconds_since(&start);
+
+  ioopm_linked_list_destroy(copy);
+  free(values);
+
+  clock_gettime(CLOCK_MONOTONIC, &start);
+
+  for (int i = 0; i < ROUNDS; i++) {
+    ioopm_linked_apply_to_all(list, add_value, &sum);
+  }
+
+  double apply_time = seconds_since(&start) / ROUNDS;
+
+  clock_gettime(CLOCK_MONOTONIC, &start);
+
+  for (int i = 0; i < ROUNDS; i++) {
+    // Searching for a missing element traverses the whole list
+    sum += ioopm_linked_list_contains(list, int_elem(-1));
+  }
+
+  double contains_time = seconds_since(&start) / ROUNDS;
+
+  clock_gettime(CLOCK_MONOTONIC, &start);
+
+  for (size_t i = 0; i < elements; i++) {
+    sum += ioopm_linked_list_get(list, i).integer;
+  }
+
+  double get_time = seconds_since(&start);
+
+  srand(1);
+  clock_gettime(CLOCK_MONOTONIC, &start);
+
+  for (int i = 0; i < RANDOM_EDITS; i++) {
+    ioopm_linked_list_insert(list, rand() % (elements + 1), int_elem(i));
+    sum += ioopm_linked_list_remove(list, rand() % (elements + 1)).integer;
+  }
+
+  double edit_time = seconds_since(&start);
+
+  clock_gettime(CLOCK_MONOTONIC, &start);
+
+  for (int i = 0; i < ROUNDS; i++) {
+    ioopm_list_t *rest = ioopm_linked_list_split_at(list, elements / 2);
+
+    ioopm_linked_list_concat(list, rest);
+    ioopm_linked_list_destroy(rest);
+  }
+
+  double split_time = seconds_since(&start) / ROUNDS;
+
+  printf("%s\n", name);
+  printf("  %.1f bytes per element (%.1f overhead)\n", bytes, bytes - sizeof(elem_t));
+  printf("  append each %.2fms, append_array %.2fms, to_array %.2fms\n",
+    append_time * 1000, append_array_time * 1000, to_array_time * 1000);
+  printf("  apply_to_all %.2fms, contains %.2fms, get each index %.2fms\n",
+    apply_time * 1000, contains_time * 1000, get_time * 1000);
+  printf("  insert and remove at %d random indices %.2fms (sum %ld)\n", RANDOM_EDITS, edit_time * 1000, sum);
+  printf("  split at the middle and concatenate again %.2fms\n", split_time * 1000);
+
+  ioopm_linked_list_destroy(list);
+}
+
+int main(int argc, char *argv[]) {
+  size_t elements = argc > 1 ? atol(argv[1]) : DEFAULT_ELEMENTS;
+
+  printf("elements: %zu, average of %d traversals\n", elements, ROUNDS);
+
+  measure("links:", ioopm_linked_list_create, elements);
+  measure("unrolled:", ioopm_linked_list_create_unrolled, elements);
+  measure("skip list:", ioopm_linked_list_create_skip, elements);
+  measure_parallel(elements);
+
+  return 0;
+}
@@ -0,0 +1,205 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "common.h"
+#include "multimap.h"
+
+#define INITIAL_SLOTS 16
+#define GROWTH_FACTOR 2
+#define INLINE_VALUES 3
+#define INITIAL_CHUNK_SIZE 8
+
+typedef struct slot slot_t;
+
+//@brief a key and its values, or an empty slot if count is 0.
+// With 3 inline values, a slot fills exactly one 64 byte cache line.
+struct slot {
+  unsigned long hash;                   // The (mixed) hash code of the key.
+  elem_t key;                           // The key.
+  size_t count;                         // The amount of values of the key (0 if the slot is empty).
+  elem_t inline_values[INLINE_VALUES];  // The first values of the key.
+  ioopm_value_chunk_t *first;           // The chunk with the values after the inline values (possibly NULL).
+  ioopm_value_chunk_t *last;            // The chunk that values are appended to (possibly NULL).
+};
+
+//@brief the values of a key that do not fit inline.
+struct value_chunk {
+  ioopm_value_chunk_t *next;  // The chunk with the following values (possibly NULL).
+  size_t length;              // The amount of values in the chunk.
+  size_t capacity;            // The amount of values that fit in the chunk.
+  elem_t values[];
+};
+
+//@brief an open addressing hash table (with linear probing) of keys and their values.
+struct multimap {
+  slot_t *slots;                 // The slots.
+  size_t slot_count;             // The amount of slots (always a power of 2).
+  size_t size;                   // The amount of keys.
+  ioopm_eq_function eq_key;      // equality function for keys.
+  ioopm_hash_function hash_func; // The hashing function.
+};
+
+static unsigned long extract_hash_code(elem_t key) {
+  return key.unsigned_long;
+}
+
+/// @brief Calculates the hash code of a key, mixed so that the lowest bits can be used as the slot
+static unsigned long hash_key(ioopm_multimap_t *multimap, elem_t key) {
+  unsigned long hash = multimap->hash_func(key);
+  hash = (hash ^ (hash >> 33)) * 0xff51afd7ed558ccdUL;
+  hash = (hash ^ (hash >> 33)) * 0xc4ceb9fe1a85ec53UL;
+  return hash ^ (hash >> 33);
+}
+
+/// @brief Finds the slot holding key, or the empty slot where it should be inserted
+static slot_t *find_slot(ioopm_multimap_t *multimap, elem_t key, unsigned long hash) {
+  size_t mask = multimap->slot_count - 1;
+
+  for (size_t i = hash & mask; ; i = (i + 1) & mask) {
+    slot_t *slot = &multimap->slots[i];
+
+    if (slot->count == 0 || (slot->hash == hash && multimap->eq_key(slot->key, key))) {
+      return slot;
+    }
+  }
+}
+
+static void grow_slots(ioopm_multimap_t *multimap) {
+  slot_t *old_slots = multimap->slots;
+  size_t old_count = multimap->slot_count;
+
+  multimap->slot_count *= GROWTH_FACTOR;
+  multimap->slots = calloc(multimap->slot_count, sizeof(slot_t));
+
+  size_t mask = multimap->slot_count - 1;
+
+  // The chunks are owned by the slots, so they move together with them
+  for (size_t i = 0; i < old_count; i++) {
+    if (old_slots[i].count == 0) {
+      continue;
+    }
+
+    size_t j = old_slots[i].hash & mask;
+
+    while (multimap->slots[j].count != 0) {
+      j = (j + 1) & mask;
+    }
+
+    multimap->slots[j] = old_slots[i];
+  }
+
+  free(old_slots);
+}
+
+/// @brief Appends a value after the inline values of a slot, allocating a chunk twice as large as the last if it is full
+static void append_to_chunks(slot_t *slot, elem_t value) {
+  ioopm_value_chunk_t *last = slot->last;
+
+  if (last == NULL || last->length == last->capacity) {
+    size_t capacity = last == NULL ? INITIAL_CHUNK_SIZE : last->capacity * GROWTH_FACTOR;
+    ioopm_value_chunk_t *chunk = malloc(sizeof(ioopm_value_chunk_t) + capacity * sizeof(elem_t));
+
+    *chunk = (ioopm_value_chunk_t){ .capacity = capacity };
+
+    if (last == NULL) {
+      slot->first = chunk;
+    } else {
+      last->next = chunk;
+    }
+
+    slot->last = last = chunk;
+  }
+
+  last->values[last->length++] = value;
+}
+
+ioopm_multimap_t *ioopm_multimap_create(ioopm_eq_function eq_key, ioopm_hash_function hash_func) {
+  ioopm_multimap_t *multimap = calloc(1, sizeof(ioopm_multimap_t));
+
+  *multimap = (ioopm_multimap_t){
+    .slots = calloc(INITIAL_SLOTS, sizeof(slot_t)),
+    .slot_count = INITIAL_SLOTS,
+    .eq_key = eq_key,
+    .hash_func = hash_func == NULL ? extract_hash_code : hash_func,
+  };
+
+  return multimap;
+}
+
+void ioopm_multimap_destroy(ioopm_multimap_t *multimap) {
+  for (size_t i = 0; i < multimap->slot_count; i++) {
+    ioopm_value_chunk_t *chunk = multimap->slots[i].first;
+
+    while (chunk != NULL) {
+      ioopm_value_chunk_t *next = chunk->next;
+      free(chunk);
+      chunk = next;
+    }
+  }
+
+  free(multimap->slots);
+  free(multimap);
+}
+
+void ioopm_multimap_insert(ioopm_multimap_t *multimap, elem_t key, elem_t value) {
+  unsigned long hash = hash_key(multimap, key);
+  slot_t *slot = find_slot(multimap, key, hash);
+
+  if (slot->count == 0) {
+    *slot = (slot_t){ .hash = hash, .key = key };
+    multimap->size++;
+  }
+
+  if (slot->count < INLINE_VALUES) {
+    slot->inline_values[slot->count] = value;
+  } else {
+    append_to_chunks(slot, value);
+  }
+
+  slot->count++;
+
+  // Keep at most half of the slots in use, so that the probe sequences stay short
+  if (multimap->size * 2 > multimap->slot_count) {
+    grow_slots(multimap);
+  }
+}
+
+ioopm_multimap_view_t ioopm_multimap_lookup_all(ioopm_multimap_t *multimap, elem_t key) {
+  slot_t *slot = find_slot(multimap, key, hash_key(multimap, key));
+
+  if (slot->count == 0) {
+    return (ioopm_multimap_view_t){ .values = NULL };
+  }
+
+  return (ioopm_multimap_view_t){
+    .values = slot->inline_values,
+    .length = slot->count < INLINE_VALUES ? slot->count : INLINE_VALUES,
+    .count = slot->count,
+    .next = slot->first,
+  };
+}
+
+void ioopm_multimap_view_next(ioopm_multimap_view_t *view) {
+  const ioopm_value_chunk_t *chunk = view->next;
+
+  if (chunk == NULL) {
+    view->values = NULL;
+    view->length = 0;
+    return;
+  }
+
+  view->values = chunk->values;
+  view->length = chunk->length;
+  view->next = chunk->next;
+}
+
+size_t ioopm_multimap_count(ioopm_multimap_t *multimap, elem_t key) {
+  return find_slot(multimap, key, hash_key(multimap, key))->count;
+}
+
+size_t ioopm_multimap_size(ioopm_multimap_t *multimap) {
+  return multimap->size;
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <stdbool.h>
+
+#include "common.h"
+
+/**
+ * @file multimap.h
+ * @author Fredrik Engstrand, Alex Alstergren
+ * @date 19 October 2026
+ * @brief Map from each key to any amount of values, e.g. from a word to its occurrences.
+ *
+ * The first values of a key are stored inline next to the key. Further values are appended to
+ * chunks that double in size, so inserting n values for a key only allocates O(log n) times
+ * instead of once per value as with an ioopm_list_t per key.
+ * Like the hash table, the multimap does not copy or deallocate memory pointed to by keys or values.
+ */
+
+typedef struct multimap ioopm_multimap_t;
+typedef struct value_chunk ioopm_value_chunk_t;
+
+//@brief a view of the values of a key, as one or more arrays (segments) of values.
+// Loop over the segments with ioopm_multimap_view_next while length is not 0.
+// A view is valid until the next value is inserted into the multimap.
+typedef struct multimap_view {
+  const elem_t *values;             // The values of the current segment.
+  size_t length;                    // The amount of values in the current segment (0 when there are no more).
+  size_t count;                     // The amount of values of the key, in all segments.
+  const ioopm_value_chunk_t *next;  // The chunk holding the next segment (possibly NULL).
+} ioopm_multimap_view_t;
+
+/// @brief Create a new empty multimap
+/// @param eq_key the function used to compare two keys in the multimap
+/// @param hash_func the function used to create a hash code from the key
+///        if NULL, it fallbacks to extracting an integer value from your key
+/// @return A new empty multimap
+ioopm_multimap_t *ioopm_multimap_create(ioopm_eq_function eq_key, ioopm_hash_function hash_func);
+
+/// @brief Tear down the multimap and return all its memory (but not the memory of keys and values)
+/// @param multimap the multimap to be destroyed
+void ioopm_multimap_destroy(ioopm_multimap_t *multimap);
+
+/// @brief Add a value to the values of a key
+/// @param multimap the multimap operated upon
+/// @param key the key
+/// @param value the value, which is added after the values already inserted for key
+void ioopm_multimap_insert(ioopm_multimap_t *multimap, elem_t key, elem_t value);
+
+/// @brief Get all values of a key, in the order they were inserted, without copying them
+/// @param multimap the multimap operated upon
+/// @param key the key
+/// @return a view of the first segment of values (of length 0 if key has no values)
+ioopm_multimap_view_t ioopm_multimap_lookup_all(ioopm_multimap_t *multimap, elem_t key);
+
+/// @brief Move a view to the next segment of values
+/// @param view the view, whose length is set to 0 if there are no more values
+void ioopm_multimap_view_next(ioopm_multimap_view_t *view);
+
+/// @brief Get the amount of values of a key
+/// @param multimap the multimap operated upon
+/// @param key the key
+/// @return the amount of values inserted for key
+size_t ioopm_multimap_count(ioopm_multimap_t *multimap, elem_t key);
+
+/// @brief Get the amount of distinct keys in the multimap
+/// @param multimap the multimap operated upon
+/// @return the amount of keys
+size_t ioopm_multimap_size(ioopm_multimap_t *multimap);
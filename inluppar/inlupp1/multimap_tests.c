@@ -0,0 +1,145 @@
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <CUnit/Basic.h>
+
+#include "common.h"
+#include "multimap.h"
+
+int init_suite(void) {
+  return 0;
+}
+
+int clean_suite(void) {
+  return 0;
+}
+
+/// @brief Checks that the values of key are start, start + 1, ..., start + count - 1 (in that order)
+void assert_values(ioopm_multimap_t *multimap, elem_t key, int start, size_t count) {
+  size_t seen = 0;
+
+  CU_ASSERT_EQUAL(ioopm_multimap_count(multimap, key), count);
+
+  for (ioopm_multimap_view_t view = ioopm_multimap_lookup_all(multimap, key);
+       view.length > 0;
+       ioopm_multimap_view_next(&view)
+  ) {
+    CU_ASSERT_EQUAL(view.count, count);
+
+    for (size_t i = 0; i < view.length; i++) {
+      CU_ASSERT_EQUAL(view.values[i].integer, start + seen);
+      seen++;
+    }
+  }
+
+  CU_ASSERT_EQUAL(seen, count);
+}
+
+void test_create_destroy() {
+  ioopm_multimap_t *multimap = ioopm_multimap_create(eq_elem_int, NULL);
+
+  CU_ASSERT_PTR_NOT_NULL(multimap);
+  CU_ASSERT_EQUAL(ioopm_multimap_size(multimap), 0);
+
+  ioopm_multimap_destroy(multimap);
+}
+
+void test_lookup_missing_key() {
+  ioopm_multimap_t *multimap = ioopm_multimap_create(eq_elem_int, NULL);
+
+  ioopm_multimap_insert(multimap, int_elem(1), int_elem(10));
+
+  ioopm_multimap_view_t view = ioopm_multimap_lookup_all(multimap, int_elem(2));
+  CU_ASSERT_EQUAL(view.length, 0);
+  CU_ASSERT_EQUAL(view.count, 0);
+  CU_ASSERT_EQUAL(ioopm_multimap_count(multimap, int_elem(2)), 0);
+
+  ioopm_multimap_destroy(multimap);
+}
+
+void test_insert_inline_values() {
+  ioopm_multimap_t *multimap = ioopm_multimap_create(eq_elem_int, NULL);
+
+  ioopm_multimap_insert(multimap, int_elem(0), int_elem(5));
+  ioopm_multimap_insert(multimap, int_elem(1), int_elem(7));
+  ioopm_multimap_insert(multimap, int_elem(0), int_elem(6));
+
+  CU_ASSERT_EQUAL(ioopm_multimap_size(multimap), 2);
+  assert_values(multimap, int_elem(0), 5, 2);
+  assert_values(multimap, int_elem(1), 7, 1);
+
+  ioopm_multimap_destroy(multimap);
+}
+
+void test_insert_chunked_values() {
+  ioopm_multimap_t *multimap = ioopm_multimap_create(eq_elem_int, NULL);
+
+  // Interleave the keys, so that the slots move while some keys have chunks
+  for (int i = 0; i < 1000; i++) {
+    for (int key = 0; key < 20; key++) {
+      ioopm_multimap_insert(multimap, int_elem(key), int_elem(key * 1000 + i));
+    }
+  }
+
+  CU_ASSERT_EQUAL(ioopm_multimap_size(multimap), 20);
+
+  for (int key = 0; key < 20; key++) {
+    assert_values(multimap, int_elem(key), key * 1000, 1000);
+  }
+
+  ioopm_multimap_destroy(multimap);
+}
+
+void test_string_keys() {
+  ioopm_multimap_t *multimap = ioopm_multimap_create(eq_elem_string, string_knr_hash);
+  char *words[] = { "a", "rose", "is", "a", "rose", "is", "a", "rose" };
+  char buf[8];
+
+  // Map each word to the positions where it occurs
+  for (int i = 0; i < 8; i++) {
+    ioopm_multimap_insert(multimap, ptr_elem(words[i]), int_elem(i));
+  }
+
+  CU_ASSERT_EQUAL(ioopm_multimap_size(multimap), 3);
+
+  strcpy(buf, "rose");
+  ioopm_multimap_view_t view = ioopm_multimap_lookup_all(multimap, ptr_elem(buf));
+
+  CU_ASSERT_EQUAL(view.length, 3);
+  CU_ASSERT_EQUAL(view.values[0].integer, 1);
+  CU_ASSERT_EQUAL(view.values[1].integer, 4);
+  CU_ASSERT_EQUAL(view.values[2].integer, 7);
+  CU_ASSERT_EQUAL(ioopm_multimap_count(multimap, ptr_elem("is")), 2);
+
+  ioopm_multimap_destroy(multimap);
+}
+
+int main() {
+  CU_pSuite test_suite1 = NULL;
+
+  if (CUE_SUCCESS != CU_initialize_registry())
+    return CU_get_error();
+
+  test_suite1 = CU_add_suite("Multimap", init_suite, clean_suite);
+  if (NULL == test_suite1) {
+    CU_cleanup_registry();
+    return CU_get_error();
+  }
+
+  if (
+    (NULL == CU_add_test(test_suite1, "it creates and returns a pointer to an empty multimap", test_create_destroy)) ||
+    (NULL == CU_add_test(test_suite1, "it returns an empty view for keys without values", test_lookup_missing_key)) ||
+    (NULL == CU_add_test(test_suite1, "it keeps the first values of each key in insertion order", test_insert_inline_values)) ||
+    (NULL == CU_add_test(test_suite1, "it keeps many values of each key in insertion order", test_insert_chunked_values)) ||
+    (NULL == CU_add_test(test_suite1, "it maps string keys to the positions where they occur", test_string_keys))
+  ) {
+    CU_cleanup_registry();
+    return CU_get_error();
+  }
+
+  CU_basic_set_mode(CU_BRM_VERBOSE);  // Detaljerna utav testerna skrivs ut.
+  CU_basic_run_tests();               // Kör alla testen.
+  CU_cleanup_registry();              // Städar upp testerna (avallokerar minnen bland annat)
+  return CU_get_error();              // Returnerar alla fel som hänt
+}
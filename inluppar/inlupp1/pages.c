@@ -0,0 +1,116 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <linux/mempolicy.h>
+
+#include "pages.h"
+
+#define MAX_NODES 1024
+#define BITS_PER_LONG (8 * sizeof(unsigned long))
+
+/// @brief Checks if an array should be mapped from the kernel instead of allocated with calloc
+static bool is_mapped(size_t size, const ioopm_alloc_policy_t *policy) {
+  if (policy == NULL || size < PAGES_HUGE_SIZE) {
+    return false;
+  }
+
+  return policy->pages != IOOPM_PAGES_DEFAULT || policy->numa != IOOPM_NUMA_DEFAULT;
+}
+
+static size_t round_to_huge_pages(size_t size) {
+  return (size + PAGES_HUGE_SIZE - 1) & ~(PAGES_HUGE_SIZE - 1);
+}
+
+/// @brief Maps size bytes aligned to PAGES_HUGE_SIZE, so that every part can be a huge page
+static void *map_aligned(size_t size) {
+  size_t padded = size + PAGES_HUGE_SIZE;
+  char *mapping = mmap(NULL, padded, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+  if (mapping == MAP_FAILED) {
+    return NULL;
+  }
+
+  // Give back the unaligned head and the tail that is not needed
+  char *aligned = (char *)(((uintptr_t)mapping + PAGES_HUGE_SIZE - 1) & ~(PAGES_HUGE_SIZE - 1));
+  size_t head = aligned - mapping;
+
+  if (head > 0) {
+    munmap(mapping, head);
+  }
+
+  munmap(aligned + size, padded - head - size);
+  return aligned;
+}
+
+/// @brief Places the (not yet touched) pages of a mapping on NUMA nodes, ignoring errors
+static void place_on_nodes(void *array, size_t size, const ioopm_alloc_policy_t *policy) {
+  unsigned long nodes[MAX_NODES / BITS_PER_LONG] = { 0 };
+  int mode;
+
+  if (policy->numa == IOOPM_NUMA_BIND) {
+    if (policy->node < 0 || policy->node >= MAX_NODES) {
+      return;
+    }
+
+    mode = MPOL_BIND;
+    nodes[policy->node / BITS_PER_LONG] = 1UL << (policy->node % BITS_PER_LONG);
+  } else {
+    mode = MPOL_INTERLEAVE;
+
+    // Interleave over the nodes that the process is allowed to use
+    if (syscall(SYS_get_mempolicy, NULL, nodes, MAX_NODES, NULL, MPOL_F_MEMS_ALLOWED) != 0) {
+      return;
+    }
+  }
+
+  syscall(SYS_mbind, array, size, mode, nodes, MAX_NODES, 0);
+}
+
+void *pages_alloc(size_t size, const ioopm_alloc_policy_t *policy) {
+  if (!is_mapped(size, policy)) {
+    return calloc(1, size);
+  }
+
+  size = round_to_huge_pages(size);
+  void *array = NULL;
+
+  if (policy->pages == IOOPM_PAGES_HUGETLB) {
+    // Fails unless huge pages have been reserved (see /proc/sys/vm/nr_hugepages)
+    array = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    array = array == MAP_FAILED ? NULL : array;
+  }
+
+  if (array == NULL) {
+    array = map_aligned(size);
+
+    if (array == NULL) {
+      return NULL;
+    }
+
+    if (policy->pages != IOOPM_PAGES_DEFAULT) {
+      madvise(array, size, MADV_HUGEPAGE);
+    }
+  }
+
+  if (policy->numa != IOOPM_NUMA_DEFAULT) {
+    place_on_nodes(array, size, policy);
+  }
+
+  // Anonymous mappings are already zeroed
+  return array;
+}
+
+void pages_free(void *array, size_t size, const ioopm_alloc_policy_t *policy) {
+  if (!is_mapped(size, policy)) {
+    free(array);
+    return;
+  }
+
+  if (array != NULL) {
+    munmap(array, round_to_huge_pages(size));
+  }
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <stddef.h>
+
+/**
+ * @file pages.h
+ * @author Fredrik Engstrand, Alex Alstergren
+ * @date 19 October 2026
+ * @brief Allocation of large zeroed arrays (such as bucket arrays) with a page and NUMA policy.
+ *
+ * Arrays of at least PAGES_HUGE_SIZE bytes are mapped directly from the kernel, so that they can
+ * be backed by huge pages and placed on chosen NUMA nodes. Smaller arrays are allocated with calloc.
+ * The policy is a hint: if the kernel refuses huge pages or a NUMA placement, the array is
+ * still allocated with normal pages and the default placement.
+ */
+
+#define PAGES_HUGE_SIZE (2UL * 1024 * 1024)
+
+//@brief what kind of pages back an array.
+typedef enum {
+  IOOPM_PAGES_DEFAULT,    // Normal pages from calloc.
+  IOOPM_PAGES_TRANSPARENT,// Transparent huge pages (madvise), used when the kernel has them available.
+  IOOPM_PAGES_HUGETLB,    // Explicit huge pages (MAP_HUGETLB), falling back to transparent huge pages.
+} ioopm_page_kind_t;
+
+//@brief which NUMA nodes the pages of an array are placed on.
+typedef enum {
+  IOOPM_NUMA_DEFAULT,     // The node of the thread that first touches each page.
+  IOOPM_NUMA_INTERLEAVE,  // Spread round-robin over every node the process may use.
+  IOOPM_NUMA_BIND,        // Only on the node given in the policy.
+} ioopm_numa_mode_t;
+
+//@brief how the bucket arrays of a hash table are allocated.
+typedef struct alloc_policy {
+  ioopm_page_kind_t pages;  // The kind of pages.
+  ioopm_numa_mode_t numa;   // The NUMA placement.
+  int node;                 // The node used by IOOPM_NUMA_BIND.
+} ioopm_alloc_policy_t;
+
+/// @brief Allocate a zeroed array
+/// @param size the size of the array in bytes
+/// @param policy how the array is allocated (NULL for calloc)
+/// @return the array
+void *pages_alloc(size_t size, const ioopm_alloc_policy_t *policy);
+
+/// @brief Deallocate an array allocated by pages_alloc
+/// @param array the array (may be NULL)
+/// @param size the size given when the array was allocated
+/// @param policy the policy given when the array was allocated
+void pages_free(void *array, size_t size, const ioopm_alloc_policy_t *policy);
@@ -0,0 +1,185 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+
+#include "common.h"
+#include "parallel_list.h"
+
+#define SEGMENTS_PER_THREAD 4
+
+//@brief a list split into segments, with the function and state of the operation run on them.
+typedef struct parallel {
+  elem_t **elements;               // Pointers to the elements of the list, in order.
+  size_t size;                     // The amount of elements.
+  size_t segments;                 // The amount of segments (0 if the list is empty).
+  ioopm_apply_char_function fun;   // The function of apply_to_all.
+  ioopm_char_predicate prop;       // The property of any, all and filter.
+  bool negate;                     // True if any should look for an element that prop does not hold for.
+  bool found;                      // Set by any when an element is found, to stop the other threads.
+  ioopm_list_t **lists;            // The result of filter for each segment.
+  ioopm_combine_function combine;  // The function of reduce.
+  elem_t identity;                 // The value that reduce starts each segment from.
+  elem_t *results;                 // The result of reduce for each segment.
+  void *extra;
+} parallel_t;
+
+/// @brief Used in conjuction with apply_to_all to collect a pointer to each element
+static void collect_pointer(elem_t *value, void *x) {
+  elem_t ***next = x;
+  *(*next)++ = value;
+}
+
+/// @brief Splits a list into segments with one traversal, SEGMENTS_PER_THREAD for each thread of pool
+static void partition(ioopm_thread_pool_t *pool, ioopm_list_t *list, parallel_t *parallel) {
+  size_t size = ioopm_linked_list_size(list);
+  size_t segments = ioopm_thread_pool_size(pool) * SEGMENTS_PER_THREAD;
+  elem_t **next = calloc(size > 0 ? size : 1, sizeof(elem_t *));
+
+  parallel->elements = next;
+  parallel->size = size;
+  parallel->segments = size < segments ? size : segments;
+
+  ioopm_linked_apply_to_all(list, collect_pointer, &next);
+}
+
+/// @brief Gets the elements [start..end-1] of a segment, which differ at most one in size between segments
+static void segment_bounds(parallel_t *parallel, size_t segment, size_t *start, size_t *end) {
+  *start = segment * parallel->size / parallel->segments;
+  *end = (segment + 1) * parallel->size / parallel->segments;
+}
+
+/// @brief Creates an empty list of the same kind and with the same equality function as list
+static ioopm_list_t *create_empty_like(ioopm_list_t *list) {
+  // Splitting at the end moves no elements
+  return ioopm_linked_list_split_at(list, ioopm_linked_list_size(list));
+}
+
+static void apply_segment(size_t segment, void *x) {
+  parallel_t *parallel = x;
+  size_t start, end;
+
+  segment_bounds(parallel, segment, &start, &end);
+
+  for (size_t i = start; i < end; i++) {
+    parallel->fun(parallel->elements[i], parallel->extra);
+  }
+}
+
+static void any_segment(size_t segment, void *x) {
+  parallel_t *parallel = x;
+  size_t start, end;
+
+  segment_bounds(parallel, segment, &start, &end);
+
+  for (size_t i = start; i < end; i++) {
+    // Stop as soon as any thread has found an element
+    if (__atomic_load_n(&parallel->found, __ATOMIC_RELAXED)) {
+      return;
+    }
+
+    if (parallel->prop(*parallel->elements[i], parallel->extra) != parallel->negate) {
+      __atomic_store_n(&parallel->found, true, __ATOMIC_RELAXED);
+      return;
+    }
+  }
+}
+
+static void filter_segment(size_t segment, void *x) {
+  parallel_t *parallel = x;
+  size_t start, end;
+
+  segment_bounds(parallel, segment, &start, &end);
+
+  for (size_t i = start; i < end; i++) {
+    if (parallel->prop(*parallel->elements[i], parallel->extra)) {
+      ioopm_linked_list_append(parallel->lists[segment], *parallel->elements[i]);
+    }
+  }
+}
+
+static void reduce_segment(size_t segment, void *x) {
+  parallel_t *parallel = x;
+  elem_t result = parallel->identity;
+  size_t start, end;
+
+  segment_bounds(parallel, segment, &start, &end);
+
+  for (size_t i = start; i < end; i++) {
+    result = parallel->combine(result, *parallel->elements[i], parallel->extra);
+  }
+
+  parallel->results[segment] = result;
+}
+
+void ioopm_linked_list_parallel_apply_to_all(ioopm_thread_pool_t *pool, ioopm_list_t *list, ioopm_apply_char_function fun, void *extra) {
+  parallel_t parallel = { .fun = fun, .extra = extra };
+
+  partition(pool, list, &parallel);
+  ioopm_thread_pool_run(pool, apply_segment, parallel.segments, &parallel);
+
+  free(parallel.elements);
+}
+
+/// @brief Looks for an element that prop holds for (or does not hold for if negate is true)
+static bool parallel_find(ioopm_thread_pool_t *pool, ioopm_list_t *list, ioopm_char_predicate prop, bool negate, void *extra) {
+  parallel_t parallel = { .prop = prop, .negate = negate, .extra = extra };
+
+  partition(pool, list, &parallel);
+  ioopm_thread_pool_run(pool, any_segment, parallel.segments, &parallel);
+
+  free(parallel.elements);
+
+  return parallel.found;
+}
+
+bool ioopm_linked_list_parallel_any(ioopm_thread_pool_t *pool, ioopm_list_t *list, ioopm_char_predicate prop, void *extra) {
+  return parallel_find(pool, list, prop, false, extra);
+}
+
+bool ioopm_linked_list_parallel_all(ioopm_thread_pool_t *pool, ioopm_list_t *list, ioopm_char_predicate prop, void *extra) {
+  return !parallel_find(pool, list, prop, true, extra);
+}
+
+ioopm_list_t *ioopm_linked_list_parallel_filter(ioopm_thread_pool_t *pool, ioopm_list_t *list, ioopm_char_predicate prop, void *extra) {
+  parallel_t parallel = { .prop = prop, .extra = extra };
+  ioopm_list_t *result = create_empty_like(list);
+
+  partition(pool, list, &parallel);
+  parallel.lists = calloc(parallel.segments > 0 ? parallel.segments : 1, sizeof(ioopm_list_t *));
+
+  for (size_t i = 0; i < parallel.segments; i++) {
+    parallel.lists[i] = create_empty_like(list);
+  }
+
+  ioopm_thread_pool_run(pool, filter_segment, parallel.segments, &parallel);
+
+  // Gathering the segments moves their links without copying them
+  for (size_t i = 0; i < parallel.segments; i++) {
+    ioopm_linked_list_concat(result, parallel.lists[i]);
+    ioopm_linked_list_destroy(parallel.lists[i]);
+  }
+
+  free(parallel.lists);
+  free(parallel.elements);
+
+  return result;
+}
+
+elem_t ioopm_linked_list_parallel_reduce(ioopm_thread_pool_t *pool, ioopm_list_t *list, elem_t identity, ioopm_combine_function combine, void *extra) {
+  parallel_t parallel = { .combine = combine, .identity = identity, .extra = extra };
+  elem_t result = identity;
+
+  partition(pool, list, &parallel);
+  parallel.results = calloc(parallel.segments > 0 ? parallel.segments : 1, sizeof(elem_t));
+
+  ioopm_thread_pool_run(pool, reduce_segment, parallel.segments, &parallel);
+
+  for (size_t i = 0; i < parallel.segments; i++) {
+    result = combine(result, parallel.results[i], extra);
+  }
+
+  free(parallel.results);
+  free(parallel.elements);
+
+  return result;
+}
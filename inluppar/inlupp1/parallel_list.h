@@ -0,0 +1,74 @@
+#pragma once
+
+#include <stdbool.h>
+
+#include "common.h"
+#include "linked_list.h"
+#include "thread_pool.h"
+
+/**
+ * @file parallel_list.h
+ * @author Fredrik Engstrand, Alex Alstergren
+ * @date 19 October 2026
+ * @brief Versions of the list traversals that call their functions on several threads at once.
+ *
+ * The list is first split into segments of roughly equal size with one traversal (collecting a
+ * pointer to each element), and then the segments are handed out to the threads of a pool.
+ * There are a few segments per thread, so that threads that finish early take over the
+ * remaining ones. This only pays off when the function called on each element is expensive
+ * compared to stepping through the list.
+ *
+ * The functions work on all kinds of lists. The list may not be changed while they run, and
+ * the supplied functions are called from several threads at the same time, so they may only
+ * change extra in a thread safe way.
+ */
+
+/// @brief combines two values into one, e.g. by adding them
+typedef elem_t(*ioopm_combine_function)(elem_t a, elem_t b, void *extra);
+
+/// @brief Apply a supplied function to all elements in a list, on the threads of a pool
+/// @param pool the threads to use
+/// @param list the linked list
+/// @param fun the function to be applied, which may only change the element it is called with
+/// @param extra an additional argument (may be NULL) that will be passed to all internal calls of fun
+void ioopm_linked_list_parallel_apply_to_all(ioopm_thread_pool_t *pool, ioopm_list_t *list, ioopm_apply_char_function fun, void *extra);
+
+/// @brief Test if a supplied property holds for any element in a list, on the threads of a pool
+/// All threads stop as soon as one of them finds an element that prop holds for.
+/// @param pool the threads to use
+/// @param list the linked list
+/// @param prop the property to be tested
+/// @param extra an additional argument (may be NULL) that will be passed to all internal calls of prop
+/// @return true if prop holds for any element in the list, else false
+bool ioopm_linked_list_parallel_any(ioopm_thread_pool_t *pool, ioopm_list_t *list, ioopm_char_predicate prop, void *extra);
+
+/// @brief Test if a supplied property holds for all elements in a list, on the threads of a pool
+/// All threads stop as soon as one of them finds an element that prop does not hold for.
+/// @param pool the threads to use
+/// @param list the linked list
+/// @param prop the property to be tested
+/// @param extra an additional argument (may be NULL) that will be passed to all internal calls of prop
+/// @return true if prop holds for all elements in the list, else false
+bool ioopm_linked_list_parallel_all(ioopm_thread_pool_t *pool, ioopm_list_t *list, ioopm_char_predicate prop, void *extra);
+
+/// @brief Create a list of the elements that a supplied property holds for, on the threads of a pool
+/// Each segment is filtered into a list of its own, and these are concatenated in order.
+/// @param pool the threads to use
+/// @param list the linked list
+/// @param prop the property to be tested
+/// @param extra an additional argument (may be NULL) that will be passed to all internal calls of prop
+/// @return a new list of the same kind as list (with the same equality function), with the elements
+///         that prop holds for in the same order as in list
+ioopm_list_t *ioopm_linked_list_parallel_filter(ioopm_thread_pool_t *pool, ioopm_list_t *list, ioopm_char_predicate prop, void *extra);
+
+/// @brief Combine all elements of a list into one value, on the threads of a pool
+/// Each segment is combined on its own, starting from identity, and the results of the segments
+/// are combined in order. This gives the same result as combining the elements one at a time from
+/// the start, as long as combine is associative and identity does not change a value it is combined with.
+/// @param pool the threads to use
+/// @param list the linked list
+/// @param identity the result for an empty list, e.g. 0 for addition
+/// @param combine the function used to combine values
+/// @param extra an additional argument (may be NULL) that will be passed to all internal calls of combine
+/// @return the combined value of all elements
+elem_t ioopm_linked_list_parallel_reduce(ioopm_thread_pool_t *pool, ioopm_list_t *list, elem_t identity, ioopm_combine_function combine, void *extra);
@@ -0,0 +1,221 @@
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <CUnit/Basic.h>
+
+#include "common.h"
+#include "linked_list.h"
+#include "parallel_list.h"
+#include "thread_pool.h"
+
+#define THREADS 4
+
+ioopm_thread_pool_t *pool = NULL;
+
+int init_suite(void) {
+  pool = ioopm_thread_pool_create(THREADS);
+  return 0;
+}
+
+int clean_suite(void) {
+  ioopm_thread_pool_destroy(pool);
+  return 0;
+}
+
+/// @brief The ways of creating a list, since the functions work on all kinds of lists
+ioopm_list_t *(*list_creators[])(ioopm_eq_function) = {
+  ioopm_linked_list_create,
+  ioopm_linked_list_create_unrolled,
+  ioopm_linked_list_create_skip,
+};
+
+/// @brief Creates a list of a given kind with the integers [0..n-1]
+ioopm_list_t *create_range(size_t kind, int n) {
+  ioopm_list_t *list = list_creators[kind](eq_elem_int);
+
+  for (int i = 0; i < n; i++) {
+    ioopm_linked_list_append(list, int_elem(i));
+  }
+
+  return list;
+}
+
+void count_task(size_t task, void *extra) {
+  __atomic_add_fetch(&((int *)extra)[task], 1, __ATOMIC_RELAXED);
+}
+
+void double_value(elem_t *value, void *extra) {
+  value->integer *= 2;
+}
+
+bool is_less_than(elem_t value, void *extra) {
+  __atomic_add_fetch((int *)extra + 1, 1, __ATOMIC_RELAXED);
+  return value.integer < *(int *)extra;
+}
+
+bool is_even(elem_t value, void *extra) {
+  return value.integer % 2 == 0;
+}
+
+elem_t add(elem_t a, elem_t b, void *extra) {
+  return int_elem(a.integer + b.integer);
+}
+
+/// @brief Keeps the last value that is not -1, which is associative but not commutative
+elem_t keep_last(elem_t a, elem_t b, void *extra) {
+  return b.integer == -1 ? a : b;
+}
+
+void test_thread_pool() {
+  int counts[1000] = { 0 };
+
+  CU_ASSERT_EQUAL(ioopm_thread_pool_size(pool), THREADS);
+
+  // The threads are reused between runs, and every task runs once per run
+  for (int run = 0; run < 20; run++) {
+    ioopm_thread_pool_run(pool, count_task, 1000, counts);
+  }
+
+  ioopm_thread_pool_run(pool, count_task, 0, counts);
+
+  for (int i = 0; i < 1000; i++) {
+    CU_ASSERT_EQUAL(counts[i], 20);
+  }
+
+  // A pool of one thread runs everything on the calling thread
+  ioopm_thread_pool_t *single = ioopm_thread_pool_create(1);
+
+  ioopm_thread_pool_run(single, count_task, 1000, counts);
+  CU_ASSERT_EQUAL(counts[999], 21);
+
+  ioopm_thread_pool_destroy(single);
+
+  single = ioopm_thread_pool_create(0);
+  CU_ASSERT_TRUE(ioopm_thread_pool_size(single) >= 1);
+  ioopm_thread_pool_destroy(single);
+}
+
+void test_parallel_apply_to_all() {
+  for (size_t kind = 0; kind < 3; kind++) {
+    ioopm_list_t *list = create_range(kind, 1000);
+
+    ioopm_linked_list_parallel_apply_to_all(pool, list, double_value, NULL);
+
+    for (int i = 0; i < 1000; i++) {
+      CU_ASSERT_EQUAL(ioopm_linked_list_get(list, i).integer, i * 2);
+    }
+
+    ioopm_linked_list_destroy(list);
+  }
+
+  // Fewer elements than segments
+  ioopm_list_t *list = create_range(0, 3);
+
+  ioopm_linked_list_parallel_apply_to_all(pool, list, double_value, NULL);
+  CU_ASSERT_EQUAL(ioopm_linked_list_get(list, 2).integer, 4);
+
+  ioopm_linked_list_clear(list);
+  ioopm_linked_list_parallel_apply_to_all(pool, list, double_value, NULL);
+
+  ioopm_linked_list_destroy(list);
+}
+
+void test_parallel_any_all() {
+  for (size_t kind = 0; kind < 3; kind++) {
+    ioopm_list_t *list = create_range(kind, 100000);
+    // The limit followed by the amount of calls of is_less_than
+    int extra[2] = { 100000, 0 };
+
+    CU_ASSERT_TRUE(ioopm_linked_list_parallel_all(pool, list, is_less_than, extra));
+    CU_ASSERT_EQUAL(extra[1], 100000);
+
+    extra[0] = 99999;
+    CU_ASSERT_FALSE(ioopm_linked_list_parallel_all(pool, list, is_less_than, extra));
+    CU_ASSERT_TRUE(ioopm_linked_list_parallel_any(pool, list, is_less_than, extra));
+
+    // The threads stop once the first element is found
+    extra[0] = 1;
+    extra[1] = 0;
+    CU_ASSERT_TRUE(ioopm_linked_list_parallel_any(pool, list, is_less_than, extra));
+    CU_ASSERT_TRUE(extra[1] < 100000);
+
+    extra[0] = 0;
+    CU_ASSERT_FALSE(ioopm_linked_list_parallel_any(pool, list, is_less_than, extra));
+
+    ioopm_linked_list_clear(list);
+    CU_ASSERT_FALSE(ioopm_linked_list_parallel_any(pool, list, is_less_than, extra));
+    CU_ASSERT_TRUE(ioopm_linked_list_parallel_all(pool, list, is_less_than, extra));
+
+    ioopm_linked_list_destroy(list);
+  }
+}
+
+void test_parallel_filter() {
+  for (size_t kind = 0; kind < 3; kind++) {
+    ioopm_list_t *list = create_range(kind, 1001);
+    ioopm_list_t *even = ioopm_linked_list_parallel_filter(pool, list, is_even, NULL);
+
+    CU_ASSERT_EQUAL(ioopm_linked_list_size(even), 501);
+    CU_ASSERT_EQUAL(ioopm_linked_list_size(list), 1001);
+
+    for (int i = 0; i <= 500; i++) {
+      CU_ASSERT_EQUAL(ioopm_linked_list_get(even, i).integer, i * 2);
+    }
+
+    CU_ASSERT_TRUE(ioopm_linked_list_contains(even, int_elem(1000)));
+
+    ioopm_linked_list_clear(list);
+
+    ioopm_list_t *empty = ioopm_linked_list_parallel_filter(pool, list, is_even, NULL);
+    CU_ASSERT_TRUE(ioopm_linked_list_is_empty(empty));
+
+    ioopm_linked_list_destroy(list);
+    ioopm_linked_list_destroy(even);
+    ioopm_linked_list_destroy(empty);
+  }
+}
+
+void test_parallel_reduce() {
+  for (size_t kind = 0; kind < 3; kind++) {
+    ioopm_list_t *list = create_range(kind, 1000);
+
+    CU_ASSERT_EQUAL(ioopm_linked_list_parallel_reduce(pool, list, int_elem(0), add, NULL).integer, 999 * 1000 / 2);
+
+    // The segments are combined in order
+    CU_ASSERT_EQUAL(ioopm_linked_list_parallel_reduce(pool, list, int_elem(-1), keep_last, NULL).integer, 999);
+
+    ioopm_linked_list_clear(list);
+    CU_ASSERT_EQUAL(ioopm_linked_list_parallel_reduce(pool, list, int_elem(0), add, NULL).integer, 0);
+
+    ioopm_linked_list_destroy(list);
+  }
+}
+
+int main() {
+  CU_pSuite test_suite1 = NULL;
+
+  if (CUE_SUCCESS != CU_initialize_registry())
+    return CU_get_error();
+
+  test_suite1 = CU_add_suite("Parallel list", init_suite, clean_suite);
+  if (NULL == test_suite1) {
+    CU_cleanup_registry();
+    return CU_get_error();
+  }
+
+  if (
+    (NULL == CU_add_test(test_suite1, "it runs every task once on a reused thread pool", test_thread_pool)) ||
+    (NULL == CU_add_test(test_suite1, "it applies a function on all elements in parallel", test_parallel_apply_to_all)) ||
+    (NULL == CU_add_test(test_suite1, "it tests predicates in parallel and stops early", test_parallel_any_all)) ||
+    (NULL == CU_add_test(test_suite1, "it filters a list in parallel and keeps the order", test_parallel_filter)) ||
+    (NULL == CU_add_test(test_suite1, "it reduces a list in parallel in order", test_parallel_reduce))
+  ) {
+    CU_cleanup_registry();
+    return CU_get_error();
+  }
+
+  CU_basic_set_mode(CU_BRM_VERBOSE);  // Detaljerna utav testerna skrivs ut.
+  CU_basic_run_tests();               // Kör alla testen.
+  CU_cleanup_registry();              // Städar upp testerna (avallokerar minnen bland annat)
+  return CU_get_error();              // Returnerar alla fel som hänt
+}
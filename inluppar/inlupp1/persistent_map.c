@@ -0,0 +1,527 @@
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <errno.h>
+
+#include "common.h"
+#include "persistent_map.h"
+#include "linked_list.h"
+
+#define BITS_PER_LEVEL 5
+#define BRANCHING (1 << BITS_PER_LEVEL)
+#define LEVEL_MASK (BRANCHING - 1)
+
+typedef struct node node_t;
+typedef struct leaf leaf_t;
+typedef union slot slot_t;
+
+//@brief a key => value entry stored directly in the slot of a node.
+struct leaf {
+  unsigned long hash; // the hash code of the key, so that it never has to be recalculated
+  elem_t key;         // holds the key
+  elem_t value;       // holds the value
+};
+
+//@brief a slot in a node, either a leaf or a sub-node (see leaf_mask in node_t).
+union slot {
+  leaf_t leaf;
+  node_t *child;
+};
+
+//@brief an immutable trie node, shared between all versions that contains it.
+// Bitmap nodes only allocate slots for the children that are present. The slot for the
+// child at index i (0..31) is found by counting the bits below i in the bitmap (popcount).
+// Collision nodes holds leaves whose keys all have the same hash code.
+struct node {
+  size_t refs;          // How many versions and parent nodes that refers to this node.
+  uint32_t bitmap;      // Which of the 32 children that are present (unused in collision nodes).
+  uint32_t leaf_mask;   // Which slots that are leaves rather than sub-nodes, indexed by slot.
+  uint32_t count;       // The amount of slots.
+  bool collision;       // True if the node is a collision node, in which case all slots are leaves.
+  slot_t slots[];       // The slots, in the same order as the bits in bitmap.
+};
+
+//@brief a version of a map, owning one reference to its root.
+struct persistent_map {
+  node_t *root;                  // The root node (NULL if the map is empty).
+  size_t size;                   // Holds the amount of entries.
+  ioopm_eq_function eq_key;      // equality function for keys.
+  ioopm_eq_function eq_value;    // equality function for the values.
+  ioopm_hash_function hash_func; // The hashing function.
+};
+
+static unsigned long extract_hash_code(elem_t key) {
+  return key.unsigned_long;
+}
+
+static node_t *node_create(uint32_t count) {
+  node_t *node = calloc(1, sizeof(node_t) + count * sizeof(slot_t));
+  node->refs = 1;
+  node->count = count;
+  return node;
+}
+
+static void node_retain(node_t *node) {
+  __atomic_add_fetch(&node->refs, 1, __ATOMIC_RELAXED);
+}
+
+static bool is_leaf(node_t *node, uint32_t pos) {
+  return node->collision || (node->leaf_mask >> pos) & 1;
+}
+
+/// @brief Marks the slot at pos as a leaf (all slots in collision nodes are leaves)
+static void mark_leaf(node_t *node, uint32_t pos) {
+  if (!node->collision) {
+    node->leaf_mask |= 1u << pos;
+  }
+}
+
+static void node_release(node_t *node) {
+  if (__atomic_sub_fetch(&node->refs, 1, __ATOMIC_ACQ_REL) != 0) {
+    return;
+  }
+
+  for (uint32_t pos = 0; pos < node->count; pos++) {
+    if (!is_leaf(node, pos)) {
+      node_release(node->slots[pos].child);
+    }
+  }
+
+  free(node);
+}
+
+/// @brief Calculates the index (0..31) of a hash code on the level at shift
+static uint32_t hash_bit(unsigned long hash, unsigned shift) {
+  return 1u << ((hash >> shift) & LEVEL_MASK);
+}
+
+/// @brief Calculates the slot of the child at bit in a bitmap node
+static uint32_t slot_position(node_t *node, uint32_t bit) {
+  return __builtin_popcount(node->bitmap & (bit - 1));
+}
+
+/// @brief Copies all slots from one node to another, sharing all sub-nodes
+/// @param skip a slot that should not be copied (or count to copy everything)
+/// @param offset how far the slots after skip are moved (0 or -1)
+static void copy_slots(node_t *to, node_t *from, uint32_t skip, int offset) {
+  for (uint32_t pos = 0; pos < from->count; pos++) {
+    if (pos == skip) continue;
+
+    uint32_t to_pos = pos < skip ? pos : pos + offset;
+    to->slots[to_pos] = from->slots[pos];
+
+    if (is_leaf(from, pos)) {
+      mark_leaf(to, to_pos);
+    } else {
+      node_retain(from->slots[pos].child);
+    }
+  }
+}
+
+/// @brief Creates a copy of node where the slot at pos is replaced
+static node_t *node_with_slot_replaced(node_t *node, uint32_t pos, slot_t slot, bool leaf) {
+  node_t *result = node_create(node->count);
+
+  result->bitmap = node->bitmap;
+  result->collision = node->collision;
+  copy_slots(result, node, pos, 0);
+
+  result->slots[pos] = slot;
+
+  if (leaf) {
+    mark_leaf(result, pos);
+  }
+
+  return result;
+}
+
+/// @brief Creates a copy of node with a new leaf inserted at pos
+static node_t *node_with_leaf_inserted(node_t *node, uint32_t bit, uint32_t pos, leaf_t leaf) {
+  node_t *result = node_create(node->count + 1);
+
+  result->bitmap = node->bitmap | bit;
+  result->collision = node->collision;
+
+  // Slots before pos keep their position and the rest are moved one step to the right
+  for (uint32_t i = 0; i < node->count; i++) {
+    uint32_t to_pos = i < pos ? i : i + 1;
+    result->slots[to_pos] = node->slots[i];
+
+    if (is_leaf(node, i)) {
+      mark_leaf(result, to_pos);
+    } else {
+      node_retain(node->slots[i].child);
+    }
+  }
+
+  result->slots[pos].leaf = leaf;
+  mark_leaf(result, pos);
+
+  return result;
+}
+
+/// @brief Creates a copy of node without the slot at pos
+static node_t *node_with_slot_removed(node_t *node, uint32_t bit, uint32_t pos) {
+  node_t *result = node_create(node->count - 1);
+
+  result->bitmap = node->bitmap & ~bit;
+  result->collision = node->collision;
+  copy_slots(result, node, pos, -1);
+
+  return result;
+}
+
+/// @brief Creates a node at shift with two slots, or a chain of single-child nodes
+/// if both hash codes have the same index at shift.
+/// @param a the first slot
+/// @param a_hash the hash code of all keys below a
+/// @param a_leaf true if a is a leaf
+/// @param b a leaf with a different hash code than a_hash
+static node_t *node_branch(slot_t a, unsigned long a_hash, bool a_leaf, leaf_t b, unsigned shift) {
+  uint32_t a_bit = hash_bit(a_hash, shift);
+  uint32_t b_bit = hash_bit(b.hash, shift);
+
+  if (a_bit == b_bit) {
+    node_t *node = node_create(1);
+    node->bitmap = a_bit;
+    node->slots[0].child = node_branch(a, a_hash, a_leaf, b, shift + BITS_PER_LEVEL);
+    return node;
+  }
+
+  node_t *node = node_create(2);
+  uint32_t a_pos = a_bit < b_bit ? 0 : 1;
+  uint32_t b_pos = 1 - a_pos;
+
+  node->bitmap = a_bit | b_bit;
+  node->slots[a_pos] = a;
+  node->slots[b_pos].leaf = b;
+  node->leaf_mask = (a_leaf ? 1u << a_pos : 0) | 1u << b_pos;
+
+  return node;
+}
+
+/// @brief Creates a sub-node holding two leaves with different keys
+static node_t *node_merge_leaves(leaf_t a, leaf_t b, unsigned shift) {
+  if (a.hash == b.hash) {
+    node_t *node = node_create(2);
+    node->collision = true;
+    node->slots[0].leaf = a;
+    node->slots[1].leaf = b;
+    return node;
+  }
+
+  return node_branch((slot_t){ .leaf = a }, a.hash, true, b, shift);
+}
+
+/// @brief Inserts a leaf below node
+/// @param added set to true if the key did not exist previously
+/// @return a new node with the leaf inserted (node is left unchanged)
+static node_t *node_insert(node_t *node, unsigned shift, leaf_t leaf, ioopm_eq_function eq_key, bool *added) {
+  if (node->collision) {
+    unsigned long collision_hash = node->slots[0].leaf.hash;
+
+    if (collision_hash != leaf.hash) {
+      // The new key does not collide, so the collision node is pushed one level down
+      *added = true;
+      node_retain(node);
+      return node_branch((slot_t){ .child = node }, collision_hash, false, leaf, shift);
+    }
+
+    for (uint32_t pos = 0; pos < node->count; pos++) {
+      if (eq_key(node->slots[pos].leaf.key, leaf.key)) {
+        *added = false;
+        return node_with_slot_replaced(node, pos, (slot_t){ .leaf = leaf }, true);
+      }
+    }
+
+    *added = true;
+    return node_with_leaf_inserted(node, 0, node->count, leaf);
+  }
+
+  uint32_t bit = hash_bit(leaf.hash, shift);
+  uint32_t pos = slot_position(node, bit);
+
+  if ((node->bitmap & bit) == 0) {
+    *added = true;
+    return node_with_leaf_inserted(node, bit, pos, leaf);
+  }
+
+  if (is_leaf(node, pos)) {
+    leaf_t existing = node->slots[pos].leaf;
+
+    if (existing.hash == leaf.hash && eq_key(existing.key, leaf.key)) {
+      *added = false;
+      return node_with_slot_replaced(node, pos, (slot_t){ .leaf = leaf }, true);
+    }
+
+    *added = true;
+    node_t *child = node_merge_leaves(existing, leaf, shift + BITS_PER_LEVEL);
+    return node_with_slot_replaced(node, pos, (slot_t){ .child = child }, false);
+  }
+
+  node_t *child = node_insert(node->slots[pos].child, shift + BITS_PER_LEVEL, leaf, eq_key, added);
+  return node_with_slot_replaced(node, pos, (slot_t){ .child = child }, false);
+}
+
+/// @brief Removes a key below node
+/// @param removed set to false if the key does not exist, in which case NULL is returned
+/// @return a new node without the key (node is left unchanged), or NULL if it would be empty
+static node_t *node_remove(
+  node_t *node,
+  unsigned shift,
+  unsigned long hash,
+  elem_t key,
+  ioopm_eq_function eq_key,
+  bool *removed
+) {
+  *removed = false;
+
+  if (node->collision) {
+    for (uint32_t pos = 0; pos < node->count; pos++) {
+      if (node->slots[pos].leaf.hash == hash && eq_key(node->slots[pos].leaf.key, key)) {
+        *removed = true;
+        return node_with_slot_removed(node, 0, pos);
+      }
+    }
+
+    return NULL;
+  }
+
+  uint32_t bit = hash_bit(hash, shift);
+  uint32_t pos = slot_position(node, bit);
+
+  if ((node->bitmap & bit) == 0) {
+    return NULL;
+  }
+
+  if (is_leaf(node, pos)) {
+    leaf_t existing = node->slots[pos].leaf;
+
+    if (existing.hash != hash || !eq_key(existing.key, key)) {
+      return NULL;
+    }
+
+    *removed = true;
+    return node->count == 1 ? NULL : node_with_slot_removed(node, bit, pos);
+  }
+
+  node_t *child = node_remove(node->slots[pos].child, shift + BITS_PER_LEVEL, hash, key, eq_key, removed);
+
+  if (!*removed) {
+    return NULL;
+  }
+
+  if (child == NULL) {
+    return node->count == 1 ? NULL : node_with_slot_removed(node, bit, pos);
+  }
+
+  if (child->count == 1 && is_leaf(child, 0)) {
+    // Sub-nodes with a single leaf are collapsed into the leaf, to keep the trie shallow
+    leaf_t leaf = child->slots[0].leaf;
+    node_release(child);
+    return node_with_slot_replaced(node, pos, (slot_t){ .leaf = leaf }, true);
+  }
+
+  return node_with_slot_replaced(node, pos, (slot_t){ .child = child }, false);
+}
+
+/// @brief Finds the leaf for a key, or NULL if it does not exist
+static leaf_t *find_leaf(ioopm_persistent_map_t *map, elem_t key) {
+  unsigned long hash = map->hash_func(key);
+  node_t *node = map->root;
+  unsigned shift = 0;
+
+  while (node != NULL) {
+    if (node->collision) {
+      for (uint32_t pos = 0; pos < node->count; pos++) {
+        leaf_t *leaf = &node->slots[pos].leaf;
+        if (leaf->hash == hash && map->eq_key(leaf->key, key)) return leaf;
+      }
+
+      return NULL;
+    }
+
+    uint32_t bit = hash_bit(hash, shift);
+
+    if ((node->bitmap & bit) == 0) {
+      return NULL;
+    }
+
+    uint32_t pos = slot_position(node, bit);
+
+    if (is_leaf(node, pos)) {
+      leaf_t *leaf = &node->slots[pos].leaf;
+      return leaf->hash == hash && map->eq_key(leaf->key, key) ? leaf : NULL;
+    }
+
+    node = node->slots[pos].child;
+    shift += BITS_PER_LEVEL;
+  }
+
+  return NULL;
+}
+
+static bool node_any(node_t *node, ioopm_predicate pred, void *arg) {
+  for (uint32_t pos = 0; pos < node->count; pos++) {
+    if (is_leaf(node, pos)) {
+      if (pred(node->slots[pos].leaf.key, node->slots[pos].leaf.value, arg)) return true;
+    } else if (node_any(node->slots[pos].child, pred, arg)) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+/// @brief Used in conjuction with any to insert keys into a linked list
+/// @param x a pointer to a linked list
+static bool append_key_to_list(elem_t key, elem_t value, void *x) {
+  ioopm_linked_list_append(x, key);
+  return false;
+}
+
+/// @brief Used in conjuction with any to insert values into a linked list
+/// @param x a pointer to a linked list
+static bool append_value_to_list(elem_t key, elem_t value, void *x) {
+  ioopm_linked_list_append(x, value);
+  return false;
+}
+
+//@brief the predicate and argument used when implementing all using any.
+typedef struct negated_predicate {
+  ioopm_predicate pred;
+  void *arg;
+} negated_predicate_t;
+
+static bool negate_pred(elem_t key, elem_t value, void *x) {
+  negated_predicate_t *negated = x;
+  return !negated->pred(key, value, negated->arg);
+}
+
+/// @brief Creates a new version that takes over a reference to root
+static ioopm_persistent_map_t *map_create(ioopm_persistent_map_t *map, node_t *root, size_t size) {
+  ioopm_persistent_map_t *result = calloc(1, sizeof(ioopm_persistent_map_t));
+
+  *result = (ioopm_persistent_map_t){
+    .root = root,
+    .size = size,
+    .eq_key = map->eq_key,
+    .eq_value = map->eq_value,
+    .hash_func = map->hash_func,
+  };
+
+  return result;
+}
+
+ioopm_persistent_map_t *ioopm_persistent_map_create(
+  ioopm_eq_function eq_key,
+  ioopm_eq_function eq_value,
+  ioopm_hash_function hash_func
+) {
+  ioopm_persistent_map_t template = {
+    .eq_key = eq_key,
+    .eq_value = eq_value,
+    // If the user did not provide a hash func, default to the integer value
+    .hash_func = hash_func == NULL ? extract_hash_code : hash_func,
+  };
+
+  return map_create(&template, NULL, 0);
+}
+
+void ioopm_persistent_map_destroy(ioopm_persistent_map_t *map) {
+  if (map->root != NULL) {
+    node_release(map->root);
+  }
+
+  free(map);
+}
+
+ioopm_persistent_map_t *ioopm_persistent_map_snapshot(ioopm_persistent_map_t *map) {
+  if (map->root != NULL) {
+    node_retain(map->root);
+  }
+
+  return map_create(map, map->root, map->size);
+}
+
+ioopm_persistent_map_t *ioopm_persistent_map_insert(ioopm_persistent_map_t *map, elem_t key, elem_t value) {
+  leaf_t leaf = { .hash = map->hash_func(key), .key = key, .value = value };
+
+  if (map->root == NULL) {
+    node_t *root = node_create(1);
+    root->bitmap = hash_bit(leaf.hash, 0);
+    root->leaf_mask = 1;
+    root->slots[0].leaf = leaf;
+
+    return map_create(map, root, 1);
+  }
+
+  bool added;
+  node_t *root = node_insert(map->root, 0, leaf, map->eq_key, &added);
+
+  return map_create(map, root, added ? map->size + 1 : map->size);
+}
+
+ioopm_persistent_map_t *ioopm_persistent_map_remove(ioopm_persistent_map_t *map, elem_t key) {
+  bool removed = false;
+  node_t *root = NULL;
+
+  if (map->root != NULL) {
+    root = node_remove(map->root, 0, map->hash_func(key), key, map->eq_key, &removed);
+  }
+
+  if (!removed) {
+    // Nothing changed, so the new version simply shares the root with the old one
+    ioopm_persistent_map_t *result = ioopm_persistent_map_snapshot(map);
+    FAILURE();
+    return result;
+  }
+
+  SUCCESS();
+  return map_create(map, root, map->size - 1);
+}
+
+elem_t ioopm_persistent_map_lookup(ioopm_persistent_map_t *map, elem_t key) {
+  leaf_t *leaf = find_leaf(map, key);
+
+  if (leaf == NULL) {
+    FAILURE();
+    return ptr_elem(NULL);
+  }
+
+  SUCCESS();
+  return leaf->value;
+}
+
+bool ioopm_persistent_map_has_key(ioopm_persistent_map_t *map, elem_t key) {
+  return find_leaf(map, key) != NULL;
+}
+
+size_t ioopm_persistent_map_size(ioopm_persistent_map_t *map) {
+  return map->size;
+}
+
+bool ioopm_persistent_map_is_empty(ioopm_persistent_map_t *map) {
+  return map->size == 0;
+}
+
+ioopm_list_t *ioopm_persistent_map_keys(ioopm_persistent_map_t *map) {
+  ioopm_list_t *list = ioopm_linked_list_create(map->eq_key);
+  ioopm_persistent_map_any(map, append_key_to_list, list);
+  return list;
+}
+
+ioopm_list_t *ioopm_persistent_map_values(ioopm_persistent_map_t *map) {
+  ioopm_list_t *list = ioopm_linked_list_create(map->eq_value);
+  ioopm_persistent_map_any(map, append_value_to_list, list);
+  return list;
+}
+
+bool ioopm_persistent_map_any(ioopm_persistent_map_t *map, ioopm_predicate pred, void *arg) {
+  return map->root != NULL && node_any(map->root, pred, arg);
+}
+
+bool ioopm_persistent_map_all(ioopm_persistent_map_t *map, ioopm_predicate pred, void *arg) {
+  negated_predicate_t negated = { .pred = pred, .arg = arg };
+  return !ioopm_persistent_map_any(map, negate_pred, &negated);
+}
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <stdbool.h>
+
+#include "common.h"
+#include "hash_table.h"
+#include "linked_list.h"
+
+/**
+ * @file persistent_map.h
+ * @author Fredrik Engstrand, Alex Alstergren
+ * @date 19 October 2026
+ * @brief Persistent (immutable) map implemented as a hash array mapped trie.
+ *
+ * Every modification returns a new version of the map and leaves the old version untouched.
+ * Versions share all nodes that were not changed, which means that taking a snapshot is O(1)
+ * and that insert and remove only copies the O(log32 n) nodes on the path to the key.
+ * Each version must be destroyed separately; the nodes are deallocated when the last version
+ * that uses them is destroyed. Versions can be read and destroyed from multiple threads.
+ */
+
+typedef struct persistent_map ioopm_persistent_map_t;
+
+/// @brief Create a new empty persistent map
+/// @param eq_key the function used to compare two keys in the map
+/// @param eq_value the function used to compare two values in the map
+/// @param hash_func the function used to create a hash code from the key
+///        if NULL, it fallbacks to extracting an integer value from your key
+/// @return A new empty map
+ioopm_persistent_map_t *ioopm_persistent_map_create(
+  ioopm_eq_function eq_key,
+  ioopm_eq_function eq_value,
+  ioopm_hash_function hash_func
+);
+
+/// @brief Destroy a version of a map
+/// Other versions of the same map are not affected. Like the hash table, the map does not
+/// deallocate memory that is pointed to by keys or values.
+/// @param map the version to be destroyed
+void ioopm_persistent_map_destroy(ioopm_persistent_map_t *map);
+
+/// @brief Take a snapshot of a map in O(1) time
+/// @param map the map operated upon
+/// @return a new version with the same entries as map
+ioopm_persistent_map_t *ioopm_persistent_map_snapshot(ioopm_persistent_map_t *map);
+
+/// @brief add key => value entry to a map in O(log32 n) time
+/// @param map the map operated upon (left unchanged)
+/// @param key key to insert
+/// @param value value to insert
+/// @return a new version where key maps to value
+ioopm_persistent_map_t *ioopm_persistent_map_insert(ioopm_persistent_map_t *map, elem_t key, elem_t value);
+
+/// @brief remove any mapping from key to a value in O(log32 n) time
+/// @param map the map operated upon (left unchanged)
+/// @param key key to remove
+/// @return a new version without key, errno is set to EINVAL if key does not exist
+ioopm_persistent_map_t *ioopm_persistent_map_remove(ioopm_persistent_map_t *map, elem_t key);
+
+/// @brief lookup value for key in a map
+/// @param map the map operated upon
+/// @param key key to lookup
+/// @return the value mapped to by key or it sets errno to EINVAL if key does not exist
+elem_t ioopm_persistent_map_lookup(ioopm_persistent_map_t *map, elem_t key);
+
+/// @brief check if a map has an entry with a given key
+/// @param map the map operated upon
+/// @param key the key sought
+bool ioopm_persistent_map_has_key(ioopm_persistent_map_t *map, elem_t key);
+
+/// @brief returns the number of key => value entries in a map in O(1) time
+/// @param map the map operated upon
+size_t ioopm_persistent_map_size(ioopm_persistent_map_t *map);
+
+/// @brief checks if a map is empty
+/// @param map the map operated upon
+/// @return true if size == 0, else false
+bool ioopm_persistent_map_is_empty(ioopm_persistent_map_t *map);
+
+/// @brief return the keys for all entries in a map (in no particular order, but same as ioopm_persistent_map_values)
+/// @param map the map operated upon
+/// @return a linked list with all the keys in the map
+ioopm_list_t *ioopm_persistent_map_keys(ioopm_persistent_map_t *map);
+
+/// @brief return the values for all entries in a map (in no particular order, but same as ioopm_persistent_map_keys)
+/// @param map the map operated upon
+/// @return a linked list with all the values in the map
+ioopm_list_t *ioopm_persistent_map_values(ioopm_persistent_map_t *map);
+
+/// @brief check if a predicate is satisfied by any entry in a map
+/// @param map the map operated upon
+/// @param pred the predicate
+/// @param arg extra argument to pred
+bool ioopm_persistent_map_any(ioopm_persistent_map_t *map, ioopm_predicate pred, void *arg);
+
+/// @brief check if a predicate is satisfied by all entries in a map
+/// @param map the map operated upon
+/// @param pred the predicate
+/// @param arg extra argument to pred
+/// @return true if all entries matches the predicate or if the map is empty
+bool ioopm_persistent_map_all(ioopm_persistent_map_t *map, ioopm_predicate pred, void *arg);
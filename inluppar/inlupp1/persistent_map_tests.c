@@ -0,0 +1,233 @@
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <CUnit/Basic.h>
+
+#include "common.h"
+#include "persistent_map.h"
+#include "linked_list.h"
+
+int init_suite(void) {
+  return 0;
+}
+
+int clean_suite(void) {
+  return 0;
+}
+
+// Makes every key collide, to test the collision nodes
+unsigned long constant_hash(elem_t key) {
+  return 42;
+}
+
+bool value_is_positive(elem_t key, elem_t value, void *x) {
+  return value.integer > 0;
+}
+
+void assert_lookup(ioopm_persistent_map_t *map, elem_t key, int value, bool should_have_error) {
+  elem_t lookup_value = ioopm_persistent_map_lookup(map, key);
+
+  CU_ASSERT_EQUAL(HAS_ERROR(), should_have_error);
+
+  if (!should_have_error) {
+    CU_ASSERT_TRUE(eq_elem_int(lookup_value, int_elem(value)));
+  }
+}
+
+// Replaces the map with a new version where key maps to value
+void insert(ioopm_persistent_map_t **map, elem_t key, elem_t value) {
+  ioopm_persistent_map_t *result = ioopm_persistent_map_insert(*map, key, value);
+  ioopm_persistent_map_destroy(*map);
+  *map = result;
+}
+
+// Replaces the map with a new version without key
+void remove_key(ioopm_persistent_map_t **map, elem_t key) {
+  ioopm_persistent_map_t *result = ioopm_persistent_map_remove(*map, key);
+  ioopm_persistent_map_destroy(*map);
+  *map = result;
+}
+
+void test_create_destroy() {
+  ioopm_persistent_map_t *map = ioopm_persistent_map_create(eq_elem_int, eq_elem_int, NULL);
+
+  CU_ASSERT_PTR_NOT_NULL(map);
+  CU_ASSERT_TRUE(ioopm_persistent_map_is_empty(map));
+  assert_lookup(map, int_elem(0), 0, true);
+
+  ioopm_persistent_map_destroy(map);
+}
+
+void test_insert_lookup() {
+  ioopm_persistent_map_t *map = ioopm_persistent_map_create(eq_elem_int, eq_elem_int, NULL);
+
+  insert(&map, int_elem(1), int_elem(10));
+  insert(&map, int_elem(2), int_elem(20));
+  insert(&map, int_elem(33), int_elem(330)); // 33 and 1 share the index on the first level
+
+  assert_lookup(map, int_elem(1), 10, false);
+  assert_lookup(map, int_elem(2), 20, false);
+  assert_lookup(map, int_elem(33), 330, false);
+  assert_lookup(map, int_elem(3), 0, true);
+  CU_ASSERT_EQUAL(ioopm_persistent_map_size(map), 3);
+
+  // Inserting an existing key replaces the value without changing the size
+  insert(&map, int_elem(33), int_elem(333));
+  assert_lookup(map, int_elem(33), 333, false);
+  CU_ASSERT_EQUAL(ioopm_persistent_map_size(map), 3);
+
+  ioopm_persistent_map_destroy(map);
+}
+
+void test_versions_are_independent() {
+  ioopm_persistent_map_t *empty = ioopm_persistent_map_create(eq_elem_int, eq_elem_int, NULL);
+  ioopm_persistent_map_t *v1 = ioopm_persistent_map_insert(empty, int_elem(1), int_elem(10));
+  ioopm_persistent_map_t *v2 = ioopm_persistent_map_insert(v1, int_elem(1), int_elem(11));
+  ioopm_persistent_map_t *v3 = ioopm_persistent_map_remove(v2, int_elem(1));
+
+  assert_lookup(empty, int_elem(1), 0, true);
+  assert_lookup(v1, int_elem(1), 10, false);
+  assert_lookup(v2, int_elem(1), 11, false);
+  assert_lookup(v3, int_elem(1), 0, true);
+
+  // Destroying a version does not affect the versions that shares nodes with it
+  ioopm_persistent_map_destroy(v2);
+  assert_lookup(v1, int_elem(1), 10, false);
+
+  ioopm_persistent_map_destroy(empty);
+  ioopm_persistent_map_destroy(v1);
+  ioopm_persistent_map_destroy(v3);
+}
+
+void test_snapshot() {
+  ioopm_persistent_map_t *map = ioopm_persistent_map_create(eq_elem_int, eq_elem_int, NULL);
+
+  for (int i = 0; i < 100; i++) {
+    insert(&map, int_elem(i), int_elem(i));
+  }
+
+  ioopm_persistent_map_t *snapshot = ioopm_persistent_map_snapshot(map);
+
+  // Keep writing to the map after the snapshot was taken
+  for (int i = 0; i < 100; i++) {
+    insert(&map, int_elem(i), int_elem(-i));
+  }
+
+  for (int i = 0; i < 100; i++) {
+    assert_lookup(snapshot, int_elem(i), i, false);
+    assert_lookup(map, int_elem(i), -i, false);
+  }
+
+  CU_ASSERT_EQUAL(ioopm_persistent_map_size(snapshot), 100);
+
+  ioopm_persistent_map_destroy(map);
+  ioopm_persistent_map_destroy(snapshot);
+}
+
+void test_remove() {
+  ioopm_persistent_map_t *map = ioopm_persistent_map_create(eq_elem_int, eq_elem_int, NULL);
+
+  remove_key(&map, int_elem(1));
+  CU_ASSERT_TRUE(HAS_ERROR());
+
+  for (int i = 0; i < 2000; i++) {
+    insert(&map, int_elem(i), int_elem(i));
+  }
+
+  for (int i = 0; i < 2000; i += 2) {
+    remove_key(&map, int_elem(i));
+    CU_ASSERT_FALSE(HAS_ERROR());
+  }
+
+  CU_ASSERT_EQUAL(ioopm_persistent_map_size(map), 1000);
+
+  for (int i = 0; i < 2000; i++) {
+    assert_lookup(map, int_elem(i), i, i % 2 == 0);
+  }
+
+  for (int i = 1; i < 2000; i += 2) {
+    remove_key(&map, int_elem(i));
+  }
+
+  CU_ASSERT_TRUE(ioopm_persistent_map_is_empty(map));
+
+  ioopm_persistent_map_destroy(map);
+}
+
+void test_collisions() {
+  ioopm_persistent_map_t *map = ioopm_persistent_map_create(eq_elem_int, eq_elem_int, constant_hash);
+
+  for (int i = 0; i < 50; i++) {
+    insert(&map, int_elem(i), int_elem(i));
+  }
+
+  for (int i = 0; i < 50; i++) {
+    assert_lookup(map, int_elem(i), i, false);
+  }
+
+  remove_key(&map, int_elem(25));
+  assert_lookup(map, int_elem(25), 0, true);
+  assert_lookup(map, int_elem(26), 26, false);
+  CU_ASSERT_EQUAL(ioopm_persistent_map_size(map), 49);
+
+  ioopm_persistent_map_destroy(map);
+}
+
+void test_keys_values() {
+  ioopm_persistent_map_t *map = ioopm_persistent_map_create(eq_elem_int, eq_elem_int, NULL);
+
+  for (int i = 1; i <= 100; i++) {
+    insert(&map, int_elem(i), int_elem(i * 10));
+  }
+
+  ioopm_list_t *keys = ioopm_persistent_map_keys(map);
+  ioopm_list_t *values = ioopm_persistent_map_values(map);
+
+  CU_ASSERT_EQUAL(ioopm_linked_list_size(keys), 100);
+  CU_ASSERT_EQUAL(ioopm_linked_list_size(values), 100);
+
+  // Keys and values are returned in the same order
+  for (int i = 0; i < 100; i++) {
+    CU_ASSERT_EQUAL(ioopm_linked_list_get(keys, i).integer * 10, ioopm_linked_list_get(values, i).integer);
+  }
+
+  CU_ASSERT_TRUE(ioopm_persistent_map_all(map, value_is_positive, NULL));
+  insert(&map, int_elem(0), int_elem(0));
+  CU_ASSERT_FALSE(ioopm_persistent_map_all(map, value_is_positive, NULL));
+  CU_ASSERT_TRUE(ioopm_persistent_map_any(map, value_is_positive, NULL));
+
+  ioopm_linked_list_destroy(keys);
+  ioopm_linked_list_destroy(values);
+  ioopm_persistent_map_destroy(map);
+}
+
+int main() {
+  CU_pSuite test_suite1 = NULL;
+
+  if (CUE_SUCCESS != CU_initialize_registry())
+    return CU_get_error();
+
+  test_suite1 = CU_add_suite("Persistent map", init_suite, clean_suite);
+  if (NULL == test_suite1) {
+    CU_cleanup_registry();
+    return CU_get_error();
+  }
+
+  if (
+    (NULL == CU_add_test(test_suite1, "it creates and returns a pointer to an empty map", test_create_destroy)) ||
+    (NULL == CU_add_test(test_suite1, "it inserts, replaces and looks up entries", test_insert_lookup)) ||
+    (NULL == CU_add_test(test_suite1, "it leaves previous versions unchanged", test_versions_are_independent)) ||
+    (NULL == CU_add_test(test_suite1, "it keeps snapshots unchanged while writing to the map", test_snapshot)) ||
+    (NULL == CU_add_test(test_suite1, "it removes entries and gives an error for invalid keys", test_remove)) ||
+    (NULL == CU_add_test(test_suite1, "it handles keys with colliding hash codes", test_collisions)) ||
+    (NULL == CU_add_test(test_suite1, "it returns synced key and value lists and applies predicates", test_keys_values))
+  ) {
+    CU_cleanup_registry();
+    return CU_get_error();
+  }
+
+  CU_basic_set_mode(CU_BRM_VERBOSE);  // Detaljerna utav testerna skrivs ut.
+  CU_basic_run_tests();               // Kör alla testen.
+  CU_cleanup_registry();              // Städar upp testerna (avallokerar minnen bland annat)
+  return CU_get_error();              // Returnerar alla fel som hänt
+}
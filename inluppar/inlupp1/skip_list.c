@@ -0,0 +1,389 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "common.h"
+#include "skip_list.h"
+
+#define MAX_LEVEL 32
+
+typedef struct node node_t;
+typedef struct skip_link skip_link_t;
+
+//@brief a link on one level, with the amount of positions it skips.
+struct skip_link {
+  node_t *next;  // The next node on the level (possibly NULL).
+  size_t width;  // The position of next minus the position of the node (unused if next is NULL).
+};
+
+//@brief an element, with one link for each level it is on.
+struct node {
+  elem_t value;
+  skip_link_t forward[];
+};
+
+struct skip_list {
+  node_t *head;                        // A dummy node with a link on every level.
+  size_t level;                        // The amount of levels in use (at least 1).
+  size_t size;                         // The amount of elements in the list.
+  size_t head_position;                // The position that links from the head are counted from.
+  node_t *last[MAX_LEVEL];             // The last node on each level (the head if the level is empty).
+  size_t last_distance[MAX_LEVEL];     // The position of each last node minus head_position.
+  node_t *finger;                      // The node of the last get (NULL if not known).
+  size_t finger_index;                 // The index of finger.
+  uint64_t random;                     // State of the random generator for node heights.
+};
+
+/// @brief Picks the amount of levels of a new node, where each level has a chance of 1/4 to be added
+static size_t random_height(skip_list_t *list) {
+  // xorshift64
+  uint64_t bits = list->random;
+  bits ^= bits << 13;
+  bits ^= bits >> 7;
+  bits ^= bits << 17;
+  list->random = bits;
+
+  size_t height = 1;
+
+  while ((bits & 3) == 0 && height < MAX_LEVEL) {
+    height++;
+    bits >>= 2;
+  }
+
+  return height;
+}
+
+static node_t *node_create(elem_t value, size_t height) {
+  node_t *node = malloc(sizeof(node_t) + height * sizeof(skip_link_t));
+
+  node->value = value;
+
+  return node;
+}
+
+/// @brief Makes the list empty, without deallocating any nodes
+static void reset(skip_list_t *list) {
+  memset(list->head->forward, 0, MAX_LEVEL * sizeof(skip_link_t));
+
+  list->level = 1;
+  list->size = 0;
+  list->head_position = (size_t)-1;
+  list->finger = NULL;
+
+  for (size_t l = 0; l < MAX_LEVEL; l++) {
+    list->last[l] = list->head;
+    list->last_distance[l] = 0;
+  }
+}
+
+/// @brief Finds the node before index on every level in use
+/// Positions are compared after adding a width, since the head position may be "negative".
+/// @param update set to the node before index on each level
+/// @param positions set to the position of each node in update
+/// @return the node at index (NULL if index is n)
+static node_t *find(skip_list_t *list, size_t index, node_t **update, size_t *positions) {
+  node_t *node = list->head;
+  size_t position = list->head_position;
+
+  for (size_t l = list->level; l-- > 0; ) {
+    while (node->forward[l].next != NULL && position + node->forward[l].width < index) {
+      position += node->forward[l].width;
+      node = node->forward[l].next;
+    }
+
+    update[l] = node;
+    positions[l] = position;
+  }
+
+  return node->forward[0].next;
+}
+
+skip_list_t *skip_list_create() {
+  skip_list_t *list = calloc(1, sizeof(skip_list_t));
+
+  list->head = calloc(1, sizeof(node_t) + MAX_LEVEL * sizeof(skip_link_t));
+  list->random = random_seed() | 1;
+  reset(list);
+
+  return list;
+}
+
+static void skip_append(void *storage, elem_t value) {
+  skip_list_t *list = storage;
+  size_t height = random_height(list);
+  size_t distance = list->size - list->head_position;
+  node_t *node = node_create(value, height);
+
+  // Only the last node of each level of the new node changes
+  for (size_t l = 0; l < height; l++) {
+    list->last[l]->forward[l] = (skip_link_t){ .next = node, .width = distance - list->last_distance[l] };
+    node->forward[l] = (skip_link_t){ .next = NULL };
+
+    list->last[l] = node;
+    list->last_distance[l] = distance;
+  }
+
+  if (height > list->level) {
+    list->level = height;
+  }
+
+  list->size++;
+}
+
+static void skip_append_array(void *storage, elem_t *values, size_t n) {
+  // Every append is O(1) expected time already, since only the last node of each level changes
+  for (size_t i = 0; i < n; i++) {
+    skip_append(storage, values[i]);
+  }
+}
+
+static void skip_prepend(void *storage, elem_t value) {
+  skip_list_t *list = storage;
+  size_t height = random_height(list);
+  node_t *node = node_create(value, height);
+
+  // Every element moves one position, which the head position makes up for instead of all head links
+  list->head_position++;
+
+  size_t distance = 0 - list->head_position;
+
+  for (size_t l = 0; l < height; l++) {
+    skip_link_t first = list->head->forward[l];
+
+    node->forward[l] = (skip_link_t){ .next = first.next, .width = first.width - distance };
+    list->head->forward[l] = (skip_link_t){ .next = node, .width = distance };
+
+    if (first.next == NULL) {
+      list->last[l] = node;
+      list->last_distance[l] = distance;
+    }
+  }
+
+  if (height > list->level) {
+    list->level = height;
+  }
+
+  list->size++;
+  list->finger = NULL;
+}
+
+static void skip_insert(void *storage, size_t index, elem_t value) {
+  skip_list_t *list = storage;
+
+  if (index == list->size) {
+    skip_append(list, value);
+    return;
+  }
+
+  if (index == 0) {
+    skip_prepend(list, value);
+    return;
+  }
+
+  node_t *update[MAX_LEVEL];
+  size_t positions[MAX_LEVEL];
+  size_t height = random_height(list);
+  node_t *node = node_create(value, height);
+
+  find(list, index, update, positions);
+
+  for (size_t l = list->level; l < height; l++) {
+    update[l] = list->head;
+    positions[l] = list->head_position;
+  }
+
+  if (height > list->level) {
+    list->level = height;
+  }
+
+  // The last nodes at or after index move one position
+  for (size_t l = 0; l < list->level; l++) {
+    if (list->last[l] != list->head && list->head_position + list->last_distance[l] >= index) {
+      list->last_distance[l]++;
+    }
+  }
+
+  for (size_t l = 0; l < list->level; l++) {
+    skip_link_t *link = &update[l]->forward[l];
+
+    if (l >= height) {
+      // The link skips over the new node
+      link->width++;
+      continue;
+    }
+
+    // The next node was at positions[l] + width, and is now one position further
+    node->forward[l] = (skip_link_t){ .next = link->next, .width = positions[l] + link->width + 1 - index };
+    *link = (skip_link_t){ .next = node, .width = index - positions[l] };
+
+    if (node->forward[l].next == NULL) {
+      list->last[l] = node;
+      list->last_distance[l] = index - list->head_position;
+    }
+  }
+
+  list->size++;
+  list->finger = NULL;
+}
+
+static elem_t skip_remove(void *storage, size_t index) {
+  skip_list_t *list = storage;
+  node_t *update[MAX_LEVEL];
+  size_t positions[MAX_LEVEL];
+  node_t *node = find(list, index, update, positions);
+  elem_t value = node->value;
+
+  for (size_t l = 0; l < list->level; l++) {
+    skip_link_t *link = &update[l]->forward[l];
+
+    if (link->next == node) {
+      *link = (skip_link_t){ .next = node->forward[l].next, .width = link->width + node->forward[l].width - 1 };
+    } else {
+      link->width--;
+    }
+
+    if (list->last[l] == node) {
+      list->last[l] = update[l];
+      list->last_distance[l] = positions[l] - list->head_position;
+    } else if (list->last[l] != list->head && list->head_position + list->last_distance[l] > index) {
+      list->last_distance[l]--;
+    }
+  }
+
+  while (list->level > 1 && list->head->forward[list->level - 1].next == NULL) {
+    list->level--;
+  }
+
+  free(node);
+  list->size--;
+  list->finger = NULL;
+
+  return value;
+}
+
+static void skip_split(void *storage, size_t index, void *x) {
+  skip_list_t *list = storage;
+  skip_list_t *rest = x;
+
+  if (index == list->size) {
+    return;
+  }
+
+  node_t *update[MAX_LEVEL];
+  size_t positions[MAX_LEVEL];
+
+  find(list, index, update, positions);
+
+  // Each level is cut after the node before index, and the links after the cut are moved as they are
+  for (size_t l = 0; l < list->level; l++) {
+    skip_link_t *link = &update[l]->forward[l];
+
+    if (link->next != NULL) {
+      // Positions in rest are counted from index, and the head of rest is at position -1
+      size_t last_position = list->head_position + list->last_distance[l];
+
+      rest->head->forward[l] = (skip_link_t){ .next = link->next, .width = positions[l] + link->width - index + 1 };
+      rest->last[l] = list->last[l];
+      rest->last_distance[l] = last_position - index - rest->head_position;
+    }
+
+    *link = (skip_link_t){ .next = NULL };
+    list->last[l] = update[l];
+    list->last_distance[l] = positions[l] - list->head_position;
+  }
+
+  rest->level = list->level;
+  rest->size = list->size - index;
+  list->size = index;
+  list->finger = NULL;
+
+  while (list->level > 1 && list->head->forward[list->level - 1].next == NULL) {
+    list->level--;
+  }
+
+  while (rest->level > 1 && rest->head->forward[rest->level - 1].next == NULL) {
+    rest->level--;
+  }
+}
+
+static elem_t *skip_get(void *storage, size_t index) {
+  skip_list_t *list = storage;
+
+  // Continue from the last get when stepping through the list
+  if (list->finger != NULL && index - list->finger_index <= 1) {
+    if (index != list->finger_index) {
+      list->finger = list->finger->forward[0].next;
+      list->finger_index = index;
+    }
+
+    return &list->finger->value;
+  }
+
+  node_t *update[MAX_LEVEL];
+  size_t positions[MAX_LEVEL];
+
+  list->finger = find(list, index, update, positions);
+  list->finger_index = index;
+
+  return &list->finger->value;
+}
+
+static void skip_clear(void *storage) {
+  skip_list_t *list = storage;
+  node_t *node = list->head->forward[0].next;
+
+  while (node != NULL) {
+    node_t *next = node->forward[0].next;
+    free(node);
+    node = next;
+  }
+
+  reset(list);
+}
+
+static bool skip_any(void *storage, ioopm_char_predicate prop, void *extra) {
+  skip_list_t *list = storage;
+
+  for (node_t *node = list->head->forward[0].next; node != NULL; node = node->forward[0].next) {
+    if (prop(node->value, extra)) return true;
+  }
+
+  return false;
+}
+
+static void skip_apply_to_all(void *storage, ioopm_apply_char_function fun, void *extra) {
+  skip_list_t *list = storage;
+
+  for (node_t *node = list->head->forward[0].next; node != NULL; node = node->forward[0].next) {
+    fun(&node->value, extra);
+  }
+}
+
+static void *skip_create() {
+  return skip_list_create();
+}
+
+static void skip_destroy(void *storage) {
+  skip_list_t *list = storage;
+
+  skip_clear(list);
+  free(list->head);
+  free(list);
+}
+
+const list_backend_t skip_list_backend = {
+  .create = skip_create,
+  .append = skip_append,
+  .prepend = skip_prepend,
+  .append_array = skip_append_array,
+  .insert = skip_insert,
+  .remove = skip_remove,
+  .split = skip_split,
+  .get = skip_get,
+  .clear = skip_clear,
+  .any = skip_any,
+  .apply_to_all = skip_apply_to_all,
+  .destroy = skip_destroy,
+};
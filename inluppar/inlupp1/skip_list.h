@@ -0,0 +1,26 @@
+#pragma once
+
+#include "common.h"
+#include "list_backend.h"
+
+/**
+ * @file skip_list.h
+ * @author Fredrik Engstrand, Alex Alstergren
+ * @date 19 October 2026
+ * @brief Indexable skip list storage, used by ioopm_linked_list_create_skip.
+ *
+ * Every element has a node on the lowest level, and each level above holds about a
+ * quarter of the nodes of the level below. Each link also stores how many positions it
+ * skips, so getting, inserting and removing at an index takes O(log n) expected time.
+ * Appending and prepending take O(1) expected time, since the last node of each level
+ * is kept, and the links from the head are counted from a position that moves on prepend.
+ */
+
+typedef struct skip_list skip_list_t;
+
+/// @brief The operations of a skip list, see list_backend.h
+extern const list_backend_t skip_list_backend;
+
+/// @brief Create an empty skip list
+/// @return the list
+skip_list_t *skip_list_create();
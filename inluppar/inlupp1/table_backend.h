@@ -0,0 +1,57 @@
+#pragma once
+
+#include <stdbool.h>
+
+#include "common.h"
+#include "hash_table.h"
+
+/**
+ * @file table_backend.h
+ * @author Fredrik Engstrand, Alex Alstergren
+ * @date 19 October 2026
+ * @brief Internal interface for alternative storages behind the ioopm_hash_table_* functions.
+ *
+ * A hash table either keeps its entries in its own buckets, or forwards every operation to a
+ * backend. The public functions in hash_table.c take care of errno and the value index, which
+ * means that none of the operations below touches errno.
+ */
+
+typedef struct table_backend table_backend_t;
+
+struct table_backend {
+  /// @brief find the value for key
+  /// @return true and sets *value if the key exists, else false
+  bool (*lookup)(void *storage, elem_t key, elem_t *value);
+
+  /// @brief add or replace key => value
+  /// @param replaced set to true and *old_value to the previous value if the key existed
+  /// @return false if the entry could not be stored
+  bool (*insert)(void *storage, elem_t key, elem_t value, bool *replaced, elem_t *old_value);
+
+  /// @brief remove the entry for key
+  /// @return true and sets *value to the removed value if the key existed, else false
+  bool (*remove)(void *storage, elem_t key, elem_t *value);
+
+  size_t (*size)(void *storage);
+  void (*clear)(void *storage);
+  bool (*any)(void *storage, ioopm_predicate pred, void *arg);
+  void (*apply_to_all)(void *storage, ioopm_apply_function apply_fun, void *arg);
+
+  /// @brief remove every entry for which pred returns true, in one pass
+  /// @param on_removed called with each entry before it is removed (with removed_arg)
+  /// @return the amount of removed entries
+  size_t (*remove_if)(void *storage, ioopm_predicate pred, void *arg, ioopm_apply_function on_removed, void *removed_arg);
+
+  /// @brief write all changes to permanent storage (may be NULL)
+  /// @return false if any change could not be written since the last sync
+  bool (*sync)(void *storage);
+
+  /// @brief return a copy of a key passed to a predicate or apply function that stays valid
+  /// until release_keys is called (NULL if keys passed to callbacks are always valid)
+  elem_t (*export_key)(void *storage, elem_t key);
+
+  /// @brief free all copies returned by export_key (NULL if export_key is NULL)
+  void (*release_keys)(void *storage);
+
+  void (*destroy)(void *storage);
+};
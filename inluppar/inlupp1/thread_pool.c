@@ -0,0 +1,144 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#include "thread_pool.h"
+
+//@brief the tasks of one run.
+typedef struct job {
+  ioopm_task_function task;
+  size_t tasks;
+  void *extra;
+} job_t;
+
+struct thread_pool {
+  pthread_t *threads;     // The started threads (one less than size).
+  size_t size;            // The amount of threads working on a run, including the calling thread.
+  pthread_mutex_t lock;   // Protects all fields below except next_task.
+  pthread_cond_t work;    // Signalled when a run starts or the pool stops.
+  pthread_cond_t done;    // Signalled when a thread is done with a run.
+  job_t job;              // The tasks of the current run.
+  size_t generation;      // The amount of runs started, so that threads notice a new run.
+  size_t working;         // The amount of started threads working on a run.
+  size_t next_task;       // The next unclaimed task of the current run (claimed atomically).
+  bool stopping;          // True when the threads should return.
+};
+
+/// @brief Claims and runs tasks until all tasks of job are claimed
+static void run_tasks(ioopm_thread_pool_t *pool, job_t *job) {
+  size_t task;
+
+  while ((task = __atomic_fetch_add(&pool->next_task, 1, __ATOMIC_RELAXED)) < job->tasks) {
+    job->task(task, job->extra);
+  }
+}
+
+static void *worker(void *x) {
+  ioopm_thread_pool_t *pool = x;
+  size_t seen = 0;
+
+  pthread_mutex_lock(&pool->lock);
+
+  while (true) {
+    while (!pool->stopping && pool->generation == seen) {
+      pthread_cond_wait(&pool->work, &pool->lock);
+    }
+
+    if (pool->stopping) {
+      break;
+    }
+
+    // Copy the job, since the next run may start as soon as this thread is done with the tasks
+    job_t job = pool->job;
+
+    seen = pool->generation;
+    pool->working++;
+    pthread_mutex_unlock(&pool->lock);
+
+    run_tasks(pool, &job);
+
+    pthread_mutex_lock(&pool->lock);
+    pool->working--;
+
+    if (pool->working == 0) {
+      pthread_cond_broadcast(&pool->done);
+    }
+  }
+
+  pthread_mutex_unlock(&pool->lock);
+
+  return NULL;
+}
+
+ioopm_thread_pool_t *ioopm_thread_pool_create(size_t threads) {
+  ioopm_thread_pool_t *pool = calloc(1, sizeof(ioopm_thread_pool_t));
+
+  if (threads == 0) {
+    long processors = sysconf(_SC_NPROCESSORS_ONLN);
+    threads = processors > 0 ? processors : 1;
+  }
+
+  pool->size = threads;
+  pool->threads = calloc(threads, sizeof(pthread_t));
+  pthread_mutex_init(&pool->lock, NULL);
+  pthread_cond_init(&pool->work, NULL);
+  pthread_cond_init(&pool->done, NULL);
+
+  // The calling thread of a run is the last thread
+  for (size_t i = 0; i + 1 < threads; i++) {
+    pthread_create(&pool->threads[i], NULL, worker, pool);
+  }
+
+  return pool;
+}
+
+void ioopm_thread_pool_destroy(ioopm_thread_pool_t *pool) {
+  pthread_mutex_lock(&pool->lock);
+  pool->stopping = true;
+  pthread_cond_broadcast(&pool->work);
+  pthread_mutex_unlock(&pool->lock);
+
+  for (size_t i = 0; i + 1 < pool->size; i++) {
+    pthread_join(pool->threads[i], NULL);
+  }
+
+  pthread_cond_destroy(&pool->done);
+  pthread_cond_destroy(&pool->work);
+  pthread_mutex_destroy(&pool->lock);
+  free(pool->threads);
+  free(pool);
+}
+
+size_t ioopm_thread_pool_size(ioopm_thread_pool_t *pool) {
+  return pool->size;
+}
+
+void ioopm_thread_pool_run(ioopm_thread_pool_t *pool, ioopm_task_function task, size_t tasks, void *extra) {
+  job_t job = { .task = task, .tasks = tasks, .extra = extra };
+
+  pthread_mutex_lock(&pool->lock);
+
+  // Threads that are still looking for tasks of the previous run would claim tasks of this run
+  while (pool->working > 0) {
+    pthread_cond_wait(&pool->done, &pool->lock);
+  }
+
+  pool->job = job;
+  pool->next_task = 0;
+  pool->generation++;
+  pthread_cond_broadcast(&pool->work);
+  pthread_mutex_unlock(&pool->lock);
+
+  run_tasks(pool, &job);
+
+  // All tasks are claimed, so the run is done when no thread is working on one
+  pthread_mutex_lock(&pool->lock);
+
+  while (pool->working > 0) {
+    pthread_cond_wait(&pool->done, &pool->lock);
+  }
+
+  pthread_mutex_unlock(&pool->lock);
+}
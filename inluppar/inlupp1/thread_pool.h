@@ -0,0 +1,43 @@
+#pragma once
+
+#include <stddef.h>
+
+/**
+ * @file thread_pool.h
+ * @author Fredrik Engstrand, Alex Alstergren
+ * @date 19 October 2026
+ * @brief A fixed set of threads that run numbered tasks, used by the parallel list functions.
+ *
+ * The threads are started once by ioopm_thread_pool_create and wait for work between runs, so
+ * a run only costs waking them up. The thread calling ioopm_thread_pool_run works on the
+ * tasks too, and each thread claims the next unclaimed task when it is done with one, which
+ * evens out tasks that take different amounts of time.
+ */
+
+typedef struct thread_pool ioopm_thread_pool_t;
+
+/// @brief a task, called once for each number in [0..tasks-1] of a run
+typedef void(*ioopm_task_function)(size_t task, void *extra);
+
+/// @brief Create a thread pool
+/// @param threads the amount of threads working on a run, including the calling thread
+///        (0 for the amount of online processors)
+/// @return a thread pool with threads - 1 started threads
+ioopm_thread_pool_t *ioopm_thread_pool_create(size_t threads);
+
+/// @brief Stop the threads of the pool and return all its memory
+/// @param pool the thread pool, which may not be running anything
+void ioopm_thread_pool_destroy(ioopm_thread_pool_t *pool);
+
+/// @brief The amount of threads working on a run, including the calling thread
+/// @param pool the thread pool
+/// @return the amount of threads
+size_t ioopm_thread_pool_size(ioopm_thread_pool_t *pool);
+
+/// @brief Run a number of tasks on the pool and wait until all of them are done
+/// The tasks may run in any order and at the same time. Only one thread may call this at a time.
+/// @param pool the thread pool
+/// @param task the function to be called for each task
+/// @param tasks the amount of tasks
+/// @param extra an additional argument (may be NULL) that will be passed to all calls of task
+void ioopm_thread_pool_run(ioopm_thread_pool_t *pool, ioopm_task_function task, size_t tasks, void *extra);
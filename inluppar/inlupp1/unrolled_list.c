@@ -0,0 +1,310 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "common.h"
+#include "unrolled_list.h"
+
+#define NODE_CAPACITY 13
+#define NODE_ALIGNMENT 64
+
+typedef struct node node_t;
+
+//@brief a part of the list, holding up to NODE_CAPACITY elements (128 bytes).
+struct node {
+  node_t *next;                  // The next node (possibly NULL).
+  node_t *prev;                  // The previous node (possibly NULL).
+  size_t count;                  // The amount of elements in the node (never 0).
+  elem_t values[NODE_CAPACITY];  // The elements.
+};
+
+struct unrolled_list {
+  node_t *first;        // The first node (NULL if the list has no nodes).
+  node_t *last;         // The last node (NULL if the list has no nodes).
+  size_t size;          // The amount of elements in the list.
+  node_t *finger;       // The node of the last access (NULL if not known).
+  size_t finger_start;  // The index of the first element in finger.
+};
+
+/// @brief Creates an empty node and links it in after prev (or first if prev is NULL)
+static node_t *node_create(unrolled_list_t *list, node_t *prev) {
+  node_t *node = aligned_alloc(NODE_ALIGNMENT, sizeof(node_t));
+  node_t *next = prev == NULL ? list->first : prev->next;
+
+  node->next = next;
+  node->prev = prev;
+  node->count = 0;
+
+  *(prev == NULL ? &list->first : &prev->next) = node;
+  *(next == NULL ? &list->last : &next->prev) = node;
+
+  return node;
+}
+
+/// @brief Unlinks a node from the list and frees it
+static void node_destroy(unrolled_list_t *list, node_t *node) {
+  *(node->prev == NULL ? &list->first : &node->prev->next) = node->next;
+  *(node->next == NULL ? &list->last : &node->next->prev) = node->prev;
+
+  free(node);
+}
+
+/// @brief Finds the node holding the element at index (which must be in [0..n-1])
+/// @param start set to the index of the first element in the node
+static node_t *find_node(unrolled_list_t *list, size_t index, size_t *start) {
+  node_t *node = list->first;
+  size_t node_start = 0;
+  size_t last_start = list->size - list->last->count;
+
+  if (index >= last_start) {
+    // Appending, and getting or removing the last element, never walks the list
+    node = list->last;
+    node_start = last_start;
+  } else if (list->finger != NULL && (list->finger_start <= index || list->finger_start - index < index)) {
+    // Continue from the last access, walking backwards if that is closer than the first node
+    node = list->finger;
+    node_start = list->finger_start;
+  }
+
+  while (index < node_start) {
+    node = node->prev;
+    node_start -= node->count;
+  }
+
+  while (index >= node_start + node->count) {
+    node_start += node->count;
+    node = node->next;
+  }
+
+  list->finger = node;
+  list->finger_start = node_start;
+  *start = node_start;
+
+  return node;
+}
+
+unrolled_list_t *unrolled_list_create() {
+  return calloc(1, sizeof(unrolled_list_t));
+}
+
+static void unrolled_append(void *storage, elem_t value) {
+  unrolled_list_t *list = storage;
+
+  if (list->last == NULL || list->last->count == NODE_CAPACITY) {
+    node_create(list, list->last);
+  }
+
+  // Appending does not move any element, so the finger stays valid
+  list->last->values[list->last->count++] = value;
+  list->size++;
+}
+
+static void unrolled_append_array(void *storage, elem_t *values, size_t n) {
+  unrolled_list_t *list = storage;
+
+  // Fill up the last node, then copy whole nodes at a time
+  while (n > 0) {
+    if (list->last == NULL || list->last->count == NODE_CAPACITY) {
+      node_create(list, list->last);
+    }
+
+    node_t *last = list->last;
+    size_t count = NODE_CAPACITY - last->count < n ? NODE_CAPACITY - last->count : n;
+
+    memcpy(&last->values[last->count], values, count * sizeof(elem_t));
+    last->count += count;
+    list->size += count;
+    values += count;
+    n -= count;
+  }
+}
+
+static void unrolled_prepend(void *storage, elem_t value) {
+  unrolled_list_t *list = storage;
+
+  if (list->first == NULL || list->first->count == NODE_CAPACITY) {
+    node_create(list, NULL);
+  }
+
+  node_t *first = list->first;
+
+  memmove(&first->values[1], &first->values[0], first->count * sizeof(elem_t));
+  first->values[0] = value;
+  first->count++;
+  list->size++;
+
+  list->finger = first;
+  list->finger_start = 0;
+}
+
+static void unrolled_insert(void *storage, size_t index, elem_t value) {
+  unrolled_list_t *list = storage;
+
+  if (index == list->size) {
+    unrolled_append(list, value);
+    return;
+  }
+
+  size_t start;
+  node_t *node = find_node(list, index, &start);
+  size_t offset = index - start;
+
+  // Split a full node in two halves, and insert into the half that holds index
+  if (node->count == NODE_CAPACITY) {
+    node_t *upper = node_create(list, node);
+    size_t half = NODE_CAPACITY / 2;
+
+    memcpy(upper->values, &node->values[half], (NODE_CAPACITY - half) * sizeof(elem_t));
+    upper->count = NODE_CAPACITY - half;
+    node->count = half;
+
+    if (offset > half) {
+      node = upper;
+      offset -= half;
+    }
+  }
+
+  memmove(&node->values[offset + 1], &node->values[offset], (node->count - offset) * sizeof(elem_t));
+  node->values[offset] = value;
+  node->count++;
+  list->size++;
+}
+
+static elem_t unrolled_remove(void *storage, size_t index) {
+  unrolled_list_t *list = storage;
+  size_t start;
+  node_t *node = find_node(list, index, &start);
+  size_t offset = index - start;
+  elem_t value = node->values[offset];
+
+  memmove(&node->values[offset], &node->values[offset + 1], (node->count - offset - 1) * sizeof(elem_t));
+  node->count--;
+  list->size--;
+
+  // An empty node is freed, and the finger moves to a neighbour so that the next access does not start over
+  if (node->count == 0) {
+    if (node->next != NULL) {
+      list->finger = node->next;
+    } else if (node->prev != NULL) {
+      list->finger = node->prev;
+      list->finger_start = start - node->prev->count;
+    } else {
+      list->finger = NULL;
+    }
+
+    node_destroy(list, node);
+    return value;
+  }
+
+  // Merge a sparse node with the next node
+  node_t *next = node->next;
+
+  if (next != NULL && node->count < NODE_CAPACITY / 2 && node->count + next->count <= NODE_CAPACITY) {
+    memcpy(&node->values[node->count], next->values, next->count * sizeof(elem_t));
+    node->count += next->count;
+    node_destroy(list, next);
+  }
+
+  // The node still starts at the same index, so the finger stays valid
+  return value;
+}
+
+static void unrolled_split(void *storage, size_t index, void *x) {
+  unrolled_list_t *list = storage;
+  unrolled_list_t *rest = x;
+
+  if (index == list->size) {
+    return;
+  }
+
+  size_t start;
+  node_t *node = find_node(list, index, &start);
+  size_t offset = index - start;
+
+  // Only the node holding index is split, the nodes after it are moved as they are
+  if (offset > 0) {
+    node_t *upper = node_create(list, node);
+
+    memcpy(upper->values, &node->values[offset], (node->count - offset) * sizeof(elem_t));
+    upper->count = node->count - offset;
+    node->count = offset;
+    node = upper;
+  }
+
+  rest->first = node;
+  rest->last = list->last;
+  rest->size = list->size - index;
+
+  list->last = node->prev;
+  *(node->prev == NULL ? &list->first : &node->prev->next) = NULL;
+  node->prev = NULL;
+  list->size = index;
+  list->finger = NULL;
+}
+
+static elem_t *unrolled_get(void *storage, size_t index) {
+  size_t start;
+  node_t *node = find_node(storage, index, &start);
+  return &node->values[index - start];
+}
+
+
+static void unrolled_clear(void *storage) {
+  unrolled_list_t *list = storage;
+  node_t *node = list->first;
+
+  while (node != NULL) {
+    node_t *next = node->next;
+    free(node);
+    node = next;
+  }
+
+  *list = (unrolled_list_t){ .first = NULL };
+}
+
+static bool unrolled_any(void *storage, ioopm_char_predicate prop, void *extra) {
+  unrolled_list_t *list = storage;
+
+  for (node_t *node = list->first; node != NULL; node = node->next) {
+    for (size_t i = 0; i < node->count; i++) {
+      if (prop(node->values[i], extra)) return true;
+    }
+  }
+
+  return false;
+}
+
+static void unrolled_apply_to_all(void *storage, ioopm_apply_char_function fun, void *extra) {
+  unrolled_list_t *list = storage;
+
+  for (node_t *node = list->first; node != NULL; node = node->next) {
+    for (size_t i = 0; i < node->count; i++) {
+      fun(&node->values[i], extra);
+    }
+  }
+}
+
+static void *unrolled_create() {
+  return unrolled_list_create();
+}
+
+static void unrolled_destroy(void *storage) {
+  unrolled_clear(storage);
+  free(storage);
+}
+
+const list_backend_t unrolled_list_backend = {
+  .create = unrolled_create,
+  .append = unrolled_append,
+  .prepend = unrolled_prepend,
+  .append_array = unrolled_append_array,
+  .insert = unrolled_insert,
+  .remove = unrolled_remove,
+  .split = unrolled_split,
+  .get = unrolled_get,
+  .clear = unrolled_clear,
+  .any = unrolled_any,
+  .apply_to_all = unrolled_apply_to_all,
+  .destroy = unrolled_destroy,
+};
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "common.h"
+#include "list_backend.h"
+
+/**
+ * @file unrolled_list.h
+ * @author Fredrik Engstrand, Alex Alstergren
+ * @date 19 October 2026
+ * @brief Unrolled list storage, used by ioopm_linked_list_create_unrolled.
+ *
+ * Elements are stored 13 at a time in nodes of two cache lines, so traversals read the
+ * elements of each node from an array instead of following one pointer per element.
+ * No node is empty, and a node that gets less than half full after a remove is merged with
+ * the next node if they fit together.
+ * The node and index of the last access are cached, so that stepping through the list
+ * with increasing or decreasing indices only walks the nodes once. Accessing the last node
+ * (e.g. removing from the end) never walks the list.
+ */
+
+typedef struct unrolled_list unrolled_list_t;
+
+/// @brief The operations of an unrolled list, see list_backend.h
+extern const list_backend_t unrolled_list_backend;
+
+/// @brief Create an empty unrolled list
+/// @return the list
+unrolled_list_t *unrolled_list_create();
@@ -0,0 +1,114 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <stdbool.h>
+
+#include "common.h"
+#include "vector.h"
+
+#define INITIAL_CAPACITY 8
+#define GROWTH_FACTOR 2
+
+//@brief a dynamic array of elements.
+struct vector {
+  elem_t *values;            // The elements (NULL if capacity is 0).
+  size_t size;               // The amount of elements.
+  size_t capacity;           // The amount of elements that fit in values.
+  ioopm_eq_function eq_func; // Equality function to compare with the values within the vector.
+};
+
+ioopm_vector_t *ioopm_vector_create(ioopm_eq_function eq_func) {
+  return ioopm_vector_create_with_capacity(eq_func, 0);
+}
+
+ioopm_vector_t *ioopm_vector_create_with_capacity(ioopm_eq_function eq_func, size_t capacity) {
+  ioopm_vector_t *vector = calloc(1, sizeof(ioopm_vector_t));
+
+  *vector = (ioopm_vector_t){
+    .values = capacity > 0 ? calloc(capacity, sizeof(elem_t)) : NULL,
+    .capacity = capacity,
+    .eq_func = eq_func,
+  };
+
+  return vector;
+}
+
+void ioopm_vector_destroy(ioopm_vector_t *vector) {
+  free(vector->values);
+  free(vector);
+}
+
+void ioopm_vector_append(ioopm_vector_t *vector, elem_t value) {
+  if (vector->size == vector->capacity) {
+    vector->capacity = vector->capacity == 0 ? INITIAL_CAPACITY : vector->capacity * GROWTH_FACTOR;
+    vector->values = realloc(vector->values, vector->capacity * sizeof(elem_t));
+  }
+
+  vector->values[vector->size++] = value;
+}
+
+elem_t ioopm_vector_get(ioopm_vector_t *vector, size_t index) {
+  if (index >= vector->size) {
+    FAILURE();
+    return int_elem(-1);
+  }
+
+  SUCCESS();
+  return vector->values[index];
+}
+
+void ioopm_vector_set(ioopm_vector_t *vector, size_t index, elem_t value) {
+  if (index >= vector->size) {
+    FAILURE();
+    return;
+  }
+
+  vector->values[index] = value;
+  SUCCESS();
+}
+
+elem_t *ioopm_vector_data(ioopm_vector_t *vector) {
+  return vector->values;
+}
+
+size_t ioopm_vector_size(ioopm_vector_t *vector) {
+  return vector->size;
+}
+
+bool ioopm_vector_is_empty(ioopm_vector_t *vector) {
+  return vector->size == 0;
+}
+
+void ioopm_vector_clear(ioopm_vector_t *vector) {
+  vector->size = 0;
+}
+
+bool ioopm_vector_contains(ioopm_vector_t *vector, elem_t value) {
+  for (size_t i = 0; i < vector->size; i++) {
+    if (vector->eq_func(vector->values[i], value)) return true;
+  }
+
+  return false;
+}
+
+bool ioopm_vector_all(ioopm_vector_t *vector, ioopm_char_predicate prop, void *extra) {
+  for (size_t i = 0; i < vector->size; i++) {
+    if (!prop(vector->values[i], extra)) return false;
+  }
+
+  return true;
+}
+
+bool ioopm_vector_any(ioopm_vector_t *vector, ioopm_char_predicate prop, void *extra) {
+  for (size_t i = 0; i < vector->size; i++) {
+    if (prop(vector->values[i], extra)) return true;
+  }
+
+  return false;
+}
+
+void ioopm_vector_apply_to_all(ioopm_vector_t *vector, ioopm_apply_char_function fun, void *extra) {
+  for (size_t i = 0; i < vector->size; i++) {
+    fun(&vector->values[i], extra);
+  }
+}
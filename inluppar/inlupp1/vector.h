@@ -0,0 +1,99 @@
+#pragma once
+
+#include <stdbool.h>
+
+#include "common.h"
+#include "linked_list.h"
+
+/**
+ * @file vector.h
+ * @author Fredrik Engstrand, Alex Alstergren
+ * @date 19 October 2026
+ * @brief Dynamic array of elements, for sequences that are only appended to and traversed.
+ *
+ * The elements are stored contiguously and the array doubles in size when it is full, so
+ * appending takes O(1) amortized time without allocating memory for each element as
+ * ioopm_linked_list_append does. The predicates and apply functions are the same as for lists.
+ */
+
+typedef struct vector ioopm_vector_t;
+
+/// @brief Create an empty vector
+/// @param eq_func the function used to compare elements in ioopm_vector_contains
+/// @return an empty vector
+ioopm_vector_t *ioopm_vector_create(ioopm_eq_function eq_func);
+
+/// @brief Create an empty vector with room for a number of elements
+/// @param eq_func the function used to compare elements in ioopm_vector_contains
+/// @param capacity the amount of elements that can be appended before the vector grows
+/// @return an empty vector
+ioopm_vector_t *ioopm_vector_create_with_capacity(ioopm_eq_function eq_func, size_t capacity);
+
+/// @brief Tear down the vector and return all its memory (but not the memory of the elements)
+/// @param vector the vector to be destroyed
+void ioopm_vector_destroy(ioopm_vector_t *vector);
+
+/// @brief Insert at the end of a vector in O(1) amortized time
+/// @param vector the vector to be extended
+/// @param value the value to be appended
+void ioopm_vector_append(ioopm_vector_t *vector, elem_t value);
+
+/// @brief Retrieve an element from a vector in O(1) time
+/// @param vector the vector
+/// @param index the position in the vector, in [0,n-1]
+/// @return the value at the given position or sets errno to EINVAL if index is invalid
+elem_t ioopm_vector_get(ioopm_vector_t *vector, size_t index);
+
+/// @brief Replace an element of a vector in O(1) time
+/// @param vector the vector
+/// @param index the position in the vector, in [0,n-1]
+/// @param value the new value
+/// sets errno to EINVAL if index is invalid
+void ioopm_vector_set(ioopm_vector_t *vector, size_t index, elem_t value);
+
+/// @brief Get direct access to the elements of a vector, e.g. to sort them with qsort
+/// @param vector the vector
+/// @return the elements, which stay valid until the vector is appended to, cleared or destroyed
+elem_t *ioopm_vector_data(ioopm_vector_t *vector);
+
+/// @brief Lookup the number of elements in the vector in O(1) time
+/// @param vector the vector
+/// @return the number of elements in the vector
+size_t ioopm_vector_size(ioopm_vector_t *vector);
+
+/// @brief Test whether a vector is empty or not
+/// @param vector the vector
+/// @return true if the number of elements is 0, else false
+bool ioopm_vector_is_empty(ioopm_vector_t *vector);
+
+/// @brief Remove all elements from a vector (keeping its capacity)
+/// @param vector the vector
+void ioopm_vector_clear(ioopm_vector_t *vector);
+
+/// @brief Test if an element is in the vector
+/// @param vector the vector
+/// @param value of the element sought
+/// @return true if element is in the vector, else false
+bool ioopm_vector_contains(ioopm_vector_t *vector, elem_t value);
+
+/// @brief Test if a supplied property holds for all elements in a vector.
+/// The function returns as soon as the return value can be determined.
+/// @param vector the vector
+/// @param prop the property to be tested (function pointer)
+/// @param extra an additional argument (may be NULL) that will be passed to all internal calls of prop
+/// @return true if prop holds for all elements in the vector, else false
+bool ioopm_vector_all(ioopm_vector_t *vector, ioopm_char_predicate prop, void *extra);
+
+/// @brief Test if a supplied property holds for any element in a vector.
+/// The function returns as soon as the return value can be determined.
+/// @param vector the vector
+/// @param prop the property to be tested
+/// @param extra an additional argument (may be NULL) that will be passed to all internal calls of prop
+/// @return true if prop holds for any elements in the vector, else false
+bool ioopm_vector_any(ioopm_vector_t *vector, ioopm_char_predicate prop, void *extra);
+
+/// @brief Apply a supplied function to all elements in a vector.
+/// @param vector the vector
+/// @param fun the function to be applied
+/// @param extra an additional argument (may be NULL) that will be passed to all internal calls of fun
+void ioopm_vector_apply_to_all(ioopm_vector_t *vector, ioopm_apply_char_function fun, void *extra);
@@ -0,0 +1,151 @@
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <CUnit/Basic.h>
+
+#include "common.h"
+#include "vector.h"
+
+int init_suite(void) {
+  return 0;
+}
+
+int clean_suite(void) {
+  return 0;
+}
+
+bool is_less_than(elem_t value, void *extra) {
+  return value.integer < *(int *)extra;
+}
+
+void add_to_value(elem_t *value, void *extra) {
+  value->integer += *(int *)extra;
+}
+
+int cmp_int_elem(const void *a, const void *b) {
+  return ((const elem_t *)a)->integer - ((const elem_t *)b)->integer;
+}
+
+void test_create_destroy() {
+  ioopm_vector_t *vector = ioopm_vector_create(eq_elem_int);
+
+  CU_ASSERT_PTR_NOT_NULL(vector);
+  CU_ASSERT_EQUAL(ioopm_vector_size(vector), 0);
+  CU_ASSERT_TRUE(ioopm_vector_is_empty(vector));
+
+  ioopm_vector_destroy(vector);
+}
+
+void test_append_and_get() {
+  ioopm_vector_t *vector = ioopm_vector_create(eq_elem_int);
+
+  // Enough elements to grow the vector a few times
+  for (int i = 0; i < 1000; i++) {
+    ioopm_vector_append(vector, int_elem(i * 2));
+  }
+
+  CU_ASSERT_EQUAL(ioopm_vector_size(vector), 1000);
+
+  for (int i = 0; i < 1000; i++) {
+    CU_ASSERT_EQUAL(ioopm_vector_get(vector, i).integer, i * 2);
+    CU_ASSERT_FALSE(HAS_ERROR());
+  }
+
+  ioopm_vector_get(vector, 1000);
+  CU_ASSERT_TRUE(HAS_ERROR());
+
+  ioopm_vector_set(vector, 10, int_elem(-1));
+  CU_ASSERT_EQUAL(ioopm_vector_get(vector, 10).integer, -1);
+
+  ioopm_vector_set(vector, 1000, int_elem(-1));
+  CU_ASSERT_TRUE(HAS_ERROR());
+
+  ioopm_vector_destroy(vector);
+}
+
+void test_data() {
+  ioopm_vector_t *vector = ioopm_vector_create_with_capacity(eq_elem_int, 3);
+  int values[] = { 30, 10, 20 };
+
+  for (int i = 0; i < 3; i++) {
+    ioopm_vector_append(vector, int_elem(values[i]));
+  }
+
+  // The elements can be sorted in place
+  qsort(ioopm_vector_data(vector), ioopm_vector_size(vector), sizeof(elem_t), cmp_int_elem);
+
+  CU_ASSERT_EQUAL(ioopm_vector_get(vector, 0).integer, 10);
+  CU_ASSERT_EQUAL(ioopm_vector_get(vector, 1).integer, 20);
+  CU_ASSERT_EQUAL(ioopm_vector_get(vector, 2).integer, 30);
+
+  ioopm_vector_destroy(vector);
+}
+
+void test_predicates_and_apply() {
+  ioopm_vector_t *vector = ioopm_vector_create(eq_elem_int);
+  int limit = 10;
+  int delta = 5;
+
+  CU_ASSERT_TRUE(ioopm_vector_all(vector, is_less_than, &limit));
+  CU_ASSERT_FALSE(ioopm_vector_any(vector, is_less_than, &limit));
+
+  for (int i = 0; i < 10; i++) {
+    ioopm_vector_append(vector, int_elem(i));
+  }
+
+  CU_ASSERT_TRUE(ioopm_vector_all(vector, is_less_than, &limit));
+  CU_ASSERT_TRUE(ioopm_vector_contains(vector, int_elem(9)));
+  CU_ASSERT_FALSE(ioopm_vector_contains(vector, int_elem(10)));
+
+  ioopm_vector_apply_to_all(vector, add_to_value, &delta);
+
+  CU_ASSERT_FALSE(ioopm_vector_all(vector, is_less_than, &limit));
+  CU_ASSERT_TRUE(ioopm_vector_any(vector, is_less_than, &limit));
+  CU_ASSERT_TRUE(ioopm_vector_contains(vector, int_elem(14)));
+
+  ioopm_vector_destroy(vector);
+}
+
+void test_clear() {
+  ioopm_vector_t *vector = ioopm_vector_create(eq_elem_int);
+
+  ioopm_vector_append(vector, int_elem(1));
+  ioopm_vector_clear(vector);
+
+  CU_ASSERT_TRUE(ioopm_vector_is_empty(vector));
+  CU_ASSERT_FALSE(ioopm_vector_contains(vector, int_elem(1)));
+
+  ioopm_vector_append(vector, int_elem(2));
+  CU_ASSERT_EQUAL(ioopm_vector_get(vector, 0).integer, 2);
+
+  ioopm_vector_destroy(vector);
+}
+
+int main() {
+  CU_pSuite test_suite1 = NULL;
+
+  if (CUE_SUCCESS != CU_initialize_registry())
+    return CU_get_error();
+
+  test_suite1 = CU_add_suite("Vector", init_suite, clean_suite);
+  if (NULL == test_suite1) {
+    CU_cleanup_registry();
+    return CU_get_error();
+  }
+
+  if (
+    (NULL == CU_add_test(test_suite1, "it creates and returns a pointer to an empty vector", test_create_destroy)) ||
+    (NULL == CU_add_test(test_suite1, "it appends, gets and sets elements and gives an error for invalid indices", test_append_and_get)) ||
+    (NULL == CU_add_test(test_suite1, "it gives direct access to the elements", test_data)) ||
+    (NULL == CU_add_test(test_suite1, "it tests predicates and applies functions on all elements", test_predicates_and_apply)) ||
+    (NULL == CU_add_test(test_suite1, "it clears the vector", test_clear))
+  ) {
+    CU_cleanup_registry();
+    return CU_get_error();
+  }
+
+  CU_basic_set_mode(CU_BRM_VERBOSE);  // Detaljerna utav testerna skrivs ut.
+  CU_basic_run_tests();               // Kör alla testen.
+  CU_cleanup_registry();              // Städar upp testerna (avallokerar minnen bland annat)
+  return CU_get_error();              // Returnerar alla fel som hänt
+}
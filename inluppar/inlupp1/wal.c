@@ -0,0 +1,426 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <libgen.h>
+#include <sys/stat.h>
+
+#include "common.h"
+#include "hash_table.h"
+#include "wal.h"
+
+#define LOG_MAGIC 0x314c576d706f6f69UL      // "ioopmWL1"
+#define SNAPSHOT_MAGIC 0x314e536d706f6f69UL // "ioopmSN1"
+#define BUFFER_SIZE 65536
+#define MAX_KEY_LENGTH (1 << 24)
+
+#define RECORD_INSERT 'I'
+#define RECORD_REMOVE 'R'
+#define RECORD_CLEAR 'C'
+
+typedef struct file_header file_header_t;
+typedef struct record_header record_header_t;
+typedef struct writer writer_t;
+typedef struct snapshot snapshot_t;
+
+//@brief the start of both the log and the snapshot.
+struct file_header {
+  uint64_t magic;        // Identifies the file as a log or a snapshot.
+  uint32_t string_keys;  // Whether the keys are strings or elem_t.
+  uint32_t reserved;
+};
+
+//@brief the start of a record, which is followed by the key and a checksum of both.
+struct record_header {
+  uint8_t type;          // One of RECORD_INSERT, RECORD_REMOVE or RECORD_CLEAR.
+  uint8_t reserved[3];
+  uint32_t key_length;   // The amount of bytes in the key (including the NULL terminator).
+  uint64_t value;        // The inserted value (0 for other records).
+};
+
+//@brief buffers records and writes them to a file in large batches.
+struct writer {
+  int fd;                  // The file that is written to.
+  unsigned char *buffer;   // Records that are not yet written.
+  size_t used;             // The amount of bytes used in buffer.
+  size_t capacity;         // The size of buffer.
+  bool failed;             // True if a write has failed.
+};
+
+//@brief a snapshot that is being written by wal_checkpoint.
+struct snapshot {
+  writer_t writer;       // Appends to the temporary snapshot file.
+  bool string_keys;      // Whether the keys are strings or elem_t.
+};
+
+struct wal {
+  writer_t writer;       // Appends to the log file.
+  char *path;            // The log file.
+  char *snapshot_path;   // The snapshot file.
+  bool string_keys;      // Whether the keys are strings or elem_t.
+  size_t sync_every;     // The amount of operations per group commit (0 if only on wal_commit).
+  size_t pending;        // The amount of operations since the last commit.
+};
+
+/// @brief FNV-1a, used to detect records that were only partly written
+static uint32_t checksum(const unsigned char *data, size_t length, uint32_t hash) {
+  for (size_t i = 0; i < length; i++) {
+    hash = (hash ^ data[i]) * 16777619u;
+  }
+
+  return hash;
+}
+
+static bool write_all(int fd, const unsigned char *data, size_t length) {
+  while (length > 0) {
+    ssize_t written = write(fd, data, length);
+
+    if (written < 0) {
+      if (errno == EINTR) continue;
+      return false;
+    }
+
+    data += written;
+    length -= written;
+  }
+
+  return true;
+}
+
+static void writer_init(writer_t *writer, int fd) {
+  *writer = (writer_t){
+    .fd = fd,
+    .buffer = malloc(BUFFER_SIZE),
+    .capacity = BUFFER_SIZE,
+  };
+}
+
+/// @brief Writes the buffered records to the file (without waiting for the disk)
+static bool writer_flush(writer_t *writer) {
+  if (writer->used > 0 && !write_all(writer->fd, writer->buffer, writer->used)) {
+    writer->failed = true;
+  }
+
+  writer->used = 0;
+  return !writer->failed;
+}
+
+static void writer_append(writer_t *writer, uint8_t type, const void *key, size_t key_length, elem_t value) {
+  record_header_t header = {
+    .type = type,
+    .key_length = key_length,
+    .value = type == RECORD_INSERT ? value.unsigned_long : 0,
+  };
+  size_t size = sizeof(record_header_t) + key_length + sizeof(uint32_t);
+
+  if (writer->capacity - writer->used < size) {
+    writer_flush(writer);
+
+    if (writer->capacity < size) {
+      writer->buffer = realloc(writer->buffer, size);
+      writer->capacity = size;
+    }
+  }
+
+  unsigned char *record = writer->buffer + writer->used;
+  memcpy(record, &header, sizeof(record_header_t));
+
+  if (key_length > 0) {
+    memcpy(record + sizeof(record_header_t), key, key_length);
+  }
+
+  uint32_t sum = checksum(record, sizeof(record_header_t) + key_length, 2166136261u);
+  memcpy(record + sizeof(record_header_t) + key_length, &sum, sizeof(uint32_t));
+  writer->used += size;
+}
+
+static void append_key_record(writer_t *writer, bool string_keys, uint8_t type, elem_t key, elem_t value) {
+  if (string_keys) {
+    writer_append(writer, type, key.extra, strlen(key.extra) + 1, value);
+  } else {
+    writer_append(writer, type, &key, sizeof(elem_t), value);
+  }
+}
+
+/// @brief Reads a record, returning false if it is missing, incomplete or corrupt
+static bool read_record(FILE *f, bool string_keys, record_header_t *header, char **key, size_t *key_capacity) {
+  if (fread(header, sizeof(record_header_t), 1, f) != 1
+      || header->key_length > MAX_KEY_LENGTH
+  ) {
+    return false;
+  }
+
+  if (header->key_length > *key_capacity) {
+    *key = realloc(*key, header->key_length);
+    *key_capacity = header->key_length;
+  }
+
+  uint32_t stored_sum;
+
+  if ((header->key_length > 0 && fread(*key, header->key_length, 1, f) != 1)
+      || fread(&stored_sum, sizeof(uint32_t), 1, f) != 1
+  ) {
+    return false;
+  }
+
+  uint32_t sum = checksum((unsigned char*)header, sizeof(record_header_t), 2166136261u);
+  sum = checksum((unsigned char*)*key, header->key_length, sum);
+
+  if (sum != stored_sum) {
+    return false;
+  }
+
+  switch (header->type) {
+    case RECORD_CLEAR:
+      return header->key_length == 0;
+    case RECORD_INSERT:
+    case RECORD_REMOVE:
+      if (string_keys) {
+        return header->key_length > 0 && (*key)[header->key_length - 1] == '\0';
+      }
+
+      return header->key_length == sizeof(elem_t);
+    default:
+      return false;
+  }
+}
+
+/// @brief Applies a record to ht, which copies string keys since the read buffer is reused
+static void replay_record(wal_t *log, ioopm_hash_table_t *ht, record_header_t *header, char *key_bytes) {
+  if (header->type == RECORD_CLEAR) {
+    ioopm_hash_table_clear(ht);
+    return;
+  }
+
+  elem_t key;
+
+  if (log->string_keys) {
+    key = ptr_elem(key_bytes);
+  } else {
+    memcpy(&key, key_bytes, sizeof(elem_t));
+  }
+
+  if (header->type == RECORD_REMOVE) {
+    ioopm_hash_table_remove(ht, key);
+    return;
+  }
+
+  ioopm_hash_table_insert(ht, key, (elem_t){ .unsigned_long = header->value });
+}
+
+/// @brief Checks the header of a file, writing a new header if the file is empty
+static bool check_header(int fd, uint64_t magic, bool string_keys) {
+  struct stat info;
+  file_header_t header = { .magic = magic, .string_keys = string_keys };
+
+  if (fstat(fd, &info) != 0) {
+    return false;
+  }
+
+  if (info.st_size == 0) {
+    return write_all(fd, (unsigned char*)&header, sizeof(file_header_t)) && fsync(fd) == 0;
+  }
+
+  file_header_t stored;
+
+  return pread(fd, &stored, sizeof(file_header_t), 0) == sizeof(file_header_t)
+    && stored.magic == magic
+    && stored.string_keys == string_keys;
+}
+
+/// @brief Replays a file, returning the offset after the last complete record
+static off_t replay_file(wal_t *log, ioopm_hash_table_t *ht, const char *path) {
+  FILE *f = fopen(path, "rb");
+
+  if (f == NULL) {
+    return 0;
+  }
+
+  record_header_t header;
+  char *key = NULL;
+  size_t key_capacity = 0;
+
+  fseeko(f, sizeof(file_header_t), SEEK_SET);
+  off_t end = sizeof(file_header_t);
+
+  while (read_record(f, log->string_keys, &header, &key, &key_capacity)) {
+    replay_record(log, ht, &header, key);
+    end = ftello(f);
+  }
+
+  free(key);
+  fclose(f);
+
+  return end;
+}
+
+/// @brief Makes a rename in the directory of path durable
+static void sync_directory(const char *path) {
+  char *copy = strdup(path);
+  int fd = open(dirname(copy), O_RDONLY);
+
+  if (fd >= 0) {
+    fsync(fd);
+    close(fd);
+  }
+
+  free(copy);
+}
+
+wal_t *wal_open(const char *path, bool string_keys, size_t sync_every) {
+  int fd = open(path, O_RDWR | O_CREAT | O_APPEND, 0644);
+
+  if (fd < 0) {
+    return NULL;
+  }
+
+  if (!check_header(fd, LOG_MAGIC, string_keys)) {
+    close(fd);
+    errno = EINVAL;
+    return NULL;
+  }
+
+  wal_t *log = calloc(1, sizeof(wal_t));
+
+  *log = (wal_t){
+    .path = strdup(path),
+    .snapshot_path = malloc(strlen(path) + sizeof(".snapshot")),
+    .string_keys = string_keys,
+    .sync_every = sync_every,
+  };
+
+  sprintf(log->snapshot_path, "%s.snapshot", path);
+  writer_init(&log->writer, fd);
+
+  int snapshot_fd = open(log->snapshot_path, O_RDONLY);
+
+  if (snapshot_fd >= 0) {
+    bool valid = check_header(snapshot_fd, SNAPSHOT_MAGIC, string_keys);
+    close(snapshot_fd);
+
+    if (!valid) {
+      wal_close(log);
+      errno = EINVAL;
+      return NULL;
+    }
+  }
+
+  return log;
+}
+
+void wal_replay(wal_t *log, ioopm_hash_table_t *ht) {
+  replay_file(log, ht, log->snapshot_path);
+  off_t end = replay_file(log, ht, log->path);
+
+  // Discard a record that was torn by a crash, so that new records are not appended after it
+  struct stat info;
+
+  if (fstat(log->writer.fd, &info) == 0 && info.st_size > end) {
+    ftruncate(log->writer.fd, end);
+  }
+}
+
+/// @brief Counts an operation, committing the group if it is full
+static bool logged(wal_t *log) {
+  log->pending++;
+
+  if (log->sync_every > 0 && log->pending >= log->sync_every) {
+    return wal_commit(log);
+  }
+
+  return !log->writer.failed;
+}
+
+bool wal_log_insert(wal_t *log, elem_t key, elem_t value) {
+  append_key_record(&log->writer, log->string_keys, RECORD_INSERT, key, value);
+  return logged(log);
+}
+
+bool wal_log_remove(wal_t *log, elem_t key) {
+  append_key_record(&log->writer, log->string_keys, RECORD_REMOVE, key, int_elem(0));
+  return logged(log);
+}
+
+bool wal_log_clear(wal_t *log) {
+  writer_append(&log->writer, RECORD_CLEAR, NULL, 0, int_elem(0));
+  return logged(log);
+}
+
+bool wal_commit(wal_t *log) {
+  log->pending = 0;
+
+  if (writer_flush(&log->writer) && fsync(log->writer.fd) != 0) {
+    log->writer.failed = true;
+  }
+
+  return !log->writer.failed;
+}
+
+/// @brief Used in conjuction with any to write every entry to a snapshot
+/// @param x a pointer to a snapshot_t
+static bool write_entry(elem_t key, elem_t value, void *x) {
+  snapshot_t *snapshot = x;
+  append_key_record(&snapshot->writer, snapshot->string_keys, RECORD_INSERT, key, value);
+  return false;
+}
+
+bool wal_checkpoint(wal_t *log, ioopm_hash_table_t *ht) {
+  // The snapshot is written to a temporary file, so that a crash never leaves half a snapshot
+  char *tmp_path = malloc(strlen(log->snapshot_path) + sizeof(".tmp"));
+  sprintf(tmp_path, "%s.tmp", log->snapshot_path);
+
+  int fd = open(tmp_path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+
+  if (fd < 0) {
+    free(tmp_path);
+    return false;
+  }
+
+  snapshot_t snapshot = { .string_keys = log->string_keys };
+  file_header_t header = { .magic = SNAPSHOT_MAGIC, .string_keys = log->string_keys };
+
+  writer_init(&snapshot.writer, fd);
+  memcpy(snapshot.writer.buffer, &header, sizeof(file_header_t));
+  snapshot.writer.used = sizeof(file_header_t);
+
+  ioopm_hash_table_any(ht, write_entry, &snapshot);
+
+  bool success = writer_flush(&snapshot.writer) && fsync(fd) == 0;
+
+  free(snapshot.writer.buffer);
+  close(fd);
+
+  if (!success || rename(tmp_path, log->snapshot_path) != 0) {
+    unlink(tmp_path);
+    free(tmp_path);
+    return false;
+  }
+
+  free(tmp_path);
+  sync_directory(log->snapshot_path);
+
+  // Replaying the log on top of the snapshot gives the same table, so a crash before
+  // the log is truncated only means that the log is replayed once more
+  log->writer.used = 0;
+  log->pending = 0;
+
+  if (ftruncate(log->writer.fd, sizeof(file_header_t)) != 0 || fsync(log->writer.fd) != 0) {
+    log->writer.failed = true;
+  }
+
+  return !log->writer.failed;
+}
+
+void wal_close(wal_t *log) {
+  wal_commit(log);
+  close(log->writer.fd);
+
+  free(log->writer.buffer);
+  free(log->path);
+  free(log->snapshot_path);
+  free(log);
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <stdbool.h>
+
+#include "common.h"
+#include "hash_table.h"
+
+/**
+ * @file wal.h
+ * @author Fredrik Engstrand, Alex Alstergren
+ * @date 19 October 2026
+ * @brief Write-ahead log for hash tables, used by ioopm_hash_table_recover.
+ *
+ * Every insert and remove is appended to a log file. Records are collected in a buffer and
+ * written (and fsynced) together, a group commit, so that durability costs one system call
+ * per batch instead of one per operation. A checkpoint writes all entries to a snapshot file
+ * and truncates the log. Opening the log replays the snapshot followed by the log.
+ */
+
+typedef struct wal wal_t;
+
+/// @brief Open or create a log, and the snapshot next to it (path with ".snapshot" appended)
+/// @param path the log file
+/// @param string_keys true if keys are NULL terminated strings, else the elem_t itself is logged
+/// @param sync_every the amount of operations per group commit (0 to only commit on wal_commit)
+/// @return the log or NULL (with errno set) if the files could not be opened or are not logs
+wal_t *wal_open(const char *path, bool string_keys, size_t sync_every);
+
+/// @brief Rebuild a table from the snapshot and the log
+/// A torn record at the end of the log (from a crash during a write) is discarded.
+/// @param log the log to replay
+/// @param ht the table to insert into, which should not write to the log itself, and which has
+///        to copy string keys (see ioopm_hash_table_create_string_keys)
+void wal_replay(wal_t *log, ioopm_hash_table_t *ht);
+
+/// @brief Log that key was mapped to value
+/// @return false if the log could not be written
+bool wal_log_insert(wal_t *log, elem_t key, elem_t value);
+
+/// @brief Log that key was removed
+/// @return false if the log could not be written
+bool wal_log_remove(wal_t *log, elem_t key);
+
+/// @brief Log that all entries were removed
+/// @return false if the log could not be written
+bool wal_log_clear(wal_t *log);
+
+/// @brief Write and fsync all buffered records
+/// @return false if the log could not be written
+bool wal_commit(wal_t *log);
+
+/// @brief Write every entry of ht to a new snapshot and truncate the log
+/// @return false if the snapshot could not be written, in which case the log is left as is
+bool wal_checkpoint(wal_t *log, ioopm_hash_table_t *ht);
+
+/// @brief Commit and close the log
+void wal_close(wal_t *log);
@@ -0,0 +1,74 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "common.h"
+#include "hash_table.h"
+
+#define DEFAULT_OPERATIONS 200000
+#define BENCH_PATH "wal_bench.db"
+#define BENCH_SNAPSHOT_PATH "wal_bench.db.snapshot"
+
+static double seconds_since(struct timespec *start) {
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (now.tv_sec - start->tv_sec) + (now.tv_nsec - start->tv_nsec) / 1e9;
+}
+
+/// @brief Counts integers the same way freq_count counts words (lookup followed by insert)
+static double count(ioopm_hash_table_t *ht, size_t operations) {
+  struct timespec start;
+  clock_gettime(CLOCK_MONOTONIC, &start);
+
+  for (size_t i = 0; i < operations; i++) {
+    elem_t key = int_elem(i % 50000);
+    elem_t value = ioopm_hash_table_lookup(ht, key);
+    ioopm_hash_table_insert(ht, key, int_elem(HAS_ERROR() ? 1 : value.integer + 1));
+  }
+
+  ioopm_hash_table_sync(ht);
+  return seconds_since(&start);
+}
+
+int main(int argc, char *argv[]) {
+  size_t operations = argc > 1 ? atol(argv[1]) : DEFAULT_OPERATIONS;
+  size_t batches[] = { 1, 10, 100, 1000, 0 };
+
+  ioopm_hash_table_t *memory = ioopm_hash_table_create(eq_elem_int, eq_elem_int, NULL);
+  double time = count(memory, operations);
+  ioopm_hash_table_destroy(memory);
+
+  printf("operations: %zu\n", operations);
+  printf("no log:            %.3fs (%.0f ops/s)\n", time, operations / time);
+
+  for (size_t i = 0; i < sizeof(batches) / sizeof(batches[0]); i++) {
+    unlink(BENCH_PATH);
+    unlink(BENCH_SNAPSHOT_PATH);
+
+    ioopm_hash_table_t *ht = ioopm_hash_table_recover(BENCH_PATH, eq_elem_int, eq_elem_int, NULL, false, batches[i]);
+    time = count(ht, operations);
+
+    // Replaying the log is what a crash costs
+    struct timespec start;
+    ioopm_hash_table_close(ht);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    ht = ioopm_hash_table_recover(BENCH_PATH, eq_elem_int, eq_elem_int, NULL, false, batches[i]);
+    double replay_time = seconds_since(&start);
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    ioopm_hash_table_checkpoint(ht);
+    double checkpoint_time = seconds_since(&start);
+    ioopm_hash_table_close(ht);
+
+    printf("sync every %5zu:  %.3fs (%.0f ops/s), replay %.3fs, checkpoint %.3fs\n",
+      batches[i], time, operations / time, replay_time, checkpoint_time);
+  }
+
+  unlink(BENCH_PATH);
+  unlink(BENCH_SNAPSHOT_PATH);
+
+  return 0;
+}